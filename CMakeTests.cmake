@@ -15,6 +15,7 @@
 # Test code for H3
 
 option(BUILD_ALLOC_TESTS "Build tests for custom allocation functions" ON)
+option(BUILD_CPU_LEVEL_TESTS "Build exhaustive tests for each CPU level of kernels" OFF)
 option(PRINT_TEST_FILES "Print which test files correspond to which tests" OFF)
 
 include(TestWrapValgrind)
@@ -39,14 +40,14 @@ if(ENABLE_COVERAGE)
         )
 endif()
 
-macro(add_h3_memory_test name srcfile)
+macro(add_h3_test_with_library name library srcfile)
     # Like other test code, but these need to be linked against
-    # a different copy of the H3 library which has known intercepted
-    # allocator functions.
-    add_executable(${ARGV} ${APP_SOURCE_FILES} ${TEST_APP_SOURCE_FILES})
+    # a different copy of the H3 library, such as one which has known
+    # intercepted allocator functions.
+    add_executable(${name} ${srcfile} ${APP_SOURCE_FILES} ${TEST_APP_SOURCE_FILES})
 
     if(TARGET ${name})
-        target_link_libraries(${name} PUBLIC h3WithTestAllocators)
+        target_link_libraries(${name} PUBLIC ${library})
         target_include_directories(${name} PUBLIC
         $<BUILD_INTERFACE:${CMAKE_CURRENT_SOURCE_DIR}/src/apps/applib/include>)
         target_compile_options(${name} PRIVATE ${H3_COMPILE_FLAGS})
@@ -176,9 +177,19 @@ add_h3_test(testCellToParent src/apps/testapps/testCellToParent.c)
 add_h3_test(testCellToCenterChild src/apps/testapps/testCellToCenterChild.c)
 add_h3_test(testCellToChildren src/apps/testapps/testCellToChildren.c)
 add_h3_test(testCellToChildPos src/apps/testapps/testCellToChildPos.c)
+add_h3_test(testCellToRank src/apps/testapps/testCellToRank.c)
+add_h3_test(testCellToChildrenRange src/apps/testapps/testCellToChildrenRange.c)
+add_h3_test(testCellCoverage src/apps/testapps/testCellCoverage.c)
+add_h3_test(testCompactCellSetOperation src/apps/testapps/testCompactCellSetOperation.c)
+add_h3_test(testCellSetEncoding src/apps/testapps/testCellSetEncoding.c)
+add_h3_test(testSortCells src/apps/testapps/testSortCells.c)
+add_h3_test(testCurveKey src/apps/testapps/testCurveKey.c)
 add_h3_test(testGetIcosahedronFaces src/apps/testapps/testGetIcosahedronFaces.c)
 add_h3_test(testCellToChildrenSize src/apps/testapps/testCellToChildrenSize.c)
 add_h3_test(testH3Index src/apps/testapps/testH3Index.c)
+add_h3_test(testH3Inline src/apps/testapps/testH3Inline.c)
+add_h3_test(testResolutionKernels src/apps/testapps/testResolutionKernels.c)
+add_h3_test(testCellGeometryTable src/apps/testapps/testCellGeometryTable.c)
 add_h3_test(testH3Api src/apps/testapps/testH3Api.c)
 add_h3_test(testCellsToLinkedMultiPolygon src/apps/testapps/testCellsToLinkedMultiPolygon.c)
 add_h3_test(testH3SetToVertexGraph src/apps/testapps/testH3SetToVertexGraph.c)
@@ -210,20 +221,46 @@ add_h3_test_with_arg(testH3NeighborRotations src/apps/testapps/testH3NeighborRot
 
 # The "Exhaustive" part of the test name is used by the test-fast to exclude these files.
 # test-fast exists so that Travis CI can run Valgrind on tests without taking a very long time.
-add_h3_test(testDirectedEdgeExhaustive src/apps/testapps/testDirectedEdgeExhaustive.c)
-add_h3_test(testVertexExhaustive src/apps/testapps/testVertexExhaustive.c)
-add_h3_test(testCellToLocalIjExhaustive src/apps/testapps/testCellToLocalIjExhaustive.c)
-add_h3_test(testGridPathCellsExhaustive src/apps/testapps/testGridPathCellsExhaustive.c)
-add_h3_test(testGridDistanceExhaustive src/apps/testapps/testGridDistanceExhaustive.c)
-add_h3_test(testH3CellAreaExhaustive src/apps/testapps/testH3CellAreaExhaustive.c)
+set(EXHAUSTIVE_TESTS
+    testDirectedEdgeExhaustive
+    testVertexExhaustive
+    testCellToLocalIjExhaustive
+    testGridPathCellsExhaustive
+    testGridDistanceExhaustive
+    testH3CellAreaExhaustive
+    testIsValidCellsExhaustive)
+foreach(name ${EXHAUSTIVE_TESTS})
+    add_h3_test(${name} src/apps/testapps/${name}.c)
+endforeach()
+
+# The exhaustive tests of functions with dispatched kernels again, against
+# copies of the library with kernels pinned to each CPU level. Levels the
+# CPU does not support run the best level below them.
+set(CPU_LEVEL_TESTS
+    testIsValidCellsExhaustive)
+if(BUILD_CPU_LEVEL_TESTS)
+    foreach(level ${H3_CPU_LEVELS})
+        string(TOUPPER ${level} upper_level)
+        add_h3_library(h3CpuLevel_${level} "" H3_CPU_LEVEL=CPU_LEVEL_${upper_level})
+        foreach(name ${CPU_LEVEL_TESTS})
+            add_h3_test_with_library(${name}CpuLevel_${level} h3CpuLevel_${level} src/apps/testapps/${name}.c)
+        endforeach()
+    endforeach()
+    add_custom_target(test-cpu-levels COMMAND ctest -R CpuLevel)
+endif()
 
 add_h3_cli_test(testCliCellToLatLng "cellToLatLng -c 8928342e20fffff" "37.5012466151, -122.5003039349")
 add_h3_cli_test(testCliLatLngToCell "latLngToCell --lat 20 --lng 123 -r 2" "824b9ffffffffff")
 
+add_h3_library(h3WithHotPathCounters "" H3_HOT_PATH_COUNTERS)
+add_h3_test_with_library(testHotPathCounters h3WithHotPathCounters src/apps/testapps/testHotPathCounters.c)
+
 if(BUILD_ALLOC_TESTS)
     add_h3_library(h3WithTestAllocators test_prefix_)
+    add_h3_library(h3WithTestAllocationStats test_prefix_ H3_ALLOCATION_STATS)
 
-    add_h3_memory_test(testH3Memory src/apps/testapps/testH3Memory.c)
+    add_h3_test_with_library(testH3Memory h3WithTestAllocators src/apps/testapps/testH3Memory.c)
+    add_h3_test_with_library(testAllocationStats h3WithTestAllocationStats src/apps/testapps/testAllocationStats.c)
 endif()
 
 add_custom_target(test-fast COMMAND ctest -E Exhaustive)
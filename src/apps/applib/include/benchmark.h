@@ -15,14 +15,24 @@
  */
 /** @file benchmark.h
  * @brief Benchmark harness functions and macros.
+ *
+ * Each benchmark is run for some warmup samples and then for a number of
+ * recorded samples, which are summarized as min, median, p90, p99, mean,
+ * and standard deviation of the time per iteration. See benchmark.c for
+ * the command line options every benchmark accepts. On Linux, hardware
+ * performance counters may also be recorded for each benchmark, and the
+ * allocations of the library are reported when it counts them.
  */
 
 #ifndef BENCHMARK_H
 #define BENCHMARK_H
 
 #include <math.h>
+#include <stdbool.h>
 #include <stdio.h>
 
+#include "h3api.h"
+
 #define MICROSECONDS_PER_SECOND 1E6
 #define NANOSECONDS_PER_SECOND 1E9
 #define NANOSECONDS_PER_MICROSECOND 1E3
@@ -67,19 +77,110 @@
 
 #endif
 
-#define BEGIN_BENCHMARKS() int main(int argc, char *argv[]) {
-#define BENCHMARK(NAME, ITERATIONS, BODY)                                   \
-    do {                                                                    \
-        const int iterations = ITERATIONS;                                  \
-        const char *name = #NAME;                                           \
-        START_TIMER;                                                        \
-        for (int i = 0; i < iterations; i++) {                              \
-            BODY;                                                           \
-        }                                                                   \
-        END_TIMER(duration);                                                \
-        printf("\t-- %s: %Lf microseconds per iteration (%d iterations)\n", \
-               name, (duration / iterations), iterations);                  \
+/** Format of benchmark results */
+typedef enum {
+    /** Human readable text */
+    BENCHMARK_FORMAT_TEXT,
+    /** A header row and one row per benchmark */
+    BENCHMARK_FORMAT_CSV,
+    /** One JSON object per line, per benchmark */
+    BENCHMARK_FORMAT_JSON
+} BenchmarkFormat;
+
+/**
+ * Number of hardware performance counters: cycles, instructions, branch
+ * misses, L1 data cache read misses, and last level cache misses
+ */
+#define BENCHMARK_NUM_COUNTERS 5
+
+/** State of one benchmark while it is run */
+typedef struct {
+    /** Name of the benchmark */
+    const char *name;
+    /** Number of iterations timed in each sample */
+    int iterationsPerSample;
+    /** Number of samples taken, including warmup samples */
+    int sampleCount;
+    /** Number of warmup samples, which are not recorded */
+    int warmupSamples;
+    /** Number of recorded samples */
+    int numSamples;
+    /** Microseconds per iteration of each recorded sample */
+    double *samples;
+    /**
+     * Totals of the hardware performance counters over the recorded
+     * samples, or negative if a counter is not available
+     */
+    double counters[BENCHMARK_NUM_COUNTERS];
+    /** Whether the library counts its allocations */
+    bool countsAllocations;
+    /** liveBytes of the library when the recorded samples started */
+    int64_t startLiveBytes;
+    /** Counts of the library's allocations over the recorded samples */
+    AllocationStats allocations;
+} BenchmarkRun;
+
+/** Statistics of the time per iteration of a benchmark, in microseconds */
+typedef struct {
+    double min;
+    double median;
+    double p90;
+    double p99;
+    double mean;
+    double stddev;
+} BenchmarkStats;
+
+void benchmarkInit(int argc, char *argv[]);
+int benchmarkFinish(void);
+void benchmarkFail(const char *format, ...);
+const BenchmarkStats *benchmarkLastStats(void);
+void benchmarkStart(BenchmarkRun *run, const char *name, int iterations);
+bool benchmarkNextSample(BenchmarkRun *run);
+void benchmarkRecordSample(BenchmarkRun *run, long double microseconds);
+void benchmarkEnd(BenchmarkRun *run);
+void benchmarkNote(const char *format, ...);
+
+extern const volatile void *benchmarkSink;
+
+/**
+ * Keeps the compiler from optimizing away the computation of value, which
+ * must be an lvalue, as if it were read by code the compiler cannot see.
+ */
+#if defined(__GNUC__) || defined(__clang__)
+#define DO_NOT_OPTIMIZE(value) __asm__ volatile("" : : "g"(&(value)) : "memory")
+#else
+#define DO_NOT_OPTIMIZE(value) (benchmarkSink = &(value))
+#endif
+
+#define BEGIN_BENCHMARKS()           \
+    int main(int argc, char *argv[]) { \
+        benchmarkInit(argc, argv);
+/**
+ * Times ITERATIONS iterations of BODY, split into samples after some
+ * warmup samples, and reports statistics of the time per iteration.
+ */
+#define BENCHMARK(NAME, ITERATIONS, BODY) \
+    BENCHMARK_NAMED(#NAME, ITERATIONS, BODY)
+/**
+ * As BENCHMARK, with a name given as a string, which may be built at run
+ * time.
+ */
+#define BENCHMARK_NAMED(NAME_STRING, ITERATIONS, BODY)          \
+    do {                                                        \
+        BenchmarkRun run;                                       \
+        benchmarkStart(&run, NAME_STRING, ITERATIONS);          \
+        while (benchmarkNextSample(&run)) {                     \
+            START_TIMER;                                        \
+            for (int i = 0; i < run.iterationsPerSample; i++) { \
+                BODY;                                           \
+            }                                                   \
+            END_TIMER(duration);                                \
+            benchmarkRecordSample(&run, duration);              \
+        }                                                       \
+        benchmarkEnd(&run);                                     \
     } while (0)
-#define END_BENCHMARKS() }
+#define END_BENCHMARKS()      \
+    return benchmarkFinish(); \
+    }
 
 #endif
@@ -0,0 +1,551 @@
+/*
+ * Copyright 2023 Uber Technologies, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/** @file benchmark.c
+ * @brief Benchmark harness functions
+ *
+ * Every benchmark accepts these options:
+ *
+ *     --warmup N     Number of warmup samples, not recorded (default 1)
+ *     --samples N    Number of recorded samples (default 10)
+ *     --format F     text, csv, or json (default text)
+ *     --output FILE  Append results to FILE instead of standard output
+ *     --counters     Record hardware performance counters (Linux only)
+ *
+ * The iterations given to BENCHMARK are split evenly across the recorded
+ * samples, so more samples do not make a benchmark take longer, apart from
+ * the warmup.
+ *
+ * CSV and JSON results can be appended to one file from several benchmark
+ * programs: CSV has a header row only at the start of the file, and JSON
+ * has one object per line. Each result is identified by the suite, the name
+ * of the benchmark program, and the name of the benchmark.
+ *
+ * With --counters, cycles, instructions, branch misses, L1 data cache read
+ * misses, and last level cache misses of the recorded samples are counted
+ * with perf_event_open, counting only user space, and reported per
+ * iteration. Counters that cannot be opened, for example in containers
+ * without access to them or on CPUs without them, are reported as missing
+ * and do not stop the benchmarks.
+ *
+ * When the library is built to count its allocations (see
+ * getAllocationStats), the allocations and allocated bytes of the recorded
+ * samples are reported per iteration, along with the peak memory of the
+ * library during them.
+ */
+
+#include "benchmark.h"
+
+#include <stdarg.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "args.h"
+#include "utility.h"
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <stdint.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+/** Header row of CSV results */
+#define CSV_HEADER                                                         \
+    "suite,name,iterations,samples,min_us,median_us,p90_us,p99_us,mean_us," \
+    "stddev_us,cycles,instructions,ipc,branch_misses,l1d_misses,llc_misses," \
+    "allocations,allocated_bytes,peak_bytes"
+
+/** Names of the hardware performance counters, as in CSV and JSON */
+static const char *const COUNTER_NAMES[BENCHMARK_NUM_COUNTERS] = {
+    "cycles", "instructions", "branch_misses", "l1d_misses", "llc_misses"};
+
+/** Index of the cycles counter */
+#define COUNTER_CYCLES 0
+/** Index of the instructions counter */
+#define COUNTER_INSTRUCTIONS 1
+
+const volatile void *benchmarkSink;
+
+static const char *suiteName = "";
+static int warmupSamples = 1;
+static int recordedSamples = 10;
+static BenchmarkFormat format = BENCHMARK_FORMAT_TEXT;
+static FILE *output = NULL;
+static bool failed = false;
+static BenchmarkStats lastStats;
+
+/** File descriptors of the open counters, or -1 */
+static int counterFds[BENCHMARK_NUM_COUNTERS] = {-1, -1, -1, -1, -1};
+
+#ifdef __linux__
+
+/** perf_event_open type and config of each counter */
+static const struct {
+    uint32_t type;
+    uint64_t config;
+} COUNTER_EVENTS[BENCHMARK_NUM_COUNTERS] = {
+    {PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES},
+    {PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS},
+    {PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES},
+    {PERF_TYPE_HW_CACHE, PERF_COUNT_HW_CACHE_L1D |
+                             (PERF_COUNT_HW_CACHE_OP_READ << 8) |
+                             (PERF_COUNT_HW_CACHE_RESULT_MISS << 16)},
+    {PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES}};
+
+/**
+ * Opens each counter, disabled, for this process in user space. Counters
+ * that fail to open are left closed.
+ */
+static void openCounters(void) {
+    for (int c = 0; c < BENCHMARK_NUM_COUNTERS; c++) {
+        struct perf_event_attr attr;
+        memset(&attr, 0, sizeof(attr));
+        attr.size = sizeof(attr);
+        attr.type = COUNTER_EVENTS[c].type;
+        attr.config = COUNTER_EVENTS[c].config;
+        attr.disabled = 1;
+        attr.exclude_kernel = 1;
+        attr.exclude_hv = 1;
+        // Counters may be multiplexed when there are more of them than
+        // the CPU has, in which case they are scaled by these times
+        attr.read_format =
+            PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+        counterFds[c] = (int)syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0);
+        if (counterFds[c] < 0) {
+            fprintf(stderr, "%s: counter %s is not available\n", suiteName,
+                    COUNTER_NAMES[c]);
+        }
+    }
+}
+
+static void controlCounters(unsigned long request) {
+    for (int c = 0; c < BENCHMARK_NUM_COUNTERS; c++) {
+        if (counterFds[c] >= 0) {
+            ioctl(counterFds[c], request, 0);
+        }
+    }
+}
+
+/**
+ * Reads the counters, scaled for any time they were not running.
+ */
+static void readCounters(double *counters) {
+    for (int c = 0; c < BENCHMARK_NUM_COUNTERS; c++) {
+        uint64_t values[3];
+        counters[c] = -1;
+        if (counterFds[c] >= 0 &&
+            read(counterFds[c], values, sizeof(values)) == sizeof(values) &&
+            values[2] > 0) {
+            counters[c] = (double)values[0] * values[1] / values[2];
+        }
+    }
+}
+
+static void closeCounters(void) {
+    for (int c = 0; c < BENCHMARK_NUM_COUNTERS; c++) {
+        if (counterFds[c] >= 0) {
+            close(counterFds[c]);
+        }
+        counterFds[c] = -1;
+    }
+}
+
+#define RESET_COUNTERS() controlCounters(PERF_EVENT_IOC_RESET)
+#define ENABLE_COUNTERS() controlCounters(PERF_EVENT_IOC_ENABLE)
+#define DISABLE_COUNTERS() controlCounters(PERF_EVENT_IOC_DISABLE)
+
+#else  // !defined(__linux__)
+
+static void openCounters(void) {
+    fprintf(stderr, "%s: counters are only available on Linux\n", suiteName);
+}
+
+static void readCounters(double *counters) {
+    for (int c = 0; c < BENCHMARK_NUM_COUNTERS; c++) {
+        counters[c] = -1;
+    }
+}
+
+static void closeCounters(void) {}
+
+#define RESET_COUNTERS()
+#define ENABLE_COUNTERS()
+#define DISABLE_COUNTERS()
+
+#endif
+
+/**
+ * Parses the benchmark options. Exits on invalid options.
+ */
+void benchmarkInit(int argc, char *argv[]) {
+    char formatName[BUFF_SIZE] = "text";
+    char outputPath[BUFF_SIZE] = {0};
+
+    Arg helpArg = ARG_HELP;
+    Arg warmupArg = {.names = {"-w", "--warmup"},
+                     .scanFormat = "%d",
+                     .valueName = "n",
+                     .value = &warmupSamples,
+                     .helpText = "Number of warmup samples, default 1."};
+    Arg samplesArg = {.names = {"-s", "--samples"},
+                      .scanFormat = "%d",
+                      .valueName = "n",
+                      .value = &recordedSamples,
+                      .helpText = "Number of recorded samples, default 10."};
+    Arg formatArg = {
+        .names = {"-f", "--format"},
+        .scanFormat = "%255s",
+        .valueName = "format",
+        .value = &formatName,
+        .helpText = "Format of results: text (default), csv, or json."};
+    Arg outputArg = {
+        .names = {"-o", "--output"},
+        .scanFormat = "%255s",
+        .valueName = "file",
+        .value = &outputPath,
+        .helpText = "Append results to this file instead of standard output."};
+    Arg countersArg = {
+        .names = {"-c", "--counters"},
+        .helpText = "Record hardware performance counters, on Linux."};
+
+    Arg *args[] = {&helpArg,   &warmupArg, &samplesArg,
+                   &formatArg, &outputArg, &countersArg};
+    const char *helpText =
+        "Runs benchmarks and reports the time per iteration.";
+    if (parseArgs(argc, argv, 6, args, &helpArg, helpText)) {
+        exit(helpArg.found ? 0 : 1);
+    }
+
+    if (warmupSamples < 0 || recordedSamples < 1) {
+        printHelp(stderr, argv[0], helpText, 6, args,
+                  "Samples must be at least 1, and warmup at least 0.", NULL);
+        exit(1);
+    }
+    if (strcmp(formatName, "text") == 0) {
+        format = BENCHMARK_FORMAT_TEXT;
+    } else if (strcmp(formatName, "csv") == 0) {
+        format = BENCHMARK_FORMAT_CSV;
+    } else if (strcmp(formatName, "json") == 0) {
+        format = BENCHMARK_FORMAT_JSON;
+    } else {
+        printHelp(stderr, argv[0], helpText, 6, args, "Unknown format",
+                  formatName);
+        exit(1);
+    }
+
+    output = stdout;
+    if (outputArg.found) {
+        output = fopen(outputPath, "a");
+        if (!output) error("opening output file");
+    }
+
+    const char *slash = strrchr(argv[0], '/');
+    suiteName = slash ? slash + 1 : argv[0];
+
+    if (countersArg.found) {
+        openCounters();
+    }
+
+    if (format == BENCHMARK_FORMAT_TEXT) {
+        fprintf(output, "%s: %d warmup and %d recorded samples\n", suiteName,
+                warmupSamples, recordedSamples);
+    } else if (format == BENCHMARK_FORMAT_CSV && ftell(output) <= 0) {
+        // Only a new or empty file needs a header. Standard output may not
+        // be seekable, in which case ftell fails and a header is written.
+        fprintf(output, "%s\n", CSV_HEADER);
+    }
+}
+
+/**
+ * Closes the output after all benchmarks have run.
+ *
+ * @return Exit status of the benchmark program, 1 if benchmarkFail was
+ * called and 0 otherwise
+ */
+int benchmarkFinish(void) {
+    closeCounters();
+    if (output && output != stdout) {
+        fclose(output);
+    }
+    output = NULL;
+    return failed ? 1 : 0;
+}
+
+/**
+ * Reports a failure, for example a benchmark that exceeded its budget, on
+ * standard error. The benchmarks continue, and the program exits with
+ * status 1 when they are done.
+ */
+void benchmarkFail(const char *failFormat, ...) {
+    va_list args;
+    va_start(args, failFormat);
+    fprintf(stderr, "%s: FAILED: ", suiteName);
+    vfprintf(stderr, failFormat, args);
+    fprintf(stderr, "\n");
+    va_end(args);
+    failed = true;
+}
+
+/**
+ * Statistics of the benchmark that ran last.
+ */
+const BenchmarkStats *benchmarkLastStats(void) { return &lastStats; }
+
+/**
+ * Prints information about a benchmark fixture. Goes to standard output
+ * for text results and to standard error otherwise, so that machine
+ * readable results on standard output are not interrupted.
+ */
+void benchmarkNote(const char *noteFormat, ...) {
+    va_list args;
+    va_start(args, noteFormat);
+    vfprintf(format == BENCHMARK_FORMAT_TEXT ? stdout : stderr, noteFormat,
+             args);
+    va_end(args);
+}
+
+void benchmarkStart(BenchmarkRun *run, const char *name, int iterations) {
+    run->name = name;
+    run->iterationsPerSample =
+        iterations > recordedSamples
+            ? (iterations + recordedSamples - 1) / recordedSamples
+            : 1;
+    run->sampleCount = 0;
+    run->warmupSamples = warmupSamples;
+    run->numSamples = 0;
+    run->samples = calloc(recordedSamples, sizeof(double));
+    if (!run->samples) error("allocating samples");
+    run->countsAllocations = false;
+    RESET_COUNTERS();
+}
+
+/**
+ * Returns true if another sample should be taken.
+ */
+bool benchmarkNextSample(BenchmarkRun *run) {
+    if (run->sampleCount >= run->warmupSamples + recordedSamples) {
+        return false;
+    }
+    if (run->sampleCount == run->warmupSamples) {
+        AllocationStats stats = {0};
+        run->countsAllocations =
+            H3_EXPORT(resetAllocationStats)() == E_SUCCESS &&
+            H3_EXPORT(getAllocationStats)(&stats) == E_SUCCESS;
+        run->startLiveBytes = stats.liveBytes;
+    }
+    if (run->sampleCount >= run->warmupSamples) {
+        ENABLE_COUNTERS();
+    }
+    return true;
+}
+
+void benchmarkRecordSample(BenchmarkRun *run, long double microseconds) {
+    if (run->sampleCount >= run->warmupSamples) {
+        DISABLE_COUNTERS();
+        run->samples[run->numSamples++] =
+            (double)(microseconds / run->iterationsPerSample);
+    }
+    run->sampleCount++;
+}
+
+static int compareDoubles(const void *a, const void *b) {
+    double x = *(const double *)a;
+    double y = *(const double *)b;
+    return x < y ? -1 : x > y;
+}
+
+/**
+ * Nearest rank percentile of sorted samples.
+ */
+static double percentile(const double *sorted, int n, int p) {
+    int rank = (p * n + 99) / 100;
+    return sorted[rank > 0 ? rank - 1 : 0];
+}
+
+/**
+ * Formats a counter per iteration, or an empty string if it is missing.
+ */
+static const char *formatCounter(double value, long long iterations,
+                                 char *buffer, size_t size) {
+    if (value < 0) {
+        buffer[0] = '\0';
+    } else {
+        snprintf(buffer, size, "%.3f", value / iterations);
+    }
+    return buffer;
+}
+
+/**
+ * Reports counters per iteration, after the statistics of the samples.
+ */
+static void reportCounters(const double *counters, long long iterations) {
+    char buffers[BENCHMARK_NUM_COUNTERS + 1][32];
+    const char *values[BENCHMARK_NUM_COUNTERS + 1];
+    for (int c = 0; c < BENCHMARK_NUM_COUNTERS; c++) {
+        values[c] = formatCounter(counters[c], iterations, buffers[c],
+                                  sizeof(buffers[c]));
+    }
+    // Instructions per cycle, after the counters
+    const double cycles = counters[COUNTER_CYCLES];
+    const double instructions = counters[COUNTER_INSTRUCTIONS];
+    double ipc = cycles > 0 && instructions >= 0 ? instructions / cycles : -1;
+    values[BENCHMARK_NUM_COUNTERS] = formatCounter(
+        ipc, 1, buffers[BENCHMARK_NUM_COUNTERS], sizeof(buffers[0]));
+
+    switch (format) {
+        case BENCHMARK_FORMAT_TEXT:
+            fprintf(output, "\t   per iteration:");
+            for (int c = 0; c < BENCHMARK_NUM_COUNTERS; c++) {
+                fprintf(output, "%s %s %s", c ? "," : "",
+                        counters[c] < 0 ? "-" : values[c], COUNTER_NAMES[c]);
+            }
+            if (ipc >= 0) {
+                fprintf(output, ", IPC %s", values[BENCHMARK_NUM_COUNTERS]);
+            }
+            fprintf(output, "\n");
+            break;
+        case BENCHMARK_FORMAT_CSV:
+            // Same order as the header
+            fprintf(output, ",%s,%s,%s,%s,%s,%s", values[0], values[1],
+                    values[BENCHMARK_NUM_COUNTERS], values[2], values[3],
+                    values[4]);
+            break;
+        case BENCHMARK_FORMAT_JSON:
+            for (int c = 0; c < BENCHMARK_NUM_COUNTERS; c++) {
+                fprintf(output, ",\"%s\":%s", COUNTER_NAMES[c],
+                        counters[c] < 0 ? "null" : values[c]);
+            }
+            fprintf(output, ",\"ipc\":%s",
+                    ipc < 0 ? "null" : values[BENCHMARK_NUM_COUNTERS]);
+            break;
+    }
+}
+
+/**
+ * Reports the library's allocations per iteration and its peak memory,
+ * after the counters.
+ */
+static void reportAllocations(const BenchmarkRun *run, long long iterations) {
+    const AllocationStats *stats = &run->allocations;
+    double allocations = (double)stats->allocations / iterations;
+    double allocatedBytes = (double)stats->allocatedBytes / iterations;
+    long long peakBytes = (long long)(stats->peakBytes - run->startLiveBytes);
+
+    switch (format) {
+        case BENCHMARK_FORMAT_TEXT:
+            if (run->countsAllocations) {
+                fprintf(output,
+                        "\t   per iteration: %.3f allocations, %.3f bytes; "
+                        "peak %lld bytes\n",
+                        allocations, allocatedBytes, peakBytes);
+            }
+            break;
+        case BENCHMARK_FORMAT_CSV:
+            if (run->countsAllocations) {
+                fprintf(output, ",%.3f,%.3f,%lld\n", allocations,
+                        allocatedBytes, peakBytes);
+            } else {
+                fprintf(output, ",,,\n");
+            }
+            break;
+        case BENCHMARK_FORMAT_JSON:
+            if (run->countsAllocations) {
+                fprintf(output,
+                        ",\"allocations\":%.3f,\"allocated_bytes\":%.3f,"
+                        "\"peak_bytes\":%lld}\n",
+                        allocations, allocatedBytes, peakBytes);
+            } else {
+                fprintf(output,
+                        ",\"allocations\":null,\"allocated_bytes\":null,"
+                        "\"peak_bytes\":null}\n");
+            }
+            break;
+    }
+}
+
+/**
+ * Summarizes the samples of a benchmark and reports them.
+ */
+void benchmarkEnd(BenchmarkRun *run) {
+    int n = run->numSamples;
+    double *sorted = run->samples;
+    qsort(sorted, n, sizeof(double), compareDoubles);
+
+    double sum = 0;
+    for (int i = 0; i < n; i++) {
+        sum += sorted[i];
+    }
+    double mean = sum / n;
+    double squares = 0;
+    for (int i = 0; i < n; i++) {
+        squares += (sorted[i] - mean) * (sorted[i] - mean);
+    }
+    double stddev = n > 1 ? sqrt(squares / (n - 1)) : 0;
+    double median = n % 2 ? sorted[n / 2]
+                          : (sorted[n / 2 - 1] + sorted[n / 2]) / 2;
+    double p90 = percentile(sorted, n, 90);
+    double p99 = percentile(sorted, n, 99);
+    long long iterations = (long long)run->iterationsPerSample * n;
+    bool countersOpen = false;
+    for (int c = 0; c < BENCHMARK_NUM_COUNTERS; c++) {
+        countersOpen |= counterFds[c] >= 0;
+    }
+    readCounters(run->counters);
+    if (run->countsAllocations) {
+        H3_EXPORT(getAllocationStats)(&run->allocations);
+    }
+    lastStats = (BenchmarkStats){.min = sorted[0],
+                                 .median = median,
+                                 .p90 = p90,
+                                 .p99 = p99,
+                                 .mean = mean,
+                                 .stddev = stddev};
+
+    switch (format) {
+        case BENCHMARK_FORMAT_TEXT:
+            fprintf(output,
+                    "\t-- %s: %f microseconds per iteration (%lld "
+                    "iterations)\n"
+                    "\t   median %f, p90 %f, p99 %f, min %f, stddev %f, "
+                    "%.0f iterations per second\n",
+                    run->name, mean, iterations, median, p90, p99, sorted[0],
+                    stddev, mean > 0 ? MICROSECONDS_PER_SECOND / mean : 0);
+            break;
+        case BENCHMARK_FORMAT_CSV:
+            fprintf(output, "%s,%s,%lld,%d,%f,%f,%f,%f,%f,%f", suiteName,
+                    run->name, iterations, n, sorted[0], median, p90, p99,
+                    mean, stddev);
+            break;
+        case BENCHMARK_FORMAT_JSON:
+            fprintf(output,
+                    "{\"suite\":\"%s\",\"name\":\"%s\",\"iterations\":%lld,"
+                    "\"samples\":%d,\"min_us\":%f,\"median_us\":%f,"
+                    "\"p90_us\":%f,\"p99_us\":%f,\"mean_us\":%f,"
+                    "\"stddev_us\":%f",
+                    suiteName, run->name, iterations, n, sorted[0], median,
+                    p90, p99, mean, stddev);
+            break;
+    }
+    if (format != BENCHMARK_FORMAT_TEXT || countersOpen) {
+        reportCounters(run->counters, iterations);
+    }
+    reportAllocations(run, iterations);
+    fflush(output);
+
+    free(run->samples);
+    run->samples = NULL;
+}
@@ -39,12 +39,20 @@ void error(const char *msg) {
 /**
  * Prints the H3Index
  */
-void h3Print(H3Index h) { printf("%" PRIx64, h); }
+void h3Print(H3Index h) {
+    char str[17];
+    H3_EXPORT(h3ToString)(h, str, sizeof(str));
+    fputs(str, stdout);
+}
 
 /**
  * Prints the H3Index and a newline
  */
-void h3Println(H3Index h) { printf("%" PRIx64 "\n", h); }
+void h3Println(H3Index h) {
+    char str[17];
+    H3_EXPORT(h3ToString)(h, str, sizeof(str));
+    puts(str);
+}
 
 /**
  * Prints the CoordIJK
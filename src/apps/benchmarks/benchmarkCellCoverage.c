@@ -0,0 +1,154 @@
+/*
+ * Copyright 2023 Uber Technologies, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <stdlib.h>
+
+#include "benchmark.h"
+#include "h3api.h"
+
+// Fixtures
+LatLng sfVerts[] = {
+    {0.659966917655, -2.1364398519396},  {0.6595011102219, -2.1359434279405},
+    {0.6583348114025, -2.1354884206045}, {0.6581220034068, -2.1382437718946},
+    {0.6594479998527, -2.1384597563896}, {0.6599990002976, -2.1376771158464}};
+GeoLoop sfGeoLoop = {.numVerts = 6, .verts = sfVerts};
+GeoPolygon sfGeoPolygon;
+
+#define GRID_SIZE 64
+#define NUM_QUERIES (GRID_SIZE * GRID_SIZE)
+
+/** Open addressing hash set of cells, for comparison */
+typedef struct {
+    H3Index *slots;
+    uint64_t mask;
+} CellHashSet;
+
+static uint64_t hashCell(H3Index h) {
+    h ^= h >> 29;
+    h *= 0xbf58476d1ce4e5b9ULL;
+    h ^= h >> 32;
+    return h;
+}
+
+static void hashSetInsert(CellHashSet *set, H3Index h) {
+    uint64_t i = hashCell(h) & set->mask;
+    while (set->slots[i] && set->slots[i] != h) {
+        i = (i + 1) & set->mask;
+    }
+    set->slots[i] = h;
+}
+
+static int hashSetContains(const CellHashSet *set, H3Index h) {
+    uint64_t i = hashCell(h) & set->mask;
+    while (set->slots[i]) {
+        if (set->slots[i] == h) {
+            return 1;
+        }
+        i = (i + 1) & set->mask;
+    }
+    return 0;
+}
+
+static void hashSetContainsCells(const CellHashSet *set, const H3Index *cells,
+                                 int64_t numCells, int *out) {
+    for (int64_t i = 0; i < numCells; i++) {
+        out[i] = hashSetContains(set, cells[i]);
+    }
+}
+
+/**
+ * Builds a coverage and a hash set of the cells of the polygon at res, and
+ * query cells on a grid over the polygon's bounding box, so that some
+ * points are outside of it.
+ */
+static void buildFixtures(int res, CellCoverage *coverage,
+                          CellHashSet *hashSet, H3Index *queries) {
+    int64_t numCells;
+    H3_EXPORT(maxPolygonToCellsSize)(&sfGeoPolygon, res, 0, &numCells);
+    H3Index *cells = calloc(numCells, sizeof(H3Index));
+    H3_EXPORT(polygonToCells)(&sfGeoPolygon, res, 0, cells);
+    int64_t numFound = 0;
+    for (int64_t i = 0; i < numCells; i++) {
+        if (cells[i]) {
+            cells[numFound++] = cells[i];
+        }
+    }
+    H3Index *compacted = calloc(numFound, sizeof(H3Index));
+    H3_EXPORT(compactCells)(cells, compacted, numFound);
+    H3_EXPORT(createCellCoverage)(compacted, numFound, coverage);
+
+    hashSet->mask = 1;
+    while (hashSet->mask < (uint64_t)numFound * 2) {
+        hashSet->mask <<= 1;
+    }
+    hashSet->slots = calloc(hashSet->mask, sizeof(H3Index));
+    hashSet->mask--;
+    for (int64_t i = 0; i < numFound; i++) {
+        hashSetInsert(hashSet, cells[i]);
+    }
+
+    for (int i = 0; i < GRID_SIZE; i++) {
+        for (int j = 0; j < GRID_SIZE; j++) {
+            LatLng point = {.lat = 0.6581 + 0.0019 * i / GRID_SIZE,
+                            .lng = -2.1385 + 0.0031 * j / GRID_SIZE};
+            H3_EXPORT(latLngToCell)(&point, res, &queries[i * GRID_SIZE + j]);
+        }
+    }
+
+    benchmarkNote("\t-- res %d: %lld cells, %lld ranges\n", res,
+                  (long long)numFound, (long long)coverage->numRanges);
+    free(compacted);
+    free(cells);
+}
+
+BEGIN_BENCHMARKS();
+
+sfGeoPolygon.geoloop = sfGeoLoop;
+sfGeoPolygon.numHoles = 0;
+
+CellCoverage coverage;
+CellHashSet hashSet;
+H3Index queries[NUM_QUERIES];
+int results[NUM_QUERIES];
+
+buildFixtures(11, &coverage, &hashSet, queries);
+
+BENCHMARK(coverageContainsCellsRes11, 1000, {
+    H3_EXPORT(coverageContainsCells)(&coverage, queries, NUM_QUERIES, results);
+    DO_NOT_OPTIMIZE(results);
+});
+BENCHMARK(hashSetContainsCellsRes11, 1000, {
+    hashSetContainsCells(&hashSet, queries, NUM_QUERIES, results);
+    DO_NOT_OPTIMIZE(results);
+});
+
+H3_EXPORT(destroyCellCoverage)(&coverage);
+free(hashSet.slots);
+
+buildFixtures(13, &coverage, &hashSet, queries);
+
+BENCHMARK(coverageContainsCellsRes13, 1000, {
+    H3_EXPORT(coverageContainsCells)(&coverage, queries, NUM_QUERIES, results);
+    DO_NOT_OPTIMIZE(results);
+});
+BENCHMARK(hashSetContainsCellsRes13, 1000, {
+    hashSetContainsCells(&hashSet, queries, NUM_QUERIES, results);
+    DO_NOT_OPTIMIZE(results);
+});
+
+H3_EXPORT(destroyCellCoverage)(&coverage);
+free(hashSet.slots);
+
+END_BENCHMARKS();
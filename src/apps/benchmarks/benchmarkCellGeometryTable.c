@@ -0,0 +1,84 @@
+/*
+ * Copyright 2023 Uber Technologies, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <inttypes.h>
+#include <stdio.h>
+
+#include "benchmark.h"
+#include "h3api.h"
+
+// Fixtures: a res 3 hexagon, with a boundary across an icosahedron edge,
+// and a res 4 hexagon
+H3Index res3 = 0x830800fffffffff;
+H3Index res4 = 0x8428309ffffffff;
+
+BEGIN_BENCHMARKS();
+
+LatLng center;
+CellBoundary boundary;
+CellGeometryTable table;
+
+// Memory of the table at each finest resolution
+for (int maxRes = 0; maxRes <= 4; maxRes++) {
+    H3_EXPORT(createCellGeometryTable)(maxRes, &table);
+    printf("\t-- table to res %d: %" PRId64 " bytes\n", maxRes,
+           table.numBytes);
+    H3_EXPORT(destroyCellGeometryTable)(&table);
+}
+
+BENCHMARK(createCellGeometryTable3, 10, {
+    H3_EXPORT(createCellGeometryTable)(3, &table);
+    H3_EXPORT(destroyCellGeometryTable)(&table);
+});
+
+H3_EXPORT(createCellGeometryTable)(4, &table);
+
+BENCHMARK(cellToLatLngRes3, 100000, {
+    H3_EXPORT(cellToLatLng)(res3, &center);
+    DO_NOT_OPTIMIZE(center);
+});
+BENCHMARK(cellToLatLngWithTableRes3, 100000, {
+    H3_EXPORT(cellToLatLngWithTable)(&table, res3, &center);
+    DO_NOT_OPTIMIZE(center);
+});
+BENCHMARK(cellToBoundaryRes3, 100000, {
+    H3_EXPORT(cellToBoundary)(res3, &boundary);
+    DO_NOT_OPTIMIZE(boundary);
+});
+BENCHMARK(cellToBoundaryWithTableRes3, 100000, {
+    H3_EXPORT(cellToBoundaryWithTable)(&table, res3, &boundary);
+    DO_NOT_OPTIMIZE(boundary);
+});
+
+BENCHMARK(cellToLatLngRes4, 100000, {
+    H3_EXPORT(cellToLatLng)(res4, &center);
+    DO_NOT_OPTIMIZE(center);
+});
+BENCHMARK(cellToLatLngWithTableRes4, 100000, {
+    H3_EXPORT(cellToLatLngWithTable)(&table, res4, &center);
+    DO_NOT_OPTIMIZE(center);
+});
+BENCHMARK(cellToBoundaryRes4, 100000, {
+    H3_EXPORT(cellToBoundary)(res4, &boundary);
+    DO_NOT_OPTIMIZE(boundary);
+});
+BENCHMARK(cellToBoundaryWithTableRes4, 100000, {
+    H3_EXPORT(cellToBoundaryWithTable)(&table, res4, &boundary);
+    DO_NOT_OPTIMIZE(boundary);
+});
+
+H3_EXPORT(destroyCellGeometryTable)(&table);
+
+END_BENCHMARKS();
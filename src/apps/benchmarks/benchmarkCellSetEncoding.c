@@ -0,0 +1,90 @@
+/*
+ * Copyright 2023 Uber Technologies, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <inttypes.h>
+#include <stdlib.h>
+
+#include "benchmark.h"
+#include "h3api.h"
+
+#define K 100
+#define TEXT_SIZE 17
+
+static int compareCells(const void *a, const void *b) {
+    H3Index cellA = *(const H3Index *)a;
+    H3Index cellB = *(const H3Index *)b;
+    return cellA < cellB ? -1 : cellA > cellB;
+}
+
+/** Parses indexes from text, one per line, as the filters do */
+static void parseText(const char *text, int64_t numCells, H3Index *out) {
+    for (int64_t i = 0; i < numCells; i++) {
+        H3_EXPORT(stringToH3)(text + i * TEXT_SIZE, &out[i]);
+    }
+}
+
+static void searchEncoded(const uint8_t *data, int64_t size,
+                          const H3Index *cells, int64_t numCells) {
+    int contains;
+    for (int64_t i = 0; i < numCells; i += 97) {
+        H3_EXPORT(encodedCellSetContains)(data, size, cells[i], &contains);
+        DO_NOT_OPTIMIZE(contains);
+    }
+}
+
+BEGIN_BENCHMARKS();
+
+int64_t numCells;
+H3_EXPORT(maxGridDiskSize)(K, &numCells);
+H3Index *cells = calloc(numCells, sizeof(H3Index));
+H3_EXPORT(gridDisk)(0x89283080ddbffff, K, cells);
+qsort(cells, numCells, sizeof(H3Index), compareCells);
+
+char *text = calloc(numCells, TEXT_SIZE);
+for (int64_t i = 0; i < numCells; i++) {
+    // Each line is 15 hex digits, a newline, and the terminator
+    snprintf(text + i * TEXT_SIZE, TEXT_SIZE, "%" PRIx64 "\n", cells[i]);
+}
+
+int64_t size;
+H3_EXPORT(encodeCellSetSize)(cells, numCells, &size);
+uint8_t *data = calloc(size, 1);
+H3_EXPORT(encodeCellSet)(cells, numCells, data, size);
+H3Index *decoded = calloc(numCells, sizeof(H3Index));
+benchmarkNote("\t-- %lld cells: %lld bytes as text, %lld bytes encoded\n",
+              (long long)numCells, (long long)numCells * (TEXT_SIZE - 1),
+              (long long)size);
+
+BENCHMARK(encodeCellSet, 100, {
+    H3_EXPORT(encodeCellSet)(cells, numCells, data, size);
+    DO_NOT_OPTIMIZE(data);
+});
+BENCHMARK(decodeCellSet, 100, {
+    H3_EXPORT(decodeCellSet)(data, size, decoded, numCells);
+    DO_NOT_OPTIMIZE(decoded);
+});
+BENCHMARK(parseText, 100, {
+    parseText(text, numCells, decoded);
+    DO_NOT_OPTIMIZE(decoded);
+});
+BENCHMARK(encodedCellSetContains, 100,
+          { searchEncoded(data, size, cells, numCells); });
+
+free(decoded);
+free(data);
+free(text);
+free(cells);
+
+END_BENCHMARKS();
@@ -0,0 +1,64 @@
+/*
+ * Copyright 2023 Uber Technologies, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "benchmark.h"
+#include "h3api.h"
+
+// Fixtures. Cells are all children of a res 0 cell, so positions are
+// relative to res 0.
+H3Index hex = 0x8f28308280f18f2;
+H3Index pentagonChild = 0x8f0800000000146;
+H3Index parent = 0x8029fffffffffff;
+H3Index pentagon = 0x8009fffffffffff;
+int64_t positions[4096];
+H3Index children[4096];
+
+BEGIN_BENCHMARKS();
+
+int64_t pos;
+H3Index cell;
+H3_EXPORT(cellToChildPos)(hex, 0, &pos);
+for (int i = 0; i < 4096; i++) {
+    positions[i] = pos + i;
+}
+H3_EXPORT(childPosToCells)(positions, 4096, parent, 15, children);
+
+BENCHMARK(cellToChildPos, 100000, {
+    H3_EXPORT(cellToChildPos)(hex, 0, &pos);
+    DO_NOT_OPTIMIZE(pos);
+});
+BENCHMARK(cellToChildPosPentagon, 100000, {
+    H3_EXPORT(cellToChildPos)(pentagonChild, 0, &pos);
+    DO_NOT_OPTIMIZE(pos);
+});
+BENCHMARK(childPosToCell, 100000, {
+    H3_EXPORT(childPosToCell)(pos, parent, 15, &cell);
+    DO_NOT_OPTIMIZE(cell);
+});
+BENCHMARK(childPosToCellPentagon, 100000, {
+    H3_EXPORT(childPosToCell)(42, pentagon, 15, &cell);
+    DO_NOT_OPTIMIZE(cell);
+});
+
+BENCHMARK(cellsToChildPos4096, 1000, {
+    H3_EXPORT(cellsToChildPos)(children, 4096, 0, positions);
+    DO_NOT_OPTIMIZE(positions);
+});
+BENCHMARK(childPosToCells4096, 1000, {
+    H3_EXPORT(childPosToCells)(positions, 4096, parent, 15, children);
+    DO_NOT_OPTIMIZE(children);
+});
+
+END_BENCHMARKS();
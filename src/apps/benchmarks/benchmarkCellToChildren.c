@@ -29,11 +29,32 @@ if (H3_EXPORT(cellToChildrenSize)(hex, 14, &outSz)) {
 }
 H3Index *out = calloc(outSz, sizeof(H3Index));
 
-BENCHMARK(cellToChildren1, 10000, { H3_EXPORT(cellToChildren)(hex, 10, out); });
-BENCHMARK(cellToChildren2, 10000, { H3_EXPORT(cellToChildren)(hex, 11, out); });
-BENCHMARK(cellToChildren3, 10000, { H3_EXPORT(cellToChildren)(hex, 12, out); });
-BENCHMARK(cellToChildren4, 10000, { H3_EXPORT(cellToChildren)(hex, 13, out); });
-BENCHMARK(cellToChildren5, 10000, { H3_EXPORT(cellToChildren)(hex, 14, out); });
+BENCHMARK(cellToChildren1, 10000, {
+    H3_EXPORT(cellToChildren)(hex, 10, out);
+    DO_NOT_OPTIMIZE(out);
+});
+BENCHMARK(cellToChildren2, 10000, {
+    H3_EXPORT(cellToChildren)(hex, 11, out);
+    DO_NOT_OPTIMIZE(out);
+});
+BENCHMARK(cellToChildren3, 10000, {
+    H3_EXPORT(cellToChildren)(hex, 12, out);
+    DO_NOT_OPTIMIZE(out);
+});
+BENCHMARK(cellToChildren4, 10000, {
+    H3_EXPORT(cellToChildren)(hex, 13, out);
+    DO_NOT_OPTIMIZE(out);
+});
+BENCHMARK(cellToChildren5, 10000, {
+    H3_EXPORT(cellToChildren)(hex, 14, out);
+    DO_NOT_OPTIMIZE(out);
+});
+
+CellRange range;
+BENCHMARK(cellToChildrenRange5, 10000, {
+    H3_EXPORT(cellToChildrenRange)(hex, 14, &range);
+    DO_NOT_OPTIMIZE(range);
+});
 
 free(out);
 
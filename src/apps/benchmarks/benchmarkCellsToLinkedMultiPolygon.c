@@ -45,17 +45,20 @@ LinkedGeoPolygon polygon;
 
 BENCHMARK(cellsToLinkedMultiPolygonRing2, 10000, {
     H3_EXPORT(cellsToLinkedMultiPolygon)(ring2, ring2Count, &polygon);
+    DO_NOT_OPTIMIZE(polygon);
     H3_EXPORT(destroyLinkedMultiPolygon)(&polygon);
 });
 
 BENCHMARK(cellsToLinkedMultiPolygonDonut, 10000, {
     H3_EXPORT(cellsToLinkedMultiPolygon)(donut, donutCount, &polygon);
+    DO_NOT_OPTIMIZE(polygon);
     H3_EXPORT(destroyLinkedMultiPolygon)(&polygon);
 });
 
 BENCHMARK(cellsToLinkedMultiPolygonNestedDonuts, 10000, {
     H3_EXPORT(cellsToLinkedMultiPolygon)
     (nestedDonuts, nestedDonutsCount, &polygon);
+    DO_NOT_OPTIMIZE(polygon);
     H3_EXPORT(destroyLinkedMultiPolygon)(&polygon);
 });
 
@@ -0,0 +1,128 @@
+/*
+ * Copyright 2023 Uber Technologies, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <stdlib.h>
+
+#include "benchmark.h"
+#include "h3api.h"
+
+// Fixtures
+LatLng sfVerts[] = {
+    {0.659966917655, -2.1364398519396},  {0.6595011102219, -2.1359434279405},
+    {0.6583348114025, -2.1354884206045}, {0.6581220034068, -2.1382437718946},
+    {0.6594479998527, -2.1384597563896}, {0.6599990002976, -2.1376771158464}};
+GeoLoop sfGeoLoop = {.numVerts = 6, .verts = sfVerts};
+GeoPolygon sfGeoPolygon;
+
+#define RES 11
+// Shift of the second polygon, so that the two partially overlap
+#define SHIFT_LNG 0.0008
+
+static int compareCells(const void *a, const void *b) {
+    H3Index cellA = *(const H3Index *)a;
+    H3Index cellB = *(const H3Index *)b;
+    return cellA < cellB ? -1 : cellA > cellB;
+}
+
+/** Compacted cells of the polygon at RES, with H3_NULL entries removed */
+static H3Index *compactedPolygon(int64_t *numCompacted) {
+    int64_t numCells;
+    H3_EXPORT(maxPolygonToCellsSize)(&sfGeoPolygon, RES, 0, &numCells);
+    H3Index *cells = calloc(numCells, sizeof(H3Index));
+    H3_EXPORT(polygonToCells)(&sfGeoPolygon, RES, 0, cells);
+    int64_t numFound = 0;
+    for (int64_t i = 0; i < numCells; i++) {
+        if (cells[i]) {
+            cells[numFound++] = cells[i];
+        }
+    }
+    H3Index *compacted = calloc(numFound, sizeof(H3Index));
+    H3_EXPORT(compactCells)(cells, compacted, numFound);
+    *numCompacted = 0;
+    for (int64_t i = 0; i < numFound; i++) {
+        if (compacted[i]) {
+            compacted[(*numCompacted)++] = compacted[i];
+        }
+    }
+    free(cells);
+    return compacted;
+}
+
+/**
+ * Intersection by uncompacting both sets, searching one sorted set for the
+ * cells of the other, and compacting the result, for comparison.
+ */
+static void uncompactedIntersection(const H3Index *setA, int64_t numA,
+                                    const H3Index *setB, int64_t numB) {
+    int64_t sizeA, sizeB;
+    H3_EXPORT(uncompactCellsSize)(setA, numA, RES, &sizeA);
+    H3_EXPORT(uncompactCellsSize)(setB, numB, RES, &sizeB);
+    H3Index *cellsA = calloc(sizeA, sizeof(H3Index));
+    H3Index *cellsB = calloc(sizeB, sizeof(H3Index));
+    H3_EXPORT(uncompactCells)(setA, numA, cellsA, sizeA, RES);
+    H3_EXPORT(uncompactCells)(setB, numB, cellsB, sizeB, RES);
+    qsort(cellsB, sizeB, sizeof(H3Index), compareCells);
+
+    int64_t numResult = 0;
+    for (int64_t i = 0; i < sizeA; i++) {
+        if (bsearch(&cellsA[i], cellsB, sizeB, sizeof(H3Index),
+                    compareCells)) {
+            cellsA[numResult++] = cellsA[i];
+        }
+    }
+    H3Index *compacted = calloc(numResult, sizeof(H3Index));
+    H3_EXPORT(compactCells)(cellsA, compacted, numResult);
+    DO_NOT_OPTIMIZE(compacted);
+
+    free(compacted);
+    free(cellsB);
+    free(cellsA);
+}
+
+static void compactIntersection(const H3Index *setA, int64_t numA,
+                                const H3Index *setB, int64_t numB) {
+    int64_t size;
+    H3_EXPORT(compactCellSetOperationSize)
+    (setA, numA, setB, numB, CELL_SET_INTERSECTION, &size);
+    H3Index *out = calloc(size, sizeof(H3Index));
+    H3_EXPORT(compactCellSetOperation)
+    (setA, numA, setB, numB, CELL_SET_INTERSECTION, out, size);
+    DO_NOT_OPTIMIZE(out);
+    free(out);
+}
+
+BEGIN_BENCHMARKS();
+
+sfGeoPolygon.geoloop = sfGeoLoop;
+sfGeoPolygon.numHoles = 0;
+
+int64_t numA, numB;
+H3Index *setA = compactedPolygon(&numA);
+for (int i = 0; i < sfGeoLoop.numVerts; i++) {
+    sfVerts[i].lng += SHIFT_LNG;
+}
+H3Index *setB = compactedPolygon(&numB);
+benchmarkNote("\t-- res %d: %lld and %lld compacted cells\n", RES,
+              (long long)numA, (long long)numB);
+
+BENCHMARK(compactCellSetIntersection, 100,
+          { compactIntersection(setA, numA, setB, numB); });
+BENCHMARK(uncompactedCellSetIntersection, 100,
+          { uncompactedIntersection(setA, numA, setB, numB); });
+
+free(setB);
+free(setA);
+
+END_BENCHMARKS();
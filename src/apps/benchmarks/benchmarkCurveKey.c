@@ -0,0 +1,117 @@
+/*
+ * Copyright 2023 Uber Technologies, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <stdlib.h>
+
+#include "benchmark.h"
+#include "h3api.h"
+#include "iterators.h"
+
+#define RES 4
+
+static int compareInt64(const void *a, const void *b) {
+    int64_t valueA = *(const int64_t *)a;
+    int64_t valueB = *(const int64_t *)b;
+    return valueA < valueB ? -1 : valueA > valueB;
+}
+
+/** Position of a key in a sorted array of keys */
+static int64_t keyPosition(const uint64_t *sorted, int64_t numKeys,
+                           uint64_t key) {
+    int64_t lo = 0;
+    int64_t hi = numKeys;
+    while (lo < hi) {
+        int64_t mid = lo + (hi - lo) / 2;
+        if (sorted[mid] < key) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+    return lo;
+}
+
+/**
+ * Prints the distribution of distances in sort order between each cell and
+ * its neighbors, when the cells are sorted by the given keys.
+ */
+static void printNeighborDistances(const char *name, const H3Index *cells,
+                                   const uint64_t *keys, int64_t numCells) {
+    uint64_t *sorted = calloc(numCells, sizeof(uint64_t));
+    for (int64_t i = 0; i < numCells; i++) {
+        sorted[i] = keys[i];
+    }
+    H3_EXPORT(sortCells)(sorted, numCells);
+
+    int64_t *distances = calloc(numCells * 6, sizeof(int64_t));
+    int64_t numDistances = 0;
+    for (int64_t i = 0; i < numCells; i++) {
+        H3Index neighbors[7] = {0};
+        H3_EXPORT(gridDisk)(cells[i], 1, neighbors);
+        int64_t position = keyPosition(sorted, numCells, keys[i]);
+        for (int n = 0; n < 7; n++) {
+            if (neighbors[n] == H3_NULL || neighbors[n] == cells[i]) {
+                continue;
+            }
+            // Cells are in index order, so the neighbor's key can be found
+            // by its index
+            int64_t index = keyPosition(cells, numCells, neighbors[n]);
+            int64_t distance =
+                keyPosition(sorted, numCells, keys[index]) - position;
+            distances[numDistances++] = distance < 0 ? -distance : distance;
+        }
+    }
+    qsort(distances, numDistances, sizeof(int64_t), compareInt64);
+    benchmarkNote(
+        "\t-- %s neighbor distance: median %lld, p90 %lld, p99 %lld\n", name,
+        (long long)distances[numDistances / 2],
+        (long long)distances[numDistances * 9 / 10],
+        (long long)distances[numDistances * 99 / 100]);
+
+    free(distances);
+    free(sorted);
+}
+
+BEGIN_BENCHMARKS();
+
+int64_t numCells;
+H3_EXPORT(getNumCells)(RES, &numCells);
+H3Index *cells = calloc(numCells, sizeof(H3Index));
+uint64_t *keys = calloc(numCells, sizeof(uint64_t));
+H3Index *roundTrip = calloc(numCells, sizeof(H3Index));
+int64_t n = 0;
+for (IterCellsResolution iter = iterInitRes(RES); iter.h; iterStepRes(&iter)) {
+    cells[n++] = iter.h;
+}
+H3_EXPORT(sortCells)(cells, numCells);
+
+H3_EXPORT(cellsToCurveKeys)(cells, numCells, keys);
+printNeighborDistances("index order", cells, cells, numCells);
+printNeighborDistances("curve key order", cells, keys, numCells);
+
+BENCHMARK(cellsToCurveKeys, 10, {
+    H3_EXPORT(cellsToCurveKeys)(cells, numCells, keys);
+    DO_NOT_OPTIMIZE(keys);
+});
+BENCHMARK(curveKeysToCells, 10, {
+    H3_EXPORT(curveKeysToCells)(keys, numCells, roundTrip);
+    DO_NOT_OPTIMIZE(roundTrip);
+});
+
+free(roundTrip);
+free(keys);
+free(cells);
+
+END_BENCHMARKS();
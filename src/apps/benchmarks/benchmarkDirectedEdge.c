@@ -29,6 +29,7 @@ H3_EXPORT(originToDirectedEdges)(hex, edges);
 BENCHMARK(directedEdgeToBoundary, 10000, {
     for (int i = 0; i < 6; i++) {
         H3_EXPORT(directedEdgeToBoundary)(edges[i], &outBoundary);
+        DO_NOT_OPTIMIZE(outBoundary);
     }
 });
 
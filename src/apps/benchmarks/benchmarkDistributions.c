@@ -0,0 +1,354 @@
+/*
+ * Copyright 2023 Uber Technologies, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/** @file
+ * @brief Throughput of core functions over realistic point distributions
+ *
+ * Each benchmark iteration processes the next of NUM_POINTS points (or the
+ * cells containing them), so the time per iteration is the time per point,
+ * and branch predictors and caches see varied input instead of one fixed
+ * coordinate. Points are generated from a fixed seed, so every run uses the
+ * same points:
+ *
+ *     uniform    uniform over the sphere
+ *     urban      clustered around large cities
+ *     tracks     consecutive points along random walks, as from GPS traces
+ *     pentagons  near the pentagon centers
+ *     faceEdges  near the edges of the icosahedron faces
+ *
+ * Benchmarks are named function/distribution/resolution, and iterations per
+ * second are points per second.
+ */
+
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "benchmark.h"
+#include "constants.h"
+#include "h3api.h"
+
+/** Number of points in each distribution. A power of two. */
+#define NUM_POINTS 4096
+
+/** Seed of the point generator */
+#define SEED 20230118
+
+/** Number of vertexes of the polygon around each point */
+#define NUM_POLYGON_VERTS 6
+
+/** Grid distance of the disks around each point */
+#define DISK_K 2
+
+/** Maximum number of cells in the set compacted for each point */
+#define MAX_COMPACT_INPUT 49
+
+static uint64_t randomState = SEED;
+
+/** Uniform double in [0, 1), from a 64 bit linear congruential generator */
+static double randomUniform(void) {
+    randomState =
+        randomState * 6364136223846793005ULL + 1442695040888963407ULL;
+    return (double)(randomState >> 11) / (double)(1ULL << 53);
+}
+
+/** Uniform point on the sphere */
+static void randomPoint(LatLng *point) {
+    point->lat = asin(2 * randomUniform() - 1);
+    point->lng = (2 * randomUniform() - 1) * M_PI;
+}
+
+/**
+ * Point at a distance in kilometers and an azimuth in radians from an
+ * origin, along a great circle.
+ */
+static void movePoint(const LatLng *origin, double azimuth, double distanceKm,
+                      LatLng *point) {
+    double d = distanceKm / EARTH_RADIUS_KM;
+    double lat = asin(sin(origin->lat) * cos(d) +
+                      cos(origin->lat) * sin(d) * cos(azimuth));
+    double lng = origin->lng + atan2(sin(azimuth) * sin(d) * cos(origin->lat),
+                                     cos(d) - sin(origin->lat) * sin(lat));
+    point->lat = lat;
+    point->lng = remainder(lng, 2 * M_PI);
+}
+
+/**
+ * Point near an origin, at a distance spread evenly over the scales of all
+ * resolutions, from 1 meter to 100 kilometers.
+ */
+static void nearbyPoint(const LatLng *origin, LatLng *point) {
+    double distanceKm = 0.001 * pow(1e5, randomUniform());
+    movePoint(origin, 2 * M_PI * randomUniform(), distanceKm, point);
+}
+
+/** Large cities, in degrees */
+static const double CITIES[][2] = {
+    {35.68, 139.69},  {28.61, 77.21},  {31.23, 121.47}, {-23.55, -46.63},
+    {19.43, -99.13},  {30.04, 31.24},  {19.08, 72.88},  {39.90, 116.41},
+    {23.81, 90.41},   {34.69, 135.50}, {40.71, -74.01}, {24.86, 67.01},
+    {-34.60, -58.38}, {41.01, 28.98},  {6.52, 3.38},    {51.51, -0.13},
+    {48.86, 2.35},    {55.76, 37.62},  {-33.87, 151.21}, {37.77, -122.42}};
+
+/** Points normally distributed around cities, with a 10 km spread */
+static void urbanPoints(LatLng *out) {
+    int numCities = sizeof(CITIES) / sizeof(CITIES[0]);
+    for (int i = 0; i < NUM_POINTS; i++) {
+        const double *city = CITIES[(int)(randomUniform() * numCities)];
+        LatLng center = {.lat = H3_EXPORT(degsToRads)(city[0]),
+                         .lng = H3_EXPORT(degsToRads)(city[1])};
+        // Rayleigh distributed distance of a 2D normal distribution
+        double distanceKm = 10 * sqrt(-2 * log(1 - randomUniform()));
+        movePoint(&center, 2 * M_PI * randomUniform(), distanceKm,
+                  &out[i]);
+    }
+}
+
+/** Consecutive points 30 meters apart along random walks */
+static void trackPoints(LatLng *out) {
+    const int trackLength = 256;
+    double heading = 0;
+    for (int i = 0; i < NUM_POINTS; i++) {
+        if (i % trackLength == 0) {
+            randomPoint(&out[i]);
+            heading = 2 * M_PI * randomUniform();
+            continue;
+        }
+        heading += 0.2 * (randomUniform() - 0.5);
+        movePoint(&out[i - 1], heading, 0.03, &out[i]);
+    }
+}
+
+static void pentagonPoints(LatLng *out) {
+    H3Index pentagons[12];
+    H3_EXPORT(getPentagons)(0, pentagons);
+    for (int i = 0; i < NUM_POINTS; i++) {
+        LatLng center;
+        H3_EXPORT(cellToLatLng)(pentagons[i % 12], &center);
+        nearbyPoint(&center, &out[i]);
+    }
+}
+
+/**
+ * Icosahedron face of a point, or -1 if the finest cell containing it is
+ * on more than one face.
+ */
+static int pointFace(const LatLng *point) {
+    H3Index cell;
+    // Enough for a pentagon, unused entries stay -1
+    int faces[5] = {-1, -1, -1, -1, -1};
+    H3_EXPORT(latLngToCell)(point, MAX_H3_RES, &cell);
+    H3_EXPORT(getIcosahedronFaces)(cell, faces);
+    return faces[1] == -1 ? faces[0] : -1;
+}
+
+/**
+ * Points near a face edge, found by bisecting between nearby points on
+ * different faces.
+ */
+static void faceEdgePoints(LatLng *out) {
+    for (int i = 0; i < NUM_POINTS; i++) {
+        LatLng a;
+        LatLng b;
+        int faceA;
+        do {
+            randomPoint(&a);
+            movePoint(&a, 2 * M_PI * randomUniform(), 500, &b);
+            faceA = pointFace(&a);
+            // Bisection averages coordinates, so skip the antimeridian
+        } while (faceA == -1 || fabs(a.lng - b.lng) > M_PI ||
+                 faceA == pointFace(&b));
+        // Bisect to within about a meter of the edge
+        for (int step = 0; step < 20; step++) {
+            LatLng mid = {.lat = (a.lat + b.lat) / 2,
+                          .lng = (a.lng + b.lng) / 2};
+            int face = pointFace(&mid);
+            if (face == -1) {
+                a = mid;
+                break;
+            }
+            if (face == faceA) {
+                a = mid;
+            } else {
+                b = mid;
+            }
+        }
+        nearbyPoint(&a, &out[i]);
+    }
+}
+
+static void uniformPoints(LatLng *out) {
+    for (int i = 0; i < NUM_POINTS; i++) {
+        randomPoint(&out[i]);
+    }
+}
+
+/** A point distribution */
+typedef struct {
+    const char *name;
+    void (*generate)(LatLng *out);
+} Distribution;
+
+static const Distribution DISTRIBUTIONS[] = {{"uniform", uniformPoints},
+                                             {"urban", urbanPoints},
+                                             {"tracks", trackPoints},
+                                             {"pentagons", pentagonPoints},
+                                             {"faceEdges", faceEdgePoints}};
+
+// Fixtures, for one distribution and resolution
+
+static LatLng points[NUM_POINTS];
+static H3Index cells[NUM_POINTS];
+static H3Index compactInput[NUM_POINTS][MAX_COMPACT_INPUT];
+static int compactInputSize[NUM_POINTS];
+static LatLng polygonVerts[NUM_POINTS][NUM_POLYGON_VERTS];
+static H3Index *polygonCells;
+static int64_t polygonCellsSize;
+
+// Outputs
+static LatLng outPoint;
+static CellBoundary outBoundary;
+static H3Index outCells[MAX_COMPACT_INPUT];
+static H3Index outCell;
+
+/** Index of the next point of a benchmark */
+static int next;
+
+/** Cells at res to compact for a cell: the children of a disk of parents */
+static int compactCellsInput(H3Index cell, int res, H3Index *out) {
+    H3Index disk[7] = {0};
+    int n = 0;
+    if (res == 0) {
+        H3_EXPORT(gridDisk)(cell, 1, disk);
+        for (int d = 0; d < 7; d++) {
+            if (disk[d]) out[n++] = disk[d];
+        }
+        return n;
+    }
+    H3Index parent;
+    H3_EXPORT(cellToParent)(cell, res - 1, &parent);
+    H3_EXPORT(gridDisk)(parent, 1, disk);
+    for (int d = 0; d < 7; d++) {
+        if (!disk[d]) continue;
+        int64_t numChildren;
+        H3_EXPORT(cellToChildrenSize)(disk[d], res, &numChildren);
+        H3_EXPORT(cellToChildren)(disk[d], res, out + n);
+        n += (int)numChildren;
+    }
+    return n;
+}
+
+/** Computes the fixtures of each point at res */
+static void prepare(int res) {
+    double edgeKm;
+    H3_EXPORT(getHexagonEdgeLengthAvgKm)(res, &edgeKm);
+    polygonCellsSize = 0;
+    for (int i = 0; i < NUM_POINTS; i++) {
+        H3_EXPORT(latLngToCell)(&points[i], res, &cells[i]);
+        compactInputSize[i] =
+            compactCellsInput(cells[i], res, compactInput[i]);
+
+        for (int v = 0; v < NUM_POLYGON_VERTS; v++) {
+            movePoint(&points[i], 2 * M_PI * v / NUM_POLYGON_VERTS,
+                      3 * edgeKm, &polygonVerts[i][v]);
+        }
+        GeoPolygon polygon = {
+            .geoloop = {.numVerts = NUM_POLYGON_VERTS,
+                        .verts = polygonVerts[i]}};
+        int64_t size;
+        H3_EXPORT(maxPolygonToCellsSize)(&polygon, res, 0, &size);
+        if (size > polygonCellsSize) polygonCellsSize = size;
+    }
+    free(polygonCells);
+    polygonCells = calloc(polygonCellsSize, sizeof(H3Index));
+    next = 0;
+}
+
+static void nextLatLngToCell(int res) {
+    H3_EXPORT(latLngToCell)(&points[next], res, &outCell);
+    DO_NOT_OPTIMIZE(outCell);
+    next = (next + 1) & (NUM_POINTS - 1);
+}
+
+static void nextCellToLatLng(void) {
+    H3_EXPORT(cellToLatLng)(cells[next], &outPoint);
+    DO_NOT_OPTIMIZE(outPoint);
+    next = (next + 1) & (NUM_POINTS - 1);
+}
+
+static void nextCellToBoundary(void) {
+    H3_EXPORT(cellToBoundary)(cells[next], &outBoundary);
+    DO_NOT_OPTIMIZE(outBoundary);
+    next = (next + 1) & (NUM_POINTS - 1);
+}
+
+static void nextGridDisk(void) {
+    H3_EXPORT(gridDisk)(cells[next], DISK_K, outCells);
+    DO_NOT_OPTIMIZE(outCells);
+    next = (next + 1) & (NUM_POINTS - 1);
+}
+
+static void nextCompactCells(void) {
+    H3_EXPORT(compactCells)(compactInput[next], outCells,
+                            compactInputSize[next]);
+    DO_NOT_OPTIMIZE(outCells);
+    next = (next + 1) & (NUM_POINTS - 1);
+}
+
+static void nextPolygonToCells(int res) {
+    GeoPolygon polygon = {.geoloop = {.numVerts = NUM_POLYGON_VERTS,
+                                      .verts = polygonVerts[next]}};
+    // The output must be zeroed for each call
+    memset(polygonCells, 0, polygonCellsSize * sizeof(H3Index));
+    H3_EXPORT(polygonToCells)(&polygon, res, 0, polygonCells);
+    DO_NOT_OPTIMIZE(polygonCells[0]);
+    next = (next + 1) & (NUM_POINTS - 1);
+}
+
+BEGIN_BENCHMARKS();
+
+char name[64];
+int numDistributions = sizeof(DISTRIBUTIONS) / sizeof(DISTRIBUTIONS[0]);
+for (int d = 0; d < numDistributions; d++) {
+    const char *distribution = DISTRIBUTIONS[d].name;
+    DISTRIBUTIONS[d].generate(points);
+
+    for (int res = 0; res <= MAX_H3_RES; res++) {
+        prepare(res);
+
+        snprintf(name, sizeof(name), "latLngToCell/%s/%d", distribution, res);
+        BENCHMARK_NAMED(name, NUM_POINTS, { nextLatLngToCell(res); });
+
+        snprintf(name, sizeof(name), "cellToLatLng/%s/%d", distribution, res);
+        BENCHMARK_NAMED(name, NUM_POINTS, { nextCellToLatLng(); });
+
+        snprintf(name, sizeof(name), "cellToBoundary/%s/%d", distribution,
+                 res);
+        BENCHMARK_NAMED(name, NUM_POINTS, { nextCellToBoundary(); });
+
+        snprintf(name, sizeof(name), "gridDisk/%s/%d", distribution, res);
+        BENCHMARK_NAMED(name, NUM_POINTS, { nextGridDisk(); });
+
+        snprintf(name, sizeof(name), "compactCells/%s/%d", distribution, res);
+        BENCHMARK_NAMED(name, NUM_POINTS, { nextCompactCells(); });
+
+        snprintf(name, sizeof(name), "polygonToCells/%s/%d", distribution,
+                 res);
+        BENCHMARK_NAMED(name, NUM_POINTS / 4, { nextPolygonToCells(res); });
+    }
+}
+free(polygonCells);
+
+END_BENCHMARKS();
@@ -21,6 +21,16 @@
 H3Index hex = 0x89283080ddbffff;
 H3Index pentagon = 0x89080000003ffff;
 
+void localIjToCellRect(const CoordIJ *min, const CoordIJ *max, H3Index *out) {
+    int64_t n = 0;
+    for (int j = min->j; j <= max->j; j++) {
+        for (int i = min->i; i <= max->i; i++) {
+            CoordIJ ij = {.i = i, .j = j};
+            H3_EXPORT(localIjToCell)(hex, &ij, 0, &out[n++]);
+        }
+    }
+}
+
 BEGIN_BENCHMARKS();
 
 int64_t outSz;
@@ -30,16 +40,75 @@ if (H3_EXPORT(maxGridDiskSize)(40, &outSz)) {
 }
 H3Index *out = calloc(outSz, sizeof(H3Index));
 
-BENCHMARK(gridDisk10, 10000, { H3_EXPORT(gridDisk)(hex, 10, out); });
-BENCHMARK(gridDisk20, 10000, { H3_EXPORT(gridDisk)(hex, 20, out); });
-BENCHMARK(gridDisk30, 10000, { H3_EXPORT(gridDisk)(hex, 30, out); });
-BENCHMARK(gridDisk40, 10000, { H3_EXPORT(gridDisk)(hex, 40, out); });
+BENCHMARK(gridDisk10, 10000, {
+    H3_EXPORT(gridDisk)(hex, 10, out);
+    DO_NOT_OPTIMIZE(out);
+});
+BENCHMARK(gridDisk20, 10000, {
+    H3_EXPORT(gridDisk)(hex, 20, out);
+    DO_NOT_OPTIMIZE(out);
+});
+BENCHMARK(gridDisk30, 10000, {
+    H3_EXPORT(gridDisk)(hex, 30, out);
+    DO_NOT_OPTIMIZE(out);
+});
+BENCHMARK(gridDisk40, 10000, {
+    H3_EXPORT(gridDisk)(hex, 40, out);
+    DO_NOT_OPTIMIZE(out);
+});
+
+BENCHMARK(gridDiskPentagon10, 500, {
+    H3_EXPORT(gridDisk)(pentagon, 10, out);
+    DO_NOT_OPTIMIZE(out);
+});
+BENCHMARK(gridDiskPentagon20, 500, {
+    H3_EXPORT(gridDisk)(pentagon, 20, out);
+    DO_NOT_OPTIMIZE(out);
+});
+BENCHMARK(gridDiskPentagon30, 50, {
+    H3_EXPORT(gridDisk)(pentagon, 30, out);
+    DO_NOT_OPTIMIZE(out);
+});
+BENCHMARK(gridDiskPentagon40, 10, {
+    H3_EXPORT(gridDisk)(pentagon, 40, out);
+    DO_NOT_OPTIMIZE(out);
+});
+
+H3_EXPORT(gridDisk)(hex, 20, out);
+int64_t diskSz;
+H3_EXPORT(maxGridDiskSize)(20, &diskSz);
+int64_t *distances = calloc(diskSz, sizeof(int64_t));
+LocalIjOrigin origin;
+H3_EXPORT(prepareLocalIjOrigin)(hex, &origin);
+
+BENCHMARK(gridDistanceDisk20, 1000, {
+    for (int64_t i = 0; i < diskSz; i++) {
+        H3_EXPORT(gridDistance)(hex, out[i], &distances[i]);
+    }
+    DO_NOT_OPTIMIZE(distances);
+});
+BENCHMARK(gridDistancesFromOriginDisk20, 1000, {
+    H3_EXPORT(gridDistancesFromOrigin)(&origin, out, diskSz, distances);
+    DO_NOT_OPTIMIZE(distances);
+});
+
+CoordIJ rectMin = {-20, -20};
+CoordIJ rectMax = {20, 20};
+int64_t rectSz;
+H3_EXPORT(localIjRectSize)(&rectMin, &rectMax, &rectSz);
+H3Index *rect = calloc(rectSz, sizeof(H3Index));
 
-BENCHMARK(gridDiskPentagon10, 500, { H3_EXPORT(gridDisk)(pentagon, 10, out); });
-BENCHMARK(gridDiskPentagon20, 500, { H3_EXPORT(gridDisk)(pentagon, 20, out); });
-BENCHMARK(gridDiskPentagon30, 50, { H3_EXPORT(gridDisk)(pentagon, 30, out); });
-BENCHMARK(gridDiskPentagon40, 10, { H3_EXPORT(gridDisk)(pentagon, 40, out); });
+BENCHMARK(localIjToCellRect20, 1000, {
+    localIjToCellRect(&rectMin, &rectMax, rect);
+    DO_NOT_OPTIMIZE(rect);
+});
+BENCHMARK(localIjRectToCells20, 1000, {
+    H3_EXPORT(localIjRectToCells)(hex, &rectMin, &rectMax, 0, rect);
+    DO_NOT_OPTIMIZE(rect);
+});
 
+free(rect);
+free(distances);
 free(out);
 
 END_BENCHMARKS();
@@ -13,26 +13,138 @@
  * See the License for the specific language governing permissions and
  * limitations under the License.
  */
+#include <inttypes.h>
+#include <stdio.h>
+
 #include "benchmark.h"
 #include "h3api.h"
+#include "h3inline.h"
 #include "latLng.h"
 
 // Fixtures (arbitrary res 9 hexagon)
 LatLng coord = {0.659966917655, -2.1364398519396};
 H3Index hex = 0x89283080ddbffff;
 
+// Fixtures for the accessors (all res 5 descendants of a pentagon)
+H3Index pentagon = 0x8009fffffffffff;
+H3Index *cells;
+int64_t numCells;
+
+/** Counts the pentagons in cells with the exported isPentagon. */
+static inline int countPentagons(void) {
+    int count = 0;
+    for (int64_t i = 0; i < numCells; i++) {
+        count += H3_EXPORT(isPentagon)(cells[i]);
+    }
+    return count;
+}
+
+/** Counts the pentagons in cells with the inline h3IsPentagon. */
+static inline int countPentagonsInline(void) {
+    int count = 0;
+    for (int64_t i = 0; i < numCells; i++) {
+        count += h3IsPentagon(cells[i]);
+    }
+    return count;
+}
+
+/** Sums the base cells of cells with the exported getBaseCellNumber. */
+static inline int sumBaseCells(void) {
+    int sum = 0;
+    for (int64_t i = 0; i < numCells; i++) {
+        sum += H3_EXPORT(getBaseCellNumber)(cells[i]);
+    }
+    return sum;
+}
+
+/** Sums the base cells of cells with the inline h3GetBaseCell. */
+static inline int sumBaseCellsInline(void) {
+    int sum = 0;
+    for (int64_t i = 0; i < numCells; i++) {
+        sum += h3GetBaseCell(cells[i]);
+    }
+    return sum;
+}
+
 BEGIN_BENCHMARKS();
 
 LatLng outCoord;
 CellBoundary outBoundary;
 H3Index h;
+int64_t rank;
+char str[17];
+const char *hexStr = "89283080ddbffff";
 
-BENCHMARK(latLngToCell, 10000, { H3_EXPORT(latLngToCell)(&coord, 9, &h); });
+BENCHMARK(latLngToCell, 10000, {
+    H3_EXPORT(latLngToCell)(&coord, 9, &h);
+    DO_NOT_OPTIMIZE(h);
+});
 
-BENCHMARK(cellToLatLng, 10000, { H3_EXPORT(cellToLatLng)(hex, &outCoord); });
+BENCHMARK(cellToLatLng, 10000, {
+    H3_EXPORT(cellToLatLng)(hex, &outCoord);
+    DO_NOT_OPTIMIZE(outCoord);
+});
 
 BENCHMARK(cellToBoundary, 10000, {
     H3_EXPORT(cellToBoundary)(hex, &outBoundary);
+    DO_NOT_OPTIMIZE(outBoundary);
+});
+
+BENCHMARK(cellToRank, 10000, {
+    H3_EXPORT(cellToRank)(hex, &rank);
+    DO_NOT_OPTIMIZE(rank);
+});
+
+BENCHMARK(rankToCell, 10000, {
+    H3_EXPORT(rankToCell)(rank, 9, &h);
+    DO_NOT_OPTIMIZE(h);
+});
+
+BENCHMARK(stringToH3, 10000, {
+    H3_EXPORT(stringToH3)(hexStr, &h);
+    DO_NOT_OPTIMIZE(h);
+});
+
+BENCHMARK(sscanfH3, 10000, {
+    sscanf(hexStr, "%" PRIx64, &h);
+    DO_NOT_OPTIMIZE(h);
+});
+
+BENCHMARK(h3ToString, 10000, {
+    H3_EXPORT(h3ToString)(hex, str, 17);
+    DO_NOT_OPTIMIZE(str);
+});
+
+BENCHMARK(snprintfH3, 10000, {
+    snprintf(str, 17, "%" PRIx64, hex);
+    DO_NOT_OPTIMIZE(str);
+});
+
+H3_EXPORT(cellToChildrenSize)(pentagon, 5, &numCells);
+cells = calloc(numCells, sizeof(H3Index));
+H3_EXPORT(cellToChildren)(pentagon, 5, cells);
+int count;
+
+BENCHMARK(isPentagon, 1000, {
+    count = countPentagons();
+    DO_NOT_OPTIMIZE(count);
 });
 
+BENCHMARK(isPentagonInline, 1000, {
+    count = countPentagonsInline();
+    DO_NOT_OPTIMIZE(count);
+});
+
+BENCHMARK(getBaseCellNumber, 1000, {
+    count = sumBaseCells();
+    DO_NOT_OPTIMIZE(count);
+});
+
+BENCHMARK(getBaseCellNumberInline, 1000, {
+    count = sumBaseCellsInline();
+    DO_NOT_OPTIMIZE(count);
+});
+
+free(cells);
+
 END_BENCHMARKS();
@@ -50,11 +50,19 @@ CellArray pentagonSetup(int parentRes, int childRes, int nullEvery) {
 static inline void runValidation(const CellArray ca) {
     // Apply `isValidCell` to every element of `ca.cells`.
     for (int64_t i = 0; i < ca.N; i++) {
-        H3_EXPORT(isValidCell)(ca.cells[i]);
+        int valid = H3_EXPORT(isValidCell)(ca.cells[i]);
+        DO_NOT_OPTIMIZE(valid);
     }
 }
 
+static inline void runBatchValidation(const CellArray ca, int *out) {
+    // Apply `isValidCells` to all of `ca.cells` at once.
+    H3_EXPORT(isValidCells)(ca.cells, ca.N, out);
+    DO_NOT_OPTIMIZE(out);
+}
+
 CellArray ca;
+int *out;
 
 BEGIN_BENCHMARKS();
 
@@ -68,6 +76,13 @@ ca = pentagonSetup(8, 14, 0);
 BENCHMARK(pentagonChildren_8_14, 1000, { runValidation(ca); });
 free(ca.cells);
 
+// pentagon 8->14, in one batch
+ca = pentagonSetup(8, 14, 0);
+out = calloc(ca.N, sizeof(int));
+BENCHMARK(pentagonChildren_8_14_batch, 1000, { runBatchValidation(ca, out); });
+free(out);
+free(ca.cells);
+
 // pentagon 8->14; H3_NULL every 2
 ca = pentagonSetup(8, 14, 2);
 BENCHMARK(pentagonChildren_8_14_null_2, 1000, { runValidation(ca); });
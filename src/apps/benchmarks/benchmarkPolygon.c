@@ -135,16 +135,24 @@ largeGeoLoop.numVerts = 90;
 largeGeoLoop.verts = largeVerts;
 bboxFromGeoLoop(&largeGeoLoop, &largeBBox);
 
-BENCHMARK(pointInsideGeoLoopSmall, 100000,
-          { pointInsideGeoLoop(&smallGeoLoop, &smallBBox, &coord); });
+BENCHMARK(pointInsideGeoLoopSmall, 100000, {
+    bool inside = pointInsideGeoLoop(&smallGeoLoop, &smallBBox, &coord);
+    DO_NOT_OPTIMIZE(inside);
+});
 
-BENCHMARK(pointInsideGeoLoopLarge, 100000,
-          { pointInsideGeoLoop(&largeGeoLoop, &largeBBox, &coord); });
+BENCHMARK(pointInsideGeoLoopLarge, 100000, {
+    bool inside = pointInsideGeoLoop(&largeGeoLoop, &largeBBox, &coord);
+    DO_NOT_OPTIMIZE(inside);
+});
 
-BENCHMARK(bboxFromGeoLoopSmall, 100000,
-          { bboxFromGeoLoop(&smallGeoLoop, &smallBBox); });
+BENCHMARK(bboxFromGeoLoopSmall, 100000, {
+    bboxFromGeoLoop(&smallGeoLoop, &smallBBox);
+    DO_NOT_OPTIMIZE(smallBBox);
+});
 
-BENCHMARK(bboxFromGeoLoopLarge, 100000,
-          { bboxFromGeoLoop(&largeGeoLoop, &largeBBox); });
+BENCHMARK(bboxFromGeoLoopLarge, 100000, {
+    bboxFromGeoLoop(&largeGeoLoop, &largeBBox);
+    DO_NOT_OPTIMIZE(largeBBox);
+});
 
 END_BENCHMARKS();
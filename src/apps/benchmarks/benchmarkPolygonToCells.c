@@ -125,6 +125,7 @@ BENCHMARK(polygonToCellsSF, 500, {
     H3_EXPORT(maxPolygonToCellsSize)(&sfGeoPolygon, 9, 0, &numHexagons);
     hexagons = calloc(numHexagons, sizeof(H3Index));
     H3_EXPORT(polygonToCells)(&sfGeoPolygon, 9, 0, hexagons);
+    DO_NOT_OPTIMIZE(hexagons);
     free(hexagons);
 });
 
@@ -132,13 +133,37 @@ BENCHMARK(polygonToCellsAlameda, 500, {
     H3_EXPORT(maxPolygonToCellsSize)(&alamedaGeoPolygon, 9, 0, &numHexagons);
     hexagons = calloc(numHexagons, sizeof(H3Index));
     H3_EXPORT(polygonToCells)(&alamedaGeoPolygon, 9, 0, hexagons);
+    DO_NOT_OPTIMIZE(hexagons);
     free(hexagons);
 });
 
+PolygonToCellsWorkspace workspace = {0};
+
+BENCHMARK(polygonToCellsWithWorkspaceSF, 500, {
+    H3_EXPORT(maxPolygonToCellsSize)(&sfGeoPolygon, 9, 0, &numHexagons);
+    hexagons = calloc(numHexagons, sizeof(H3Index));
+    H3_EXPORT(polygonToCellsWithWorkspace)(&sfGeoPolygon, 9, 0, &workspace,
+                                           hexagons);
+    DO_NOT_OPTIMIZE(hexagons);
+    free(hexagons);
+});
+
+BENCHMARK(polygonToCellsWithWorkspaceAlameda, 500, {
+    H3_EXPORT(maxPolygonToCellsSize)(&alamedaGeoPolygon, 9, 0, &numHexagons);
+    hexagons = calloc(numHexagons, sizeof(H3Index));
+    H3_EXPORT(polygonToCellsWithWorkspace)(&alamedaGeoPolygon, 9, 0,
+                                           &workspace, hexagons);
+    DO_NOT_OPTIMIZE(hexagons);
+    free(hexagons);
+});
+
+H3_EXPORT(destroyPolygonToCellsWorkspace)(&workspace);
+
 BENCHMARK(polygonToCellsSouthernExpansion, 10, {
     H3_EXPORT(maxPolygonToCellsSize)(&southernGeoPolygon, 9, 0, &numHexagons);
     hexagons = calloc(numHexagons, sizeof(H3Index));
     H3_EXPORT(polygonToCells)(&southernGeoPolygon, 9, 0, hexagons);
+    DO_NOT_OPTIMIZE(hexagons);
     free(hexagons);
 });
 
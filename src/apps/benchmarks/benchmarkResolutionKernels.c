@@ -0,0 +1,81 @@
+/*
+ * Copyright 2023 Uber Technologies, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "benchmark.h"
+#include "faceijk.h"
+#include "h3Index.h"
+#include "h3api.h"
+#include "resolutionKernels.h"
+
+// Fixtures: coordinates of the cells containing a point, and the cells
+LatLng coord = {0.659966917655, -2.1364398519396};
+FaceIJK cellFijk[MAX_H3_RES + 1];
+CoordIJK baseCellIjk[MAX_H3_RES + 1];
+H3Index cells[MAX_H3_RES + 1];
+
+/** Encodes the digits of the fixture at res with the generic loop. */
+static inline void encodeGeneric(int res) {
+    CoordIJK ijk = cellFijk[res].coord;
+    H3Index h = H3_INIT;
+    _faceIjkToDigitsGeneric(&ijk, res, &h);
+    DO_NOT_OPTIMIZE(h);
+}
+
+/** Encodes the digits of the fixture at res with the kernel for res. */
+static inline void encodeSpecialized(int res) {
+    CoordIJK ijk = cellFijk[res].coord;
+    H3Index h = H3_INIT;
+    _resolutionKernels(res)->faceIjkToDigits(&ijk, &h);
+    DO_NOT_OPTIMIZE(h);
+}
+
+/** Decodes the digits of the fixture at res with the generic loop. */
+static inline void decodeGeneric(int res) {
+    CoordIJK ijk = baseCellIjk[res];
+    _digitsToFaceIjkGeneric(cells[res], res, &ijk);
+    DO_NOT_OPTIMIZE(ijk);
+}
+
+/** Decodes the digits of the fixture at res with the kernel for res. */
+static inline void decodeSpecialized(int res) {
+    CoordIJK ijk = baseCellIjk[res];
+    _resolutionKernels(res)->digitsToFaceIjk(cells[res], &ijk);
+    DO_NOT_OPTIMIZE(ijk);
+}
+
+BEGIN_BENCHMARKS();
+
+for (int res = 0; res <= MAX_H3_RES; res++) {
+    _geoToFaceIjk(&coord, res, &cellFijk[res]);
+    baseCellIjk[res] = cellFijk[res].coord;
+    cells[res] = H3_INIT;
+    _faceIjkToDigitsGeneric(&baseCellIjk[res], res, &cells[res]);
+}
+
+BENCHMARK(encodeGeneric5, 1000000, { encodeGeneric(5); });
+BENCHMARK(encodeSpecialized5, 1000000, { encodeSpecialized(5); });
+BENCHMARK(encodeGeneric9, 1000000, { encodeGeneric(9); });
+BENCHMARK(encodeSpecialized9, 1000000, { encodeSpecialized(9); });
+BENCHMARK(encodeGeneric15, 1000000, { encodeGeneric(15); });
+BENCHMARK(encodeSpecialized15, 1000000, { encodeSpecialized(15); });
+
+BENCHMARK(decodeGeneric5, 1000000, { decodeGeneric(5); });
+BENCHMARK(decodeSpecialized5, 1000000, { decodeSpecialized(5); });
+BENCHMARK(decodeGeneric9, 1000000, { decodeGeneric(9); });
+BENCHMARK(decodeSpecialized9, 1000000, { decodeSpecialized(9); });
+BENCHMARK(decodeGeneric15, 1000000, { decodeGeneric(15); });
+BENCHMARK(decodeSpecialized15, 1000000, { decodeSpecialized(15); });
+
+END_BENCHMARKS();
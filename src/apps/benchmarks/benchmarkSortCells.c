@@ -0,0 +1,83 @@
+/*
+ * Copyright 2023 Uber Technologies, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <stdlib.h>
+#include <string.h>
+
+#include "benchmark.h"
+#include "h3api.h"
+
+#define NUM_POINTS 100000
+
+static int compareCells(const void *a, const void *b) {
+    H3Index cellA = *(const H3Index *)a;
+    H3Index cellB = *(const H3Index *)b;
+    return cellA < cellB ? -1 : cellA > cellB;
+}
+
+/**
+ * Cells of pseudorandom points around San Francisco at res, in the order
+ * the points were generated.
+ */
+static void pointCells(int res, H3Index *cells) {
+    uint64_t state = 1;
+    for (int i = 0; i < NUM_POINTS; i++) {
+        state = state * 6364136223846793005ULL + 1442695040888963407ULL;
+        double u = (double)(state >> 11) / (double)(1ULL << 53);
+        state = state * 6364136223846793005ULL + 1442695040888963407ULL;
+        double v = (double)(state >> 11) / (double)(1ULL << 53);
+        LatLng point = {.lat = H3_EXPORT(degsToRads)(37.6 + 0.3 * u),
+                        .lng = H3_EXPORT(degsToRads)(-122.5 + 0.4 * v)};
+        H3_EXPORT(latLngToCell)(&point, res, &cells[i]);
+    }
+}
+
+static void sortAndDedup(H3Index *cells, const H3Index *input) {
+    memcpy(cells, input, NUM_POINTS * sizeof(H3Index));
+    int64_t numUnique;
+    H3_EXPORT(sortCells)(cells, NUM_POINTS);
+    H3_EXPORT(dedupSortedCells)(cells, NUM_POINTS, &numUnique);
+    DO_NOT_OPTIMIZE(numUnique);
+}
+
+static void qsortAndDedup(H3Index *cells, const H3Index *input) {
+    memcpy(cells, input, NUM_POINTS * sizeof(H3Index));
+    qsort(cells, NUM_POINTS, sizeof(H3Index), compareCells);
+    int64_t numUnique = 0;
+    for (int64_t i = 0; i < NUM_POINTS; i++) {
+        if (numUnique == 0 || cells[i] != cells[numUnique - 1]) {
+            cells[numUnique++] = cells[i];
+        }
+    }
+    DO_NOT_OPTIMIZE(numUnique);
+}
+
+BEGIN_BENCHMARKS();
+
+H3Index *input = calloc(NUM_POINTS, sizeof(H3Index));
+H3Index *cells = calloc(NUM_POINTS, sizeof(H3Index));
+
+pointCells(9, input);
+BENCHMARK(sortCellsRes9, 100, { sortAndDedup(cells, input); });
+BENCHMARK(qsortCellsRes9, 100, { qsortAndDedup(cells, input); });
+
+pointCells(15, input);
+BENCHMARK(sortCellsRes15, 100, { sortAndDedup(cells, input); });
+BENCHMARK(qsortCellsRes15, 100, { qsortAndDedup(cells, input); });
+
+free(cells);
+free(input);
+
+END_BENCHMARKS();
@@ -42,24 +42,73 @@ BEGIN_BENCHMARKS();
 
 H3Index *vertexes = calloc(6, sizeof(H3Index));
 
-BENCHMARK(cellToVertexes, 10000, { H3_EXPORT(cellToVertexes)(hex, vertexes); });
+BENCHMARK(cellToVertexes, 10000, {
+    H3_EXPORT(cellToVertexes)(hex, vertexes);
+    DO_NOT_OPTIMIZE(vertexes);
+});
 
 BENCHMARK(cellToVertexesPent, 10000, {
     H3_EXPORT(cellToVertexes)(pentagon, vertexes);
+    DO_NOT_OPTIMIZE(vertexes);
 });
 
 BENCHMARK(cellToVertexesRing, 10000, {
     for (int i = 0; i < ring2Count; i++) {
         H3_EXPORT(cellToVertexes)(ring2[i], vertexes);
+        DO_NOT_OPTIMIZE(vertexes);
     }
 });
 
 BENCHMARK(cellToVertexesRingPent, 10000, {
     for (int i = 0; i < ring2PentCount; i++) {
         H3_EXPORT(cellToVertexes)(ring2Pent[i], vertexes);
+        DO_NOT_OPTIMIZE(vertexes);
     }
 });
 
 free(vertexes);
 
+// A larger region, where most vertexes are shared by three cells
+int64_t diskSize;
+H3_EXPORT(maxGridDiskSize)(20, &diskSize);
+H3Index *disk = calloc(diskSize, sizeof(H3Index));
+H3_EXPORT(gridDisk)(hex, 20, disk);
+H3Index *diskVertexes = calloc(diskSize * 6, sizeof(H3Index));
+int64_t *cellVertexes = calloc(diskSize * 6, sizeof(int64_t));
+int64_t numVertexes;
+
+BENCHMARK(cellToVertexesDisk, 100, {
+    for (int64_t i = 0; i < diskSize; i++) {
+        H3_EXPORT(cellToVertexes)(disk[i], &diskVertexes[i * 6]);
+    }
+    DO_NOT_OPTIMIZE(diskVertexes);
+});
+
+BENCHMARK(cellsToVertexesDisk, 100, {
+    H3_EXPORT(cellsToVertexes)
+    (disk, diskSize, diskVertexes, &numVertexes, cellVertexes);
+    DO_NOT_OPTIMIZE(numVertexes);
+});
+
+CellBoundary boundary;
+LatLng *coords = calloc(diskSize * 6, sizeof(LatLng));
+
+BENCHMARK(cellToBoundaryDisk, 100, {
+    for (int64_t i = 0; i < diskSize; i++) {
+        H3_EXPORT(cellToBoundary)(disk[i], &boundary);
+        DO_NOT_OPTIMIZE(boundary);
+    }
+});
+
+BENCHMARK(cellsToVertexMeshDisk, 100, {
+    H3_EXPORT(cellsToVertexMesh)
+    (disk, diskSize, diskVertexes, coords, &numVertexes, cellVertexes);
+    DO_NOT_OPTIMIZE(numVertexes);
+});
+
+free(coords);
+free(cellVertexes);
+free(diskVertexes);
+free(disk);
+
 END_BENCHMARKS();
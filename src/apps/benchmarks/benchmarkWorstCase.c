@@ -0,0 +1,376 @@
+/*
+ * Copyright 2023 Uber Technologies, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/** @file
+ * @brief Time and memory of adversarial inputs, against complexity budgets
+ *
+ * Replays a curated corpus of inputs of the kinds the fuzzers find
+ * expensive: polygons with huge bounding boxes, many vertexes, or many
+ * holes for polygonToCells, disks that fall back to the safe algorithm of
+ * gridDiskDistances, and large sets for compactCells and uncompactCells.
+ *
+ * Each input is timed, and its peak memory is measured: the bytes allocated
+ * by the library, as counted by getAllocationStats, plus the output arrays. An
+ * input fails if it takes more time or memory than its budget. Time
+ * budgets are in units of a reference operation timed at startup, so that
+ * they hold on fast and slow machines alike; memory budgets are in bytes.
+ * The program exits with status 1 if any input fails.
+ *
+ * This benchmark is linked against a copy of the library that counts its
+ * allocations. When the library is built with ENABLE_HOT_PATH_COUNTERS, the
+ * counters of one run of each input are printed too.
+ */
+
+#include <stdlib.h>
+
+#include "benchmark.h"
+#include "h3api.h"
+
+/** Maximum number of vertexes of a polygon in the corpus */
+#define MAX_VERTS 256
+
+/** Maximum number of holes of a polygon in the corpus */
+#define MAX_HOLES 64
+
+/** Number of vertexes of each hole */
+#define HOLE_VERTS 4
+
+// Inputs
+
+static int res;
+static int k;
+static H3Index origin;
+static LatLng verts[MAX_VERTS];
+static LatLng holeVerts[MAX_HOLES][HOLE_VERTS];
+static GeoLoop holes[MAX_HOLES];
+static GeoPolygon polygon;
+static H3Index *cells = NULL;
+static int64_t numCells = 0;
+/** Bytes of the output arrays of the last run */
+static int64_t outputBytes = 0;
+
+/** Sets the outer loop of the polygon to a quadrilateral, in degrees */
+static void setQuad(double lat0, double lng0, double lat1, double lng1,
+                    double lat2, double lng2, double lat3, double lng3) {
+    const double degs[4][2] = {
+        {lat0, lng0}, {lat1, lng1}, {lat2, lng2}, {lat3, lng3}};
+    for (int v = 0; v < 4; v++) {
+        verts[v].lat = H3_EXPORT(degsToRads)(degs[v][0]);
+        verts[v].lng = H3_EXPORT(degsToRads)(degs[v][1]);
+    }
+    polygon = (GeoPolygon){.geoloop = {.numVerts = 4, .verts = verts}};
+}
+
+/** Nearly a hemisphere, which has a huge estimated size */
+static void setupHemisphere(void) {
+    setQuad(-80, -89, 80, -89, 80, 89, -80, 89);
+    res = 2;
+}
+
+/** A thin sliver across the antimeridian */
+static void setupTransmeridianSliver(void) {
+    setQuad(-40, 179.9, 40, 179.9, 40, -179.9, -40, -179.9);
+    res = 6;
+}
+
+/**
+ * A long, thin diagonal sliver, whose bounding box is far larger than the
+ * polygon
+ */
+static void setupDiagonalSliver(void) {
+    setQuad(0, 0, 0.001, 0, 20.001, 20, 20, 20);
+    res = 7;
+}
+
+/** A sawtooth with many vertexes, each point in polygon test visits all */
+static void setupSawtooth(void) {
+    int numTeeth = (MAX_VERTS - 2) / 2;
+    int v = 0;
+    for (int t = 0; t < numTeeth; t++) {
+        double lng = 10.0 * t / numTeeth;
+        verts[v++] = (LatLng){.lat = H3_EXPORT(degsToRads)(0),
+                              .lng = H3_EXPORT(degsToRads)(lng)};
+        verts[v++] = (LatLng){.lat = H3_EXPORT(degsToRads)(1),
+                              .lng = H3_EXPORT(degsToRads)(lng + 0.01)};
+    }
+    verts[v++] = (LatLng){.lat = H3_EXPORT(degsToRads)(-1),
+                          .lng = H3_EXPORT(degsToRads)(10)};
+    verts[v++] = (LatLng){.lat = H3_EXPORT(degsToRads)(-1),
+                          .lng = H3_EXPORT(degsToRads)(0)};
+    polygon = (GeoPolygon){.geoloop = {.numVerts = v, .verts = verts}};
+    res = 6;
+}
+
+/** A square with a grid of small square holes */
+static void setupManyHoles(void) {
+    setQuad(0, 0, 0, 1, 1, 1, 1, 0);
+    int side = 8;
+    for (int h = 0; h < MAX_HOLES; h++) {
+        double lat = (h / side + 0.25) / side;
+        double lng = (h % side + 0.25) / side;
+        double size = 0.5 / side;
+        const double degs[HOLE_VERTS][2] = {{lat, lng},
+                                            {lat, lng + size},
+                                            {lat + size, lng + size},
+                                            {lat + size, lng}};
+        for (int v = 0; v < HOLE_VERTS; v++) {
+            holeVerts[h][v].lat = H3_EXPORT(degsToRads)(degs[v][0]);
+            holeVerts[h][v].lng = H3_EXPORT(degsToRads)(degs[v][1]);
+        }
+        holes[h] = (GeoLoop){.numVerts = HOLE_VERTS, .verts = holeVerts[h]};
+    }
+    polygon.numHoles = MAX_HOLES;
+    polygon.holes = holes;
+    res = 8;
+}
+
+/** A polygon around the north pole */
+static void setupPolar(void) {
+    setQuad(80, -180, 80, -90, 80, 0, 80, 90);
+    res = 4;
+}
+
+/** All vertexes at one point */
+static void setupDegenerate(void) {
+    setQuad(37.77, -122.42, 37.77, -122.42, 37.77, -122.42, 37.77, -122.42);
+    res = 15;
+}
+
+static void runPolygonToCells(void) {
+    int64_t size;
+    if (H3_EXPORT(maxPolygonToCellsSize)(&polygon, res, 0, &size)) {
+        return;
+    }
+    H3Index *out = calloc(size, sizeof(H3Index));
+    H3_EXPORT(polygonToCells)(&polygon, res, 0, out);
+    free(out);
+    outputBytes = size * sizeof(H3Index);
+}
+
+/** A large disk around a pentagon, which needs the safe algorithm */
+static void setupPentagonDisk(void) {
+    H3Index pentagons[12];
+    H3_EXPORT(getPentagons)(5, pentagons);
+    origin = pentagons[0];
+    k = 50;
+}
+
+/** A disk larger than the whole grid at resolution 0 */
+static void setupWholeGridDisk(void) {
+    origin = 0x8001fffffffffff;
+    k = 30;
+}
+
+/** A large disk that reaches a distant pentagon */
+static void setupDiskReachingPentagon(void) {
+    H3Index pentagons[12];
+    H3_EXPORT(getPentagons)(8, pentagons);
+    H3_EXPORT(cellToCenterChild)(pentagons[3], 10, &origin);
+    H3Index neighbor[7] = {0};
+    // Start next to the pentagon, so the unsafe algorithm fails late
+    H3_EXPORT(gridRingUnsafe)(origin, 1, neighbor);
+    origin = neighbor[0] ? neighbor[0] : origin;
+    k = 100;
+}
+
+static void runGridDiskDistances(void) {
+    int64_t size;
+    H3_EXPORT(maxGridDiskSize)(k, &size);
+    H3Index *out = calloc(size, sizeof(H3Index));
+    int *distances = calloc(size, sizeof(int));
+    H3_EXPORT(gridDiskDistances)(origin, k, out, distances);
+    free(distances);
+    free(out);
+    outputBytes = size * (sizeof(H3Index) + sizeof(int));
+}
+
+/** Sets the cells to all descendants of a cell at a resolution */
+static void setChildren(H3Index parent, int childRes) {
+    free(cells);
+    H3_EXPORT(cellToChildrenSize)(parent, childRes, &numCells);
+    cells = calloc(numCells, sizeof(H3Index));
+    H3_EXPORT(cellToChildren)(parent, childRes, cells);
+}
+
+/** Every descendant of a cell, which compacts all the way up to it */
+static void setupFullChildren(void) {
+    setChildren(0x85283473fffffff, 11);
+}
+
+/**
+ * Every descendant of a cell but one, so nothing compacts past the
+ * missing cell's ancestors
+ */
+static void setupAlmostFullChildren(void) {
+    setChildren(0x85283473fffffff, 11);
+    numCells--;
+}
+
+/** Every descendant of a pentagon */
+static void setupPentagonChildren(void) {
+    setChildren(0x820807fffffffff, 9);
+}
+
+static void runCompactCells(void) {
+    H3Index *out = calloc(numCells, sizeof(H3Index));
+    H3_EXPORT(compactCells)(cells, out, numCells);
+    free(out);
+    outputBytes = numCells * sizeof(H3Index);
+}
+
+/** Every base cell, to a fine resolution */
+static void setupBaseCells(void) {
+    free(cells);
+    numCells = H3_EXPORT(res0CellCount)();
+    cells = calloc(numCells, sizeof(H3Index));
+    H3_EXPORT(getRes0Cells)(cells);
+    res = 5;
+}
+
+static void runUncompactCells(void) {
+    int64_t size;
+    H3_EXPORT(uncompactCellsSize)(cells, numCells, res, &size);
+    H3Index *out = calloc(size, sizeof(H3Index));
+    H3_EXPORT(uncompactCells)(cells, numCells, out, size, res);
+    free(out);
+    outputBytes = size * sizeof(H3Index);
+}
+
+/** An adversarial input and its budgets */
+typedef struct {
+    const char *name;
+    void (*setup)(void);
+    void (*run)(void);
+    int iterations;
+    /** Time budget, in reference operations */
+    double maxTime;
+    /** Memory budget, in bytes */
+    int64_t maxBytes;
+} WorstCase;
+
+/*
+ * Budgets are about four times the time and a quarter more than the memory
+ * that each input took when it was added, so that noise passes and
+ * algorithmic regressions do not. Update a budget when a change to the
+ * library is expected to change its input's cost.
+ */
+static const WorstCase CORPUS[] = {
+    {"polygonToCells/hemisphere", setupHemisphere, runPolygonToCells, 10,
+     12000, 280000},
+    {"polygonToCells/transmeridianSliver", setupTransmeridianSliver,
+     runPolygonToCells, 10, 130000, 50000000},
+    {"polygonToCells/diagonalSliver", setupDiagonalSliver, runPolygonToCells,
+     10, 280000, 145000000},
+    {"polygonToCells/sawtooth", setupSawtooth, runPolygonToCells, 10, 280000,
+     810000},
+    {"polygonToCells/manyHoles", setupManyHoles, runPolygonToCells, 10,
+     140000, 2300000},
+    {"polygonToCells/polar", setupPolar, runPolygonToCells, 10, 100, 4096},
+    {"polygonToCells/degenerate", setupDegenerate, runPolygonToCells, 10, 100,
+     4096},
+    {"gridDiskDistances/pentagon", setupPentagonDisk, runGridDiskDistances, 10,
+     130000, 115000},
+    {"gridDiskDistances/wholeGrid", setupWholeGridDisk, runGridDiskDistances,
+     10, 1500, 42000},
+    {"gridDiskDistances/reachingPentagon", setupDiskReachingPentagon,
+     runGridDiskDistances, 10, 1000000, 455000},
+    {"compactCells/fullChildren", setupFullChildren, runCompactCells, 10,
+     12000, 3730000},
+    {"compactCells/almostFullChildren", setupAlmostFullChildren,
+     runCompactCells, 10, 17000, 3730000},
+    {"compactCells/pentagonChildren", setupPentagonChildren, runCompactCells,
+     10, 180000, 21800000},
+    {"uncompactCells/baseCells", setupBaseCells, runUncompactCells, 10, 56000,
+     20200000}};
+
+/** Prints the hot path counters of one run of an input */
+static void noteHotPathCounters(const HotPathCounters *counters) {
+    benchmarkNote(
+        "\t   polygonToCells: %lld probes, %lld point tests, %lld rounds\n",
+        (long long)counters->polygonToCellsProbes,
+        (long long)counters->polygonToCellsPointTests,
+        (long long)counters->polygonToCellsRounds);
+    benchmarkNote(
+        "\t   gridDisk: %lld fallbacks, %lld safe visits, %lld safe probes\n",
+        (long long)counters->gridDiskFallbacks,
+        (long long)counters->gridDiskSafeVisits,
+        (long long)counters->gridDiskSafeProbes);
+    benchmarkNote("\t   neighbors: %lld calls, %lld rotations, %lld pentagon "
+                  "adjustments\n",
+                  (long long)counters->neighborCalls,
+                  (long long)counters->neighborRotations,
+                  (long long)counters->neighborPentagonAdjustments);
+    benchmarkNote("\t   compactCells: %lld probes, %lld rounds\n",
+                  (long long)counters->compactCellsProbes,
+                  (long long)counters->compactCellsRounds);
+}
+
+/** Reference operation, which time budgets are measured in */
+static void reference(void) {
+    static const LatLng point = {0.659966917655, -2.1364398519396};
+    H3Index cell;
+    H3_EXPORT(latLngToCell)(&point, 9, &cell);
+    DO_NOT_OPTIMIZE(cell);
+}
+
+BEGIN_BENCHMARKS();
+
+BENCHMARK(reference, 100000, { reference(); });
+double referenceTime = benchmarkLastStats()->median;
+
+int numCases = sizeof(CORPUS) / sizeof(CORPUS[0]);
+for (int c = 0; c < numCases; c++) {
+    const WorstCase *input = &CORPUS[c];
+    polygon = (GeoPolygon){0};
+    input->setup();
+
+    // Peak memory of one call, and its hot path counters if the library
+    // keeps them
+    AllocationStats stats;
+    HotPathCounters counters;
+    bool hasCounters = H3_EXPORT(resetHotPathCounters)() == E_SUCCESS;
+    H3_EXPORT(resetAllocationStats)();
+    H3_EXPORT(getAllocationStats)(&stats);
+    int64_t startBytes = stats.liveBytes;
+    outputBytes = 0;
+    input->run();
+    H3_EXPORT(getAllocationStats)(&stats);
+    int64_t bytes = stats.peakBytes - startBytes + outputBytes;
+    H3_EXPORT(getHotPathCounters)(&counters);
+
+    BENCHMARK_NAMED(input->name, input->iterations, { input->run(); });
+    double time = benchmarkLastStats()->median / referenceTime;
+
+    benchmarkNote("\t   %.0f reference operations (budget %.0f), ", time,
+                  input->maxTime);
+    benchmarkNote("%lld bytes peak memory (budget %lld)\n", (long long)bytes,
+                  (long long)input->maxBytes);
+    if (hasCounters) {
+        noteHotPathCounters(&counters);
+    }
+    if (time > input->maxTime) {
+        benchmarkFail("%s took %.0f reference operations, over its budget "
+                      "of %.0f",
+                      input->name, time, input->maxTime);
+    }
+    if (bytes > input->maxBytes) {
+        benchmarkFail("%s used %lld bytes, over its budget of %lld",
+                      input->name, (long long)bytes,
+                      (long long)input->maxBytes);
+    }
+}
+free(cells);
+
+END_BENCHMARKS();
@@ -0,0 +1,255 @@
+/*
+ * Copyright 2023 Uber Technologies, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/** @file
+ * @brief Compares two files of CSV benchmark results
+ *
+ *  See `compareBenchmarks --help` for usage.
+ *
+ *  Reads the results of the same benchmarks from a baseline and a contender
+ *  file, written by running benchmarks with `--format csv`, and prints the
+ *  change in mean time per iteration of each benchmark found in both.
+ *
+ *  A change is significant if Welch's t-test on the samples of the two runs
+ *  rejects equal means at the given significance level, and the means
+ *  differ by more than the given threshold. The program exits with status 1
+ *  if any benchmark is significantly slower in the contender.
+ *
+ *  Examples:
+ *
+ *     `benchmarkH3Api --format csv --output base.csv`
+ *     `benchmarkH3Api --format csv --output new.csv`
+ *     `compareBenchmarks --baseline base.csv --contender new.csv`
+ */
+
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "args.h"
+#include "utility.h"
+
+/** Maximum length of suite and benchmark names */
+#define MAX_NAME_SIZE 128
+
+/** Maximum number of continued fraction terms for the incomplete beta */
+#define MAX_BETA_TERMS 200
+
+/** Summary of the samples of one benchmark */
+typedef struct {
+    char suite[MAX_NAME_SIZE];
+    char name[MAX_NAME_SIZE];
+    int samples;
+    double mean;
+    double stddev;
+} Result;
+
+/**
+ * Reads the results of a CSV file. Header rows are skipped, and a result
+ * repeated later in the file replaces the earlier one.
+ */
+static Result *readResults(const char *path, int *numResults) {
+    FILE *file = fopen(path, "r");
+    if (!file) error("opening results file");
+
+    int capacity = 64;
+    Result *results = calloc(capacity, sizeof(Result));
+    if (!results) error("allocating results");
+    *numResults = 0;
+
+    char line[BUFF_SIZE * 4];
+    while (fgets(line, sizeof(line), file)) {
+        Result result;
+        long long iterations;
+        double min, median, p90, p99;
+        if (sscanf(line, "%127[^,],%127[^,],%lld,%d,%lf,%lf,%lf,%lf,%lf,%lf",
+                   result.suite, result.name, &iterations, &result.samples,
+                   &min, &median, &p90, &p99, &result.mean,
+                   &result.stddev) != 10) {
+            // Header rows and anything else that is not a result
+            continue;
+        }
+        int i = 0;
+        while (i < *numResults && (strcmp(results[i].suite, result.suite) ||
+                                   strcmp(results[i].name, result.name))) {
+            i++;
+        }
+        if (i == *numResults) {
+            if (*numResults == capacity) {
+                capacity *= 2;
+                Result *grown = realloc(results, capacity * sizeof(Result));
+                if (!grown) error("allocating results");
+                results = grown;
+            }
+            (*numResults)++;
+        }
+        results[i] = result;
+    }
+    fclose(file);
+    return results;
+}
+
+/**
+ * Continued fraction of the regularized incomplete beta function, by the
+ * modified Lentz method.
+ */
+static double betaContinuedFraction(double a, double b, double x) {
+    const double tiny = 1e-300;
+    double c = 1;
+    double d = 1 - (a + b) * x / (a + 1);
+    if (fabs(d) < tiny) d = tiny;
+    d = 1 / d;
+    double f = d;
+    for (int m = 1; m <= MAX_BETA_TERMS; m++) {
+        // Even step
+        double numerator = m * (b - m) * x / ((a + 2 * m - 1) * (a + 2 * m));
+        d = 1 + numerator * d;
+        if (fabs(d) < tiny) d = tiny;
+        c = 1 + numerator / c;
+        if (fabs(c) < tiny) c = tiny;
+        d = 1 / d;
+        f *= d * c;
+        // Odd step
+        numerator =
+            -(a + m) * (a + b + m) * x / ((a + 2 * m) * (a + 2 * m + 1));
+        d = 1 + numerator * d;
+        if (fabs(d) < tiny) d = tiny;
+        c = 1 + numerator / c;
+        if (fabs(c) < tiny) c = tiny;
+        d = 1 / d;
+        double delta = d * c;
+        f *= delta;
+        if (fabs(delta - 1) < 1e-12) break;
+    }
+    return f;
+}
+
+/**
+ * Regularized incomplete beta function I_x(a, b).
+ */
+static double incompleteBeta(double a, double b, double x) {
+    if (x <= 0) return 0;
+    if (x >= 1) return 1;
+    double front = exp(lgamma(a + b) - lgamma(a) - lgamma(b) + a * log(x) +
+                       b * log(1 - x));
+    // The continued fraction converges quickly on this side
+    if (x < (a + 1) / (a + b + 2)) {
+        return front * betaContinuedFraction(a, b, x) / a;
+    }
+    return 1 - front * betaContinuedFraction(b, a, 1 - x) / b;
+}
+
+/**
+ * Two sided p-value of Welch's t-test that two results have equal means.
+ */
+static double welchPValue(const Result *a, const Result *b) {
+    double varA = a->stddev * a->stddev / a->samples;
+    double varB = b->stddev * b->stddev / b->samples;
+    if (varA + varB == 0) {
+        return a->mean == b->mean ? 1 : 0;
+    }
+    double t = (b->mean - a->mean) / sqrt(varA + varB);
+    double df = (varA + varB) * (varA + varB) /
+                ((a->samples > 1 ? varA * varA / (a->samples - 1) : 0) +
+                 (b->samples > 1 ? varB * varB / (b->samples - 1) : 0));
+    if (!isfinite(df)) {
+        // A single sample has no variance to test against
+        return 1;
+    }
+    return incompleteBeta(df / 2, 0.5, df / (df + t * t));
+}
+
+int main(int argc, char *argv[]) {
+    char baselinePath[BUFF_SIZE] = {0};
+    char contenderPath[BUFF_SIZE] = {0};
+    double threshold = 5;
+    double alpha = 0.01;
+
+    Arg helpArg = ARG_HELP;
+    Arg baselineArg = {.names = {"-b", "--baseline"},
+                       .required = true,
+                       .scanFormat = "%255s",
+                       .valueName = "file",
+                       .value = &baselinePath,
+                       .helpText = "CSV results of the baseline."};
+    Arg contenderArg = {.names = {"-c", "--contender"},
+                        .required = true,
+                        .scanFormat = "%255s",
+                        .valueName = "file",
+                        .value = &contenderPath,
+                        .helpText = "CSV results to compare to the baseline."};
+    Arg thresholdArg = {
+        .names = {"-t", "--threshold"},
+        .scanFormat = "%lf",
+        .valueName = "percent",
+        .value = &threshold,
+        .helpText = "Smallest change in mean that is reported as significant, "
+                    "default 5."};
+    Arg alphaArg = {.names = {"-a", "--alpha"},
+                    .scanFormat = "%lf",
+                    .valueName = "level",
+                    .value = &alpha,
+                    .helpText = "Significance level, default 0.01."};
+
+    Arg *args[] = {&helpArg, &baselineArg, &contenderArg, &thresholdArg,
+                   &alphaArg};
+    if (parseArgs(argc, argv, 5, args, &helpArg,
+                  "Compares two files of CSV benchmark results, and exits "
+                  "with status 1 if any benchmark is significantly slower.")) {
+        return helpArg.found ? 0 : 1;
+    }
+
+    int numBaseline;
+    int numContender;
+    Result *baseline = readResults(baselinePath, &numBaseline);
+    Result *contender = readResults(contenderPath, &numContender);
+
+    int numRegressions = 0;
+    printf("%-40s %12s %12s %9s %9s\n", "benchmark", "baseline us",
+           "contender us", "change", "p-value");
+    for (int i = 0; i < numContender; i++) {
+        const Result *b = &contender[i];
+        const Result *a = NULL;
+        for (int j = 0; j < numBaseline && !a; j++) {
+            if (!strcmp(baseline[j].suite, b->suite) &&
+                !strcmp(baseline[j].name, b->name)) {
+                a = &baseline[j];
+            }
+        }
+        if (!a) {
+            continue;
+        }
+        double change = a->mean > 0 ? 100 * (b->mean - a->mean) / a->mean : 0;
+        double p = welchPValue(a, b);
+        bool significant = p < alpha && fabs(change) > threshold;
+        const char *verdict = "";
+        if (significant && change > 0) {
+            verdict = "SLOWER";
+            numRegressions++;
+        } else if (significant) {
+            verdict = "faster";
+        }
+
+        char fullName[2 * MAX_NAME_SIZE];
+        snprintf(fullName, sizeof(fullName), "%s.%s", b->suite, b->name);
+        printf("%-40s %12.4f %12.4f %+8.1f%% %9.4f %s\n", fullName, a->mean,
+               b->mean, change, p, verdict);
+    }
+    printf("%d significant regressions\n", numRegressions);
+
+    free(contender);
+    free(baseline);
+    return numRegressions > 0;
+}
@@ -0,0 +1,155 @@
+/*
+ * Copyright 2023 Uber Technologies, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/** @file
+ * @brief stdin/stdout filter that converts between text H3 indexes and the
+ * binary cell set encoding
+ *
+ *  See `encodeCellSet --help` for usage.
+ *
+ *  By default, the program reads H3 indexes, one per line, from stdin until
+ *  EOF and writes the binary encoding of the set of them to stdout. The
+ *  indexes may be in any order and may repeat.
+ *
+ *  `--decode` reads a binary encoding from stdin instead, and prints its
+ *  indexes to stdout one per line, in sorted order.
+ *
+ *  Examples:
+ *
+ *     `encodeCellSet < indexes.txt > indexes.h3cs`
+ *        - encodes the H3 indexes contained in the file `indexes.txt`
+ *
+ *     `encodeCellSet --decode < indexes.h3cs`
+ *        - prints the H3 indexes contained in the file `indexes.h3cs`
+ */
+
+#include <inttypes.h>
+#include <stdint.h>
+#include <stdlib.h>
+
+#include "args.h"
+#include "h3api.h"
+#include "utility.h"
+
+/**
+ * Reads indexes from stdin and writes the encoding of them to stdout.
+ */
+void doEncode(void) {
+    int64_t capacity = 1024;
+    int64_t numCells = 0;
+    H3Index *cells = malloc(capacity * sizeof(H3Index));
+    if (!cells) error("allocating indexes");
+
+    char buff[BUFF_SIZE];
+    while (fgets(buff, BUFF_SIZE, stdin)) {
+        H3Index h;
+        if (H3_EXPORT(stringToH3)(buff, &h) || h == H3_NULL) {
+            continue;
+        }
+        if (numCells == capacity) {
+            capacity *= 2;
+            H3Index *grown = realloc(cells, capacity * sizeof(H3Index));
+            if (!grown) error("allocating indexes");
+            cells = grown;
+        }
+        cells[numCells++] = h;
+    }
+    if (!feof(stdin)) error("reading H3 index from stdin");
+
+    int64_t numUnique;
+    if (H3_EXPORT(sortCells)(cells, numCells) ||
+        H3_EXPORT(dedupSortedCells)(cells, numCells, &numUnique)) {
+        error("sorting indexes");
+    }
+
+    int64_t size;
+    if (H3_EXPORT(encodeCellSetSize)(cells, numUnique, &size)) {
+        error("sizing encoding");
+    }
+    uint8_t *data = malloc(size);
+    if (!data) error("allocating encoding");
+    if (H3_EXPORT(encodeCellSet)(cells, numUnique, data, size)) {
+        error("encoding indexes");
+    }
+    if (fwrite(data, 1, size, stdout) != (size_t)size) {
+        error("writing encoding to stdout");
+    }
+
+    free(data);
+    free(cells);
+}
+
+/**
+ * Reads an encoding from stdin and prints its indexes to stdout.
+ */
+void doDecode(void) {
+    int64_t capacity = 1 << 16;
+    int64_t size = 0;
+    uint8_t *data = malloc(capacity);
+    if (!data) error("allocating encoding");
+    while (1) {
+        size += fread(data + size, 1, capacity - size, stdin);
+        if (size < capacity) {
+            break;
+        }
+        capacity *= 2;
+        uint8_t *grown = realloc(data, capacity);
+        if (!grown) error("allocating encoding");
+        data = grown;
+    }
+    if (ferror(stdin)) error("reading encoding from stdin");
+
+    int64_t numCells;
+    if (H3_EXPORT(decodeCellSetSize)(data, size, &numCells)) {
+        error("reading encoding header");
+    }
+    if (numCells > INT64_MAX / (int64_t)sizeof(H3Index) ||
+        (uint64_t)numCells * sizeof(H3Index) > SIZE_MAX) {
+        error("encoding has too many indexes");
+    }
+    H3Index *cells = malloc((numCells > 0 ? numCells : 1) * sizeof(H3Index));
+    if (!cells) error("allocating indexes");
+    if (H3_EXPORT(decodeCellSet)(data, size, cells, numCells)) {
+        error("decoding indexes");
+    }
+    for (int64_t i = 0; i < numCells; i++) {
+        h3Println(cells[i]);
+    }
+
+    free(cells);
+    free(data);
+}
+
+int main(int argc, char *argv[]) {
+    Arg helpArg = ARG_HELP;
+    Arg decodeArg = {.names = {"-d", "--decode"},
+                     .helpText =
+                         "Decode a binary encoding from standard input "
+                         "instead of encoding indexes."};
+
+    Arg *args[] = {&helpArg, &decodeArg};
+
+    if (parseArgs(argc, argv, 2, args, &helpArg,
+                  "Converts between indexes and the binary cell set "
+                  "encoding")) {
+        return helpArg.found ? 0 : 1;
+    }
+
+    if (decodeArg.found) {
+        doDecode();
+    } else {
+        doEncode();
+    }
+}
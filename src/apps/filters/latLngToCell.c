@@ -30,12 +30,40 @@
  *       lat1 lng1
  *       ...
  *       latN lngN
+ *
+ *  Input is read and output written in large blocks, and points are
+ *  converted in chunks with `latLngsToCells`.
+ *
+ *  `--binary-input` reads pairs of doubles (lat, lng in decimal degrees) in
+ *  native byte order instead of text, and `--binary-output` writes each index
+ *  as a uint64 in native byte order instead of text.
  */
 
+#include <stdlib.h>
+#include <string.h>
+
 #include "args.h"
 #include "h3Index.h"
 #include "utility.h"
 
+/** Size of the blocks read from stdin */
+#define READ_BLOCK_SIZE (1 << 20)
+
+/** Size of the output buffer */
+#define WRITE_BLOCK_SIZE (1 << 20)
+
+/** Number of points converted together */
+#define CHUNK_SIZE 4096
+
+/** Longest line that is read as one line, as with fgets */
+#define MAX_LINE_SIZE (BUFF_SIZE - 1)
+
+/** Powers of ten that are exactly representable as doubles */
+static const double POW10[] = {1e0,  1e1,  1e2,  1e3,  1e4,  1e5,
+                               1e6,  1e7,  1e8,  1e9,  1e10, 1e11,
+                               1e12, 1e13, 1e14, 1e15, 1e16, 1e17,
+                               1e18, 1e19, 1e20, 1e21, 1e22};
+
 /**
  * Convert coordinates to cell and print it.
  *
@@ -57,6 +85,184 @@ void doCoords(double lat, double lng, int res) {
     }
 }
 
+/**
+ * Parses a plain decimal number ([sign]digits[.digits]) exactly as strtod
+ * would. Numbers with more significant digits than a double holds exactly,
+ * exponents, and other forms are not parsed, and are left to the caller.
+ *
+ * @return The character after the number, or NULL if not parsed
+ */
+static const char *parseSimpleDouble(const char *p, double *out) {
+    bool negative = *p == '-';
+    if (*p == '-' || *p == '+') {
+        p++;
+    }
+    uint64_t mantissa = 0;
+    int numDigits = 0;
+    int fractionDigits = 0;
+    for (; *p >= '0' && *p <= '9'; p++, numDigits++) {
+        mantissa = mantissa * 10 + (uint64_t)(*p - '0');
+        if (numDigits >= 19) return NULL;
+    }
+    if (*p == '.') {
+        p++;
+        for (; *p >= '0' && *p <= '9'; p++, numDigits++, fractionDigits++) {
+            mantissa = mantissa * 10 + (uint64_t)(*p - '0');
+            if (numDigits >= 19) return NULL;
+        }
+    }
+    // Exactly representable operands give a correctly rounded quotient
+    if (numDigits == 0 || mantissa > (UINT64_C(1) << 53) ||
+        fractionDigits > 22 || *p == 'e' || *p == 'E' || *p == 'x' ||
+        *p == 'X') {
+        return NULL;
+    }
+    double value = (double)mantissa / POW10[fractionDigits];
+    *out = negative ? -value : value;
+    return p;
+}
+
+/**
+ * Parses a line of input, as sscanf(line, "%lf %lf", ...) would.
+ *
+ * @return true if both coordinates were parsed
+ */
+static bool parseLine(const char *line, LatLng *point) {
+    const char *p = line;
+    while (*p == ' ' || *p == '\t') p++;
+    p = parseSimpleDouble(p, &point->lat);
+    if (p) {
+        while (*p == ' ' || *p == '\t') p++;
+        p = parseSimpleDouble(p, &point->lng);
+    }
+    if (!p) {
+        // Fall back for anything the simple parser does not handle
+        if (sscanf(line, "%lf %lf", &point->lat, &point->lng) != 2) {
+            return false;
+        }
+    }
+    point->lat = H3_EXPORT(degsToRads)(point->lat);
+    point->lng = H3_EXPORT(degsToRads)(point->lng);
+    return true;
+}
+
+/** Buffered output of cells */
+typedef struct {
+    char *buffer;
+    size_t size;
+    bool binary;
+} Output;
+
+static void flushOutput(Output *output) {
+    if (output->size > 0 &&
+        fwrite(output->buffer, 1, output->size, stdout) != output->size) {
+        error("writing output");
+    }
+    output->size = 0;
+}
+
+/**
+ * Converts a chunk of points and adds the cells to the output. Points that
+ * cannot be converted are output as H3_NULL.
+ */
+static void convertChunk(const LatLng *points, int numPoints, int res,
+                         Output *output) {
+    H3Index cells[CHUNK_SIZE];
+    H3Error err = H3_EXPORT(latLngsToCells)(points, numPoints, res, cells);
+    if (err == E_RES_DOMAIN) {
+        memset(cells, 0, numPoints * sizeof(H3Index));
+    }
+    for (int i = 0; i < numPoints; i++) {
+        if (output->size + 17 > WRITE_BLOCK_SIZE) {
+            flushOutput(output);
+        }
+        if (output->binary) {
+            memcpy(output->buffer + output->size, &cells[i], sizeof(H3Index));
+            output->size += sizeof(H3Index);
+        } else {
+            char *str = output->buffer + output->size;
+            H3_EXPORT(h3ToString)(cells[i], str, 17);
+            size_t length = strlen(str);
+            str[length] = '\n';
+            output->size += length + 1;
+        }
+    }
+}
+
+/**
+ * Reads pairs of doubles from stdin, converting them in chunks.
+ */
+static void doBinaryInput(int res, Output *output) {
+    double coords[2 * CHUNK_SIZE];
+    LatLng points[CHUNK_SIZE];
+    size_t numRead;
+    while ((numRead = fread(coords, 2 * sizeof(double), CHUNK_SIZE, stdin)) >
+           0) {
+        for (size_t i = 0; i < numRead; i++) {
+            points[i].lat = H3_EXPORT(degsToRads)(coords[2 * i]);
+            points[i].lng = H3_EXPORT(degsToRads)(coords[2 * i + 1]);
+        }
+        convertChunk(points, (int)numRead, res, output);
+    }
+    if (ferror(stdin)) error("reading lat/lng");
+}
+
+/**
+ * Reads lines of text from stdin in large blocks, converting them in
+ * chunks.
+ */
+static void doTextInput(int res, Output *output) {
+    // Room for a partial line carried over from the previous block, and
+    // a terminator
+    char *block = malloc(MAX_LINE_SIZE + READ_BLOCK_SIZE + 1);
+    if (!block) error("allocating input buffer");
+    LatLng points[CHUNK_SIZE];
+    int numPoints = 0;
+    size_t carried = 0;
+    while (1) {
+        size_t numRead = fread(block + carried, 1, READ_BLOCK_SIZE, stdin);
+        if (numRead == 0 && ferror(stdin)) error("reading lat/lng");
+        bool atEnd = numRead == 0;
+        size_t size = carried + numRead;
+        if (atEnd && size == 0) break;
+
+        char *line = block;
+        char *end = block + size;
+        while (line < end) {
+            char *newline = memchr(line, '\n', end - line);
+            if (!newline && !atEnd) {
+                // Wait for the rest of the line, unless it is already too
+                // long to be read as one line
+                if (end - line < MAX_LINE_SIZE) break;
+            }
+            char *lineEnd = newline ? newline + 1 : end;
+            if (lineEnd - line > MAX_LINE_SIZE) {
+                lineEnd = line + MAX_LINE_SIZE;
+            }
+            // Parse the line as its own string
+            char saved = *lineEnd;
+            *lineEnd = '\0';
+            bool parsed = parseLine(line, &points[numPoints]);
+            *lineEnd = saved;
+            if (!parsed) {
+                convertChunk(points, numPoints, res, output);
+                flushOutput(output);
+                error("parsing lat/lng");
+            }
+            if (++numPoints == CHUNK_SIZE) {
+                convertChunk(points, numPoints, res, output);
+                numPoints = 0;
+            }
+            line = lineEnd;
+        }
+        carried = end - line;
+        memmove(block, line, carried);
+        if (atEnd) break;
+    }
+    convertChunk(points, numPoints, res, output);
+    free(block);
+}
+
 int main(int argc, char *argv[]) {
     int res = 0;
     double lat = 0;
@@ -82,8 +288,18 @@ int main(int argc, char *argv[]) {
                   .value = &lng,
                   .helpText = "Longitude in degrees."};
 
-    Arg *args[] = {&helpArg, &resArg, &latArg, &lngArg};
-    const int numArgs = 4;
+    Arg binaryInputArg = {
+        .names = {"--bi", "--binary-input"},
+        .helpText = "Read pairs of doubles in native byte order from "
+                    "standard input instead of text."};
+    Arg binaryOutputArg = {
+        .names = {"--bo", "--binary-output"},
+        .helpText =
+            "Write indexes as uint64 in native byte order instead of text."};
+
+    Arg *args[] = {&helpArg, &resArg,         &latArg,
+                   &lngArg,  &binaryInputArg, &binaryOutputArg};
+    const int numArgs = 6;
     const char *helpText =
         "Convert degrees latitude/longitude coordinates to H3 indexes.";
 
@@ -102,21 +318,15 @@ int main(int argc, char *argv[]) {
         doCoords(lat, lng, res);
     } else {
         // process the lat/lng's on stdin
-        char buff[BUFF_SIZE];
-        while (1) {
-            // get a lat/lng from stdin
-            if (!fgets(buff, BUFF_SIZE, stdin)) {
-                if (feof(stdin))
-                    break;
-                else
-                    error("reading lat/lng");
-            }
-
-            if (sscanf(buff, "%lf %lf", &lat, &lng) != 2)
-                error("parsing lat/lng");
-
-            // convert to H3
-            doCoords(lat, lng, res);
+        Output output = {.buffer = malloc(WRITE_BLOCK_SIZE),
+                         .binary = binaryOutputArg.found};
+        if (!output.buffer) error("allocating output buffer");
+        if (binaryInputArg.found) {
+            doBinaryInput(res, &output);
+        } else {
+            doTextInput(res, &output);
         }
+        flushOutput(&output);
+        free(output.buffer);
     }
 }
@@ -0,0 +1,168 @@
+/*
+ * Copyright 2023 Uber Technologies, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/** @file
+ * @brief tests the allocation counts of a library built with
+ * H3_ALLOCATION_STATS, which passes allocations on to the allocators here.
+ *
+ *  usage: `testAllocationStats`
+ */
+
+#include <stdlib.h>
+
+#include "h3api.h"
+#include "test.h"
+#include "utility.h"
+
+// Whether to fail all allocations
+static bool failAlloc = false;
+// Bytes requested of the allocators here, including headers
+static int64_t requestedBytes = 0;
+
+void *test_prefix_malloc(size_t size) {
+    if (failAlloc) {
+        return NULL;
+    }
+    requestedBytes += size;
+    return malloc(size);
+}
+
+void *test_prefix_calloc(size_t num, size_t size) {
+    if (failAlloc) {
+        return NULL;
+    }
+    requestedBytes += num * size;
+    return calloc(num, size);
+}
+
+void *test_prefix_realloc(void *ptr, size_t size) {
+    if (failAlloc) {
+        return NULL;
+    }
+    requestedBytes += size;
+    return realloc(ptr, size);
+}
+
+void test_prefix_free(void *ptr) { free(ptr); }
+
+H3Index sunnyvale = 0x89283470c27ffff;
+H3Index pentagon = 0x89080000003ffff;
+
+static LatLng sfVerts[] = {
+    {0.659966917655, -2.1364398519396},  {0.6595011102219, -2.1359434279405},
+    {0.6583348114025, -2.1354884206045}, {0.6581220034068, -2.1382437718946},
+    {0.6594479998527, -2.1384597563896}, {0.6599990002976, -2.1376771158464}};
+static GeoLoop sfGeoLoop = {.numVerts = 6, .verts = sfVerts};
+
+SUITE(allocationStats) {
+    TEST(reset) {
+        AllocationStats stats;
+        t_assertSuccess(H3_EXPORT(resetAllocationStats)());
+        t_assertSuccess(H3_EXPORT(getAllocationStats)(&stats));
+        t_assert(stats.allocations == 0, "no allocations after reset");
+        t_assert(stats.frees == 0, "no frees after reset");
+        t_assert(stats.allocatedBytes == 0, "no bytes after reset");
+        t_assert(stats.liveBytes == 0, "nothing is allocated between calls");
+        t_assert(stats.peakBytes == stats.liveBytes, "peak is reset to live");
+    }
+
+    TEST(noAllocations) {
+        int64_t size;
+        t_assertSuccess(H3_EXPORT(maxGridDiskSize)(2, &size));
+        H3Index *out = calloc(size, sizeof(H3Index));
+
+        AllocationStats stats;
+        t_assertSuccess(H3_EXPORT(resetAllocationStats)());
+        t_assertSuccess(H3_EXPORT(gridDisk)(sunnyvale, 2, out));
+        t_assertSuccess(H3_EXPORT(getAllocationStats)(&stats));
+        t_assert(stats.allocations == 0, "gridDisk did not allocate");
+        t_assert(stats.peakBytes == 0, "gridDisk has no peak memory");
+
+        free(out);
+    }
+
+    TEST(gridDiskPentagon) {
+        int k = 2;
+        int64_t size;
+        t_assertSuccess(H3_EXPORT(maxGridDiskSize)(k, &size));
+        H3Index *out = calloc(size, sizeof(H3Index));
+
+        AllocationStats stats;
+        requestedBytes = 0;
+        t_assertSuccess(H3_EXPORT(resetAllocationStats)());
+        t_assertSuccess(H3_EXPORT(gridDisk)(pentagon, k, out));
+        t_assertSuccess(H3_EXPORT(getAllocationStats)(&stats));
+        t_assert(stats.allocations == 1, "gridDisk allocated once");
+        t_assert(stats.frees == 1, "gridDisk freed once");
+        t_assert(stats.allocatedBytes == size * (int64_t)sizeof(int),
+                 "gridDisk allocated the distances of the disk");
+        t_assert(stats.liveBytes == 0, "gridDisk freed everything");
+        t_assert(stats.peakBytes == stats.allocatedBytes,
+                 "peak is the one allocation");
+        t_assert(requestedBytes > stats.allocatedBytes,
+                 "counted bytes do not include headers");
+
+        free(out);
+    }
+
+    TEST(polygonToCells) {
+        GeoPolygon polygon = {.geoloop = sfGeoLoop};
+        int64_t size;
+        t_assertSuccess(
+            H3_EXPORT(maxPolygonToCellsSize)(&polygon, 9, 0, &size));
+        H3Index *out = calloc(size, sizeof(H3Index));
+
+        AllocationStats stats;
+        t_assertSuccess(H3_EXPORT(resetAllocationStats)());
+        t_assertSuccess(H3_EXPORT(polygonToCells)(&polygon, 9, 0, out));
+        t_assertSuccess(H3_EXPORT(getAllocationStats)(&stats));
+        t_assert(stats.allocations > 0, "polygonToCells allocated");
+        t_assert(stats.frees == stats.allocations,
+                 "polygonToCells freed each allocation");
+        t_assert(stats.liveBytes == 0, "polygonToCells freed everything");
+        t_assert(stats.peakBytes > 0 && stats.peakBytes <= stats.allocatedBytes,
+                 "peak is at most the allocated bytes");
+
+        // Counts accumulate until the next reset
+        AllocationStats twice;
+        t_assertSuccess(H3_EXPORT(polygonToCells)(&polygon, 9, 0, out));
+        t_assertSuccess(H3_EXPORT(getAllocationStats)(&twice));
+        t_assert(twice.allocations == 2 * stats.allocations,
+                 "allocations accumulate");
+        t_assert(twice.allocatedBytes == 2 * stats.allocatedBytes,
+                 "bytes accumulate");
+        t_assert(twice.peakBytes == stats.peakBytes, "peak does not");
+
+        free(out);
+    }
+
+    TEST(failedAllocation) {
+        int64_t size;
+        t_assertSuccess(H3_EXPORT(maxGridDiskSize)(2, &size));
+        H3Index *out = calloc(size, sizeof(H3Index));
+
+        AllocationStats stats;
+        t_assertSuccess(H3_EXPORT(resetAllocationStats)());
+        failAlloc = true;
+        t_assert(H3_EXPORT(gridDisk)(pentagon, 2, out) == E_MEMORY_ALLOC,
+                 "gridDisk returns E_MEMORY_ALLOC");
+        failAlloc = false;
+        t_assertSuccess(H3_EXPORT(getAllocationStats)(&stats));
+        t_assert(stats.allocations == 0, "failed allocation is not counted");
+        t_assert(stats.liveBytes == 0, "nothing is live");
+
+        free(out);
+    }
+}
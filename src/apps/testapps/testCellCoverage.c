@@ -0,0 +1,164 @@
+/*
+ * Copyright 2023 Uber Technologies, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/** @file
+ * @brief tests H3 cell coverage functions
+ *
+ *  usage: `testCellCoverage`
+ */
+
+#include <stdlib.h>
+
+#include "h3Index.h"
+#include "h3api.h"
+#include "test.h"
+#include "utility.h"
+
+// random res 5 cell
+static const H3Index origin = 0x85283473fffffff;
+
+static bool inSet(const H3Index *set, int64_t numCells, H3Index cell) {
+    for (int64_t i = 0; i < numCells; i++) {
+        if (set[i] == cell) {
+            return true;
+        }
+    }
+    return false;
+}
+
+SUITE(cellCoverage) {
+    TEST(coverageContainsCell) {
+        int64_t diskSize;
+        t_assertSuccess(H3_EXPORT(maxGridDiskSize)(2, &diskSize));
+        H3Index *disk = calloc(diskSize, sizeof(H3Index));
+        t_assertSuccess(H3_EXPORT(gridDisk)(origin, 2, disk));
+        int64_t numBigDisk;
+        t_assertSuccess(H3_EXPORT(maxGridDiskSize)(4, &numBigDisk));
+        H3Index *bigDisk = calloc(numBigDisk, sizeof(H3Index));
+        t_assertSuccess(H3_EXPORT(gridDisk)(origin, 4, bigDisk));
+
+        CellCoverage coverage;
+        t_assertSuccess(
+            H3_EXPORT(createCellCoverage)(disk, diskSize, &coverage));
+
+        for (int64_t i = 0; i < numBigDisk; i++) {
+            bool expected = inSet(disk, diskSize, bigDisk[i]);
+            int contained;
+            t_assertSuccess(H3_EXPORT(coverageContainsCell)(
+                &coverage, bigDisk[i], &contained));
+            t_assert(contained == expected, "cell containment matches set");
+
+            // Descendants are covered exactly when the cell is
+            H3Index child;
+            t_assertSuccess(
+                H3_EXPORT(cellToCenterChild)(bigDisk[i], 9, &child));
+            t_assertSuccess(
+                H3_EXPORT(coverageContainsCell)(&coverage, child, &contained));
+            t_assert(contained == expected,
+                     "descendant containment matches set");
+        }
+
+        // The parent is only partly covered
+        H3Index parent;
+        t_assertSuccess(H3_EXPORT(cellToParent)(origin, 3, &parent));
+        int contained;
+        t_assertSuccess(
+            H3_EXPORT(coverageContainsCell)(&coverage, parent, &contained));
+        t_assert(!contained, "partly covered parent is not contained");
+
+        int *batch = calloc(numBigDisk, sizeof(int));
+        t_assertSuccess(H3_EXPORT(coverageContainsCells)(&coverage, bigDisk,
+                                                         numBigDisk, batch));
+        for (int64_t i = 0; i < numBigDisk; i++) {
+            t_assert(batch[i] == inSet(disk, diskSize, bigDisk[i]),
+                     "batch containment matches set");
+        }
+
+        H3_EXPORT(destroyCellCoverage)(&coverage);
+        free(batch);
+        free(bigDisk);
+        free(disk);
+    }
+
+    TEST(coverageContainsCell_mixedResolutions) {
+        // A cell with all of its children, and a child of a neighbor
+        H3Index cells[9];
+        t_assertSuccess(H3_EXPORT(cellToChildren)(origin, 6, cells));
+        cells[7] = origin;
+        H3Index neighbor = 0x85283477fffffff;
+        t_assertSuccess(H3_EXPORT(cellToCenterChild)(neighbor, 7, &cells[8]));
+
+        CellCoverage coverage;
+        t_assertSuccess(H3_EXPORT(createCellCoverage)(cells, 9, &coverage));
+        int contained;
+        t_assertSuccess(
+            H3_EXPORT(coverageContainsCell)(&coverage, origin, &contained));
+        t_assert(contained, "cell is contained");
+        t_assertSuccess(
+            H3_EXPORT(coverageContainsCell)(&coverage, cells[8], &contained));
+        t_assert(contained, "fine cell is contained");
+        t_assertSuccess(
+            H3_EXPORT(coverageContainsCell)(&coverage, neighbor, &contained));
+        t_assert(!contained, "coarser cell of the fine cell is not contained");
+        H3_EXPORT(destroyCellCoverage)(&coverage);
+    }
+
+    TEST(coverageContainsCell_allBaseCells) {
+        H3Index baseCells[NUM_BASE_CELLS];
+        t_assertSuccess(H3_EXPORT(getRes0Cells)(baseCells));
+        CellCoverage coverage;
+        t_assertSuccess(H3_EXPORT(createCellCoverage)(
+            baseCells, NUM_BASE_CELLS, &coverage));
+        t_assert(coverage.numRanges == 1, "one range covers the globe");
+        int contained;
+        t_assertSuccess(
+            H3_EXPORT(coverageContainsCell)(&coverage, origin, &contained));
+        t_assert(contained, "cell is contained");
+        H3_EXPORT(destroyCellCoverage)(&coverage);
+    }
+
+    TEST(coverageContainsCell_empty) {
+        CellCoverage coverage;
+        t_assertSuccess(H3_EXPORT(createCellCoverage)(NULL, 0, &coverage));
+        int contained;
+        t_assertSuccess(
+            H3_EXPORT(coverageContainsCell)(&coverage, origin, &contained));
+        t_assert(!contained, "empty coverage contains nothing");
+        H3_EXPORT(destroyCellCoverage)(&coverage);
+    }
+
+    TEST(coverage_errors) {
+        H3Index invalid = origin;
+        H3_SET_MODE(invalid, H3_DIRECTEDEDGE_MODE);
+        CellCoverage coverage;
+        t_assertSuccess(H3_EXPORT(createCellCoverage)(&origin, 1, &coverage));
+        int contained;
+        t_assert(H3_EXPORT(coverageContainsCell)(&coverage, invalid,
+                                                 &contained) == E_CELL_INVALID,
+                 "invalid cell fails");
+        H3Index cells[2] = {origin, invalid};
+        int batch[2];
+        t_assert(H3_EXPORT(coverageContainsCells)(&coverage, cells, 2,
+                                                  batch) == E_CELL_INVALID,
+                 "batch fails on invalid cell");
+        H3_EXPORT(destroyCellCoverage)(&coverage);
+
+        H3Index badBaseCell = origin;
+        H3_SET_BASE_CELL(badBaseCell, 122);
+        t_assert(H3_EXPORT(createCellCoverage)(&badBaseCell, 1, &coverage) ==
+                     E_CELL_INVALID,
+                 "invalid base cell fails");
+    }
+}
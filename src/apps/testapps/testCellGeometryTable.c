@@ -0,0 +1,141 @@
+/*
+ * Copyright 2023 Uber Technologies, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/** @file
+ * @brief tests H3 cell geometry table functions
+ *
+ *  usage: `testCellGeometryTable`
+ */
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "h3Index.h"
+#include "h3api.h"
+#include "iterators.h"
+#include "test.h"
+#include "utility.h"
+
+/**
+ * Asserts that the table gives the same center and boundary for h as the
+ * functions that compute them, including any error.
+ */
+static void assertSameGeometry(const CellGeometryTable *table, H3Index h) {
+    LatLng expectedCenter = {0};
+    LatLng center = {0};
+    H3Error expectedErr = H3_EXPORT(cellToLatLng)(h, &expectedCenter);
+    t_assert(H3_EXPORT(cellToLatLngWithTable)(table, h, &center) ==
+                 expectedErr,
+             "center error matches");
+    t_assert(memcmp(&center, &expectedCenter, sizeof(LatLng)) == 0,
+             "center matches");
+
+    CellBoundary expectedBoundary = {0};
+    CellBoundary boundary = {0};
+    expectedErr = H3_EXPORT(cellToBoundary)(h, &expectedBoundary);
+    t_assert(H3_EXPORT(cellToBoundaryWithTable)(table, h, &boundary) ==
+                 expectedErr,
+             "boundary error matches");
+    t_assert(boundary.numVerts == expectedBoundary.numVerts,
+             "number of vertexes matches");
+    t_assert(memcmp(boundary.verts, expectedBoundary.verts,
+                    boundary.numVerts * sizeof(LatLng)) == 0,
+             "vertexes match");
+}
+
+SUITE(cellGeometryTable) {
+    TEST(allCells) {
+        CellGeometryTable table;
+        t_assertSuccess(H3_EXPORT(createCellGeometryTable)(2, &table));
+        for (int res = 0; res <= 3; res++) {
+            for (IterCellsResolution iter = iterInitRes(res); iter.h;
+                 iterStepRes(&iter)) {
+                assertSameGeometry(&table, iter.h);
+            }
+        }
+        H3_EXPORT(destroyCellGeometryTable)(&table);
+        t_assert(table.centers == NULL && table.vertexOffsets == NULL &&
+                     table.verts == NULL,
+                 "destroy clears the table");
+    }
+
+    TEST(finerCells) {
+        CellGeometryTable table;
+        t_assertSuccess(H3_EXPORT(createCellGeometryTable)(0, &table));
+        for (int i = 0; i < 1000; i++) {
+            LatLng point;
+            randomGeo(&point);
+            for (int res = 0; res <= MAX_H3_RES; res++) {
+                H3Index h;
+                t_assertSuccess(H3_EXPORT(latLngToCell)(&point, res, &h));
+                assertSameGeometry(&table, h);
+            }
+        }
+        H3_EXPORT(destroyCellGeometryTable)(&table);
+    }
+
+    TEST(invalidCells) {
+        CellGeometryTable table;
+        t_assertSuccess(H3_EXPORT(createCellGeometryTable)(1, &table));
+        // Indexes with arbitrary digits, at resolutions in the table, are
+        // treated as the functions that compute their geometry treat them
+        for (int i = 0; i < 10000; i++) {
+            H3Index h = ((H3Index)rand() << 32) ^ ((H3Index)rand() << 16) ^
+                        (H3Index)rand();
+            H3_SET_MODE(h, H3_CELL_MODE);
+            H3_SET_RESOLUTION(h, i % 2);
+            H3_SET_BASE_CELL(h, i % NUM_BASE_CELLS);
+            assertSameGeometry(&table, h);
+        }
+        H3Index pentagonDeletedK = 0x8108fffffffffff;
+        H3_SET_INDEX_DIGIT(pentagonDeletedK, 1, K_AXES_DIGIT);
+        assertSameGeometry(&table, pentagonDeletedK);
+        H3_EXPORT(destroyCellGeometryTable)(&table);
+    }
+
+    TEST(numBytes) {
+        int64_t previous = 0;
+        for (int maxRes = 0; maxRes <= 2; maxRes++) {
+            CellGeometryTable table;
+            t_assertSuccess(
+                H3_EXPORT(createCellGeometryTable)(maxRes, &table));
+            int64_t maxSize;
+            t_assertSuccess(
+                H3_EXPORT(maxCellGeometryTableSize)(maxRes, &maxSize));
+            t_assert(table.numBytes > previous,
+                     "finer tables hold more memory");
+            t_assert(table.numBytes <= maxSize, "table is within maximum");
+            previous = table.numBytes;
+            H3_EXPORT(destroyCellGeometryTable)(&table);
+        }
+    }
+
+    TEST(invalidMaxRes) {
+        CellGeometryTable table;
+        int64_t size;
+        t_assert(H3_EXPORT(createCellGeometryTable)(-1, &table) ==
+                     E_RES_DOMAIN,
+                 "negative resolution");
+        t_assert(H3_EXPORT(createCellGeometryTable)(
+                     MAX_CELL_GEOMETRY_TABLE_RES + 1, &table) == E_RES_DOMAIN,
+                 "resolution too fine");
+        t_assert(H3_EXPORT(maxCellGeometryTableSize)(-1, &size) ==
+                     E_RES_DOMAIN,
+                 "negative resolution size");
+        t_assert(H3_EXPORT(maxCellGeometryTableSize)(
+                     MAX_CELL_GEOMETRY_TABLE_RES + 1, &size) == E_RES_DOMAIN,
+                 "resolution too fine size");
+    }
+}
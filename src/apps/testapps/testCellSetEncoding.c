@@ -0,0 +1,270 @@
+/*
+ * Copyright 2023 Uber Technologies, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/** @file
+ * @brief tests H3 functions `encodeCellSet`, `decodeCellSet`, and
+ * `encodedCellSetContains`
+ *
+ *  usage: `testCellSetEncoding`
+ */
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "h3api.h"
+#include "test.h"
+#include "utility.h"
+
+static int compareCells(const void *a, const void *b) {
+    H3Index cellA = *(const H3Index *)a;
+    H3Index cellB = *(const H3Index *)b;
+    return cellA < cellB ? -1 : cellA > cellB;
+}
+
+/** Sorted disk of cells, with H3_NULL entries removed */
+static H3Index *sortedDisk(H3Index origin, int k, int64_t *numCells) {
+    int64_t size;
+    t_assertSuccess(H3_EXPORT(maxGridDiskSize)(k, &size));
+    H3Index *cells = calloc(size, sizeof(H3Index));
+    t_assertSuccess(H3_EXPORT(gridDisk)(origin, k, cells));
+    int64_t n = 0;
+    for (int64_t i = 0; i < size; i++) {
+        if (cells[i]) {
+            cells[n++] = cells[i];
+        }
+    }
+    qsort(cells, n, sizeof(H3Index), compareCells);
+    *numCells = n;
+    return cells;
+}
+
+static uint8_t *encode(const H3Index *cells, int64_t numCells,
+                       int64_t *size) {
+    t_assertSuccess(H3_EXPORT(encodeCellSetSize)(cells, numCells, size));
+    uint8_t *data = calloc(*size, 1);
+    t_assertSuccess(H3_EXPORT(encodeCellSet)(cells, numCells, data, *size));
+    return data;
+}
+
+/** Writes a header, with the given fields, to a zeroed buffer */
+static void writeHeader(uint8_t *data, uint64_t numCells, uint64_t numBlocks,
+                        uint64_t size) {
+    uint64_t fields[3] = {numCells, numBlocks, size};
+    memcpy(data, "H3CS", 4);
+    data[4] = 1;
+    data[9] = 1;  // block size 256
+    for (int f = 0; f < 3; f++) {
+        for (int i = 0; i < 8; i++) {
+            data[16 + 8 * f + i] = (uint8_t)(fields[f] >> (8 * i));
+        }
+    }
+}
+
+static void roundTrip_assertions(const H3Index *cells, int64_t numCells) {
+    int64_t size;
+    uint8_t *data = encode(cells, numCells, &size);
+
+    int64_t numDecoded;
+    t_assertSuccess(H3_EXPORT(decodeCellSetSize)(data, size, &numDecoded));
+    t_assert(numDecoded == numCells, "decoded size matches");
+    H3Index *decoded = calloc(numDecoded + 1, sizeof(H3Index));
+    t_assertSuccess(
+        H3_EXPORT(decodeCellSet)(data, size, decoded, numDecoded));
+    for (int64_t i = 0; i < numCells; i++) {
+        t_assert(decoded[i] == cells[i], "decoded cell matches");
+    }
+
+    for (int64_t i = 0; i < numCells; i++) {
+        int contains;
+        t_assertSuccess(
+            H3_EXPORT(encodedCellSetContains)(data, size, cells[i], &contains));
+        t_assert(contains, "contains each cell");
+        // Neighboring index values are mostly not in the set
+        H3Index other = cells[i] + 1;
+        t_assertSuccess(
+            H3_EXPORT(encodedCellSetContains)(data, size, other, &contains));
+        t_assert(contains == (i + 1 < numCells && cells[i + 1] == other),
+                 "contains only cells of the set");
+    }
+
+    free(decoded);
+    free(data);
+}
+
+SUITE(cellSetEncoding) {
+    TEST(roundTrip) {
+        H3Index origin = 0x89283080ddbffff;
+        // Sizes around the block size
+        int sizes[] = {1, 255, 256, 257, 513};
+        int64_t numCells;
+        H3Index *cells = sortedDisk(origin, 20, &numCells);
+        for (size_t i = 0; i < sizeof(sizes) / sizeof(sizes[0]); i++) {
+            roundTrip_assertions(cells, sizes[i]);
+        }
+        roundTrip_assertions(cells, numCells);
+        free(cells);
+    }
+
+    TEST(roundTripMixedResolutions) {
+        H3Index cells[] = {0x8001fffffffffff, 0x8029fffffffffff,
+                           0x85283473fffffff, 0x89283080ddbffff,
+                           0x8f754e64992d6d8, 0x8ff3bae1a3622e5};
+        roundTrip_assertions(cells, 6);
+    }
+
+    TEST(empty) {
+        int64_t size;
+        uint8_t *data = encode(NULL, 0, &size);
+        int64_t numCells;
+        t_assertSuccess(H3_EXPORT(decodeCellSetSize)(data, size, &numCells));
+        t_assert(numCells == 0, "empty set decodes as empty");
+        int contains;
+        t_assertSuccess(H3_EXPORT(encodedCellSetContains)(
+            data, size, 0x85283473fffffff, &contains));
+        t_assert(!contains, "empty set contains nothing");
+        free(data);
+    }
+
+    TEST(skipsNull) {
+        H3Index cells[] = {0, 0x85283473fffffff, 0, 0x852834777ffffff, 0};
+        int64_t size;
+        uint8_t *data = encode(cells, 5, &size);
+        int64_t numCells;
+        t_assertSuccess(H3_EXPORT(decodeCellSetSize)(data, size, &numCells));
+        t_assert(numCells == 2, "H3_NULL skipped");
+        free(data);
+    }
+
+    TEST(smallerThanText) {
+        int64_t numCells;
+        H3Index *cells = sortedDisk(0x89283080ddbffff, 20, &numCells);
+        int64_t size;
+        t_assertSuccess(H3_EXPORT(encodeCellSetSize)(cells, numCells, &size));
+        // Each index is 15 hex digits and a newline as text
+        t_assert(size * 10 < numCells * 16, "encoding is compact");
+        free(cells);
+    }
+
+    TEST(unsortedInput) {
+        H3Index unsorted[] = {0x852834777ffffff, 0x85283473fffffff};
+        H3Index repeated[] = {0x85283473fffffff, 0x85283473fffffff};
+        int64_t size;
+        t_assert(H3_EXPORT(encodeCellSetSize)(unsorted, 2, &size) == E_DOMAIN,
+                 "unsorted input fails");
+        t_assert(H3_EXPORT(encodeCellSetSize)(repeated, 2, &size) ==
+                     E_DUPLICATE_INPUT,
+                 "repeated input fails");
+        uint8_t data[64];
+        t_assert(H3_EXPORT(encodeCellSet)(unsorted, 2, data, 64) == E_DOMAIN,
+                 "unsorted input fails to encode");
+    }
+
+    TEST(bounds) {
+        int64_t numCells;
+        H3Index *cells = sortedDisk(0x89283080ddbffff, 10, &numCells);
+        int64_t size;
+        uint8_t *data = encode(cells, numCells, &size);
+
+        t_assert(H3_EXPORT(encodeCellSet)(cells, numCells, data, size - 1) ==
+                     E_MEMORY_BOUNDS,
+                 "too small encoding fails");
+        int64_t decodedSize;
+        t_assert(H3_EXPORT(decodeCellSetSize)(data, size - 1, &decodedSize) ==
+                     E_MEMORY_BOUNDS,
+                 "truncated encoding fails");
+        t_assert(H3_EXPORT(decodeCellSetSize)(data, 8, &decodedSize) ==
+                     E_MEMORY_BOUNDS,
+                 "truncated header fails");
+        t_assert(H3_EXPORT(decodeCellSet)(data, size, cells, numCells - 1) ==
+                     E_MEMORY_BOUNDS,
+                 "too small output fails");
+
+        free(data);
+        free(cells);
+    }
+
+    TEST(corrupt) {
+        int64_t numCells;
+        H3Index *cells = sortedDisk(0x89283080ddbffff, 10, &numCells);
+        int64_t size;
+        uint8_t *data = encode(cells, numCells, &size);
+        int64_t decodedSize;
+        int contains;
+
+        data[0] = 'X';
+        t_assert(H3_EXPORT(decodeCellSetSize)(data, size, &decodedSize) ==
+                     E_FAILED,
+                 "bad magic fails");
+        data[0] = 'H';
+
+        // A zero delta at the end of the data, which would repeat a cell
+        uint8_t last = data[size - 1];
+        data[size - 1] = 0;
+        t_assert(H3_EXPORT(decodeCellSet)(data, size, cells, numCells) ==
+                     E_FAILED,
+                 "zero delta fails");
+        // An unterminated varint
+        data[size - 1] = 0x80;
+        t_assert(H3_EXPORT(decodeCellSet)(data, size, cells, numCells) ==
+                     E_FAILED,
+                 "unterminated varint fails");
+        t_assert(H3_EXPORT(encodedCellSetContains)(
+                     data, size, cells[numCells - 1], &contains) == E_FAILED,
+                 "unterminated varint fails search");
+        data[size - 1] = last;
+
+        // Block offset past the end of the data
+        memset(data + 48, 0xff, 8);
+        t_assert(H3_EXPORT(decodeCellSet)(data, size, cells, numCells) ==
+                     E_FAILED,
+                 "bad block offset fails");
+
+        free(data);
+        free(cells);
+    }
+
+    TEST(corruptHeader) {
+        uint8_t data[80] = {0};
+        H3Index out[1];
+        int64_t decodedSize;
+        int contains;
+
+        // A size smaller than the header, with a block index past the data
+        writeHeader(data, 1, 1, 0);
+        t_assert(H3_EXPORT(decodeCellSet)(data, 40, out, 1) == E_FAILED,
+                 "tiny size fails");
+        t_assert(H3_EXPORT(encodedCellSetContains)(data, 40, 0x1, &contains) ==
+                     E_FAILED,
+                 "tiny size fails search");
+
+        // A block index that does not fit in the data
+        memset(data, 0, sizeof(data));
+        writeHeader(data, (uint64_t)1 << 40, (uint64_t)1 << 32, sizeof(data));
+        t_assert(H3_EXPORT(decodeCellSetSize)(data, sizeof(data),
+                                              &decodedSize) == E_FAILED,
+                 "huge numBlocks fails");
+        writeHeader(data, UINT64_MAX, UINT64_MAX / 256 + 1, sizeof(data));
+        t_assert(H3_EXPORT(decodeCellSetSize)(data, sizeof(data),
+                                              &decodedSize) == E_FAILED,
+                 "overflowing numCells fails");
+
+        // More cells than the blocks have bytes for
+        memset(data, 0, sizeof(data));
+        writeHeader(data, 512, 2, sizeof(data));
+        t_assert(H3_EXPORT(decodeCellSetSize)(data, sizeof(data),
+                                              &decodedSize) == E_FAILED,
+                 "huge numCells fails");
+    }
+}
@@ -51,6 +51,20 @@ static void childPos_assertions(H3Index h3) {
             t_assert(cell == children[i], "cell matches expected");
         }
 
+        // Batch versions match
+        int64_t *positions = calloc(numChildren, sizeof(int64_t));
+        H3Index *cells = calloc(numChildren, sizeof(H3Index));
+        t_assertSuccess(H3_EXPORT(cellsToChildPos)(children, numChildren,
+                                                   parentRes, positions));
+        t_assertSuccess(H3_EXPORT(childPosToCells)(positions, numChildren, h3,
+                                                   childRes, cells));
+        for (int64_t i = 0; i < numChildren; i++) {
+            t_assert(positions[i] == i, "batch childPos matches");
+            t_assert(cells[i] == children[i], "batch cell matches");
+        }
+
+        free(cells);
+        free(positions);
         free(children);
     }
 }
@@ -140,4 +154,32 @@ SUITE(cellToChildPos) {
             H3_EXPORT(cellToChildPos)(child, 0, &childPos) == E_CELL_INVALID,
             "error matches expected for invalid cell");
     }
+
+    TEST(batch_errors) {
+        // random res 8 cell
+        H3Index parent = 0x88283080ddfffff;
+        H3Index invalid = parent;
+        H3_SET_INDEX_DIGIT(invalid, 6, INVALID_DIGIT);
+        H3Index children[2] = {parent, invalid};
+        int64_t positions[2] = {0, 49};
+        t_assert(H3_EXPORT(cellsToChildPos)(children, 2, 0, positions) ==
+                     E_CELL_INVALID,
+                 "batch childPos fails on invalid cell");
+        t_assert(H3_EXPORT(cellsToChildPos)(children, 2, 9, positions) ==
+                     E_RES_MISMATCH,
+                 "batch childPos fails on parent res finer than child");
+
+        positions[0] = 0;
+        positions[1] = 49;
+        H3Index cells[2];
+        t_assert(H3_EXPORT(childPosToCells)(positions, 2, parent, 10, cells) ==
+                     E_DOMAIN,
+                 "batch cells fails on childPos greater than max");
+        t_assert(H3_EXPORT(childPosToCells)(positions, 2, parent, 42, cells) ==
+                     E_RES_DOMAIN,
+                 "batch cells fails on invalid res");
+        t_assert(H3_EXPORT(childPosToCells)(positions, 2, parent, 7, cells) ==
+                     E_RES_MISMATCH,
+                 "batch cells fails on child res coarser than parent");
+    }
 }
@@ -0,0 +1,201 @@
+/*
+ * Copyright 2023 Uber Technologies, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/** @file
+ * @brief tests H3 functions `cellToChildrenRange` and `compactCellsToRanges`
+ *
+ *  usage: `testCellToChildrenRange`
+ */
+
+#include <stdlib.h>
+
+#include "h3Index.h"
+#include "h3api.h"
+#include "test.h"
+#include "utility.h"
+
+static int64_t rangeSize(const CellRange *range) {
+    int64_t minRank;
+    int64_t maxRank;
+    t_assertSuccess(H3_EXPORT(cellToRank)(range->min, &minRank));
+    t_assertSuccess(H3_EXPORT(cellToRank)(range->max, &maxRank));
+    return maxRank - minRank + 1;
+}
+
+static void childrenRange_assertions(H3Index h3) {
+    int parentRes = H3_GET_RESOLUTION(h3);
+    for (int childRes = parentRes; childRes <= parentRes + 3; childRes++) {
+        int64_t numChildren;
+        t_assertSuccess(
+            H3_EXPORT(cellToChildrenSize)(h3, childRes, &numChildren));
+        H3Index *children = calloc(numChildren, sizeof(H3Index));
+        t_assertSuccess(H3_EXPORT(cellToChildren)(h3, childRes, children));
+
+        CellRange range;
+        t_assertSuccess(H3_EXPORT(cellToChildrenRange)(h3, childRes, &range));
+        t_assert(range.min == children[0], "min is the first child");
+        t_assert(range.max == children[numChildren - 1],
+                 "max is the last child");
+        t_assert(rangeSize(&range) == numChildren,
+                 "range holds exactly the children");
+
+        free(children);
+    }
+}
+
+SUITE(cellToChildrenRange) {
+    TEST(childrenRange_correctness) {
+        iterateAllIndexesAtRes(0, childrenRange_assertions);
+        iterateAllIndexesAtRes(1, childrenRange_assertions);
+    }
+
+    TEST(childrenRange_errors) {
+        // random res 8 cell
+        H3Index h3 = 0x88283080ddfffff;
+        CellRange range;
+        t_assert(H3_EXPORT(cellToChildrenRange)(h3, 7, &range) == E_RES_DOMAIN,
+                 "coarser child res fails");
+        t_assert(
+            H3_EXPORT(cellToChildrenRange)(h3, 16, &range) == E_RES_DOMAIN,
+            "invalid child res fails");
+    }
+
+    TEST(compactCellsToRanges) {
+        H3Index origin = 0x85283473fffffff;
+        int64_t diskSize;
+        t_assertSuccess(H3_EXPORT(maxGridDiskSize)(4, &diskSize));
+        H3Index *disk = calloc(diskSize, sizeof(H3Index));
+        t_assertSuccess(H3_EXPORT(gridDisk)(origin, 4, disk));
+        // Fill in all the children of the origin's parent, so the set
+        // compacts
+        H3Index parent;
+        t_assertSuccess(H3_EXPORT(cellToParent)(origin, 4, &parent));
+        H3Index *cells = calloc(diskSize + 7, sizeof(H3Index));
+        int64_t numCells = 0;
+        for (int64_t i = 0; i < diskSize; i++) {
+            H3Index cellParent;
+            t_assertSuccess(H3_EXPORT(cellToParent)(disk[i], 4, &cellParent));
+            if (cellParent != parent) {
+                cells[numCells++] = disk[i];
+            }
+        }
+        t_assertSuccess(H3_EXPORT(cellToChildren)(parent, 5, &cells[numCells]));
+        numCells += 7;
+
+        H3Index *compacted = calloc(numCells, sizeof(H3Index));
+        t_assertSuccess(H3_EXPORT(compactCells)(cells, compacted, numCells));
+        int64_t numCompacted = 0;
+        for (int64_t i = 0; i < numCells; i++) {
+            if (compacted[i]) {
+                compacted[numCompacted++] = compacted[i];
+            }
+        }
+        t_assert(numCompacted < numCells, "set was compacted");
+
+        int res = 7;
+        int64_t expectedCells;
+        t_assertSuccess(H3_EXPORT(uncompactCellsSize)(compacted, numCompacted,
+                                                      res, &expectedCells));
+        CellRange *ranges = calloc(numCompacted, sizeof(CellRange));
+        int64_t numRanges;
+        t_assertSuccess(H3_EXPORT(compactCellsToRanges)(
+            compacted, numCompacted, res, ranges, &numRanges));
+        t_assert(numRanges > 0 && numRanges <= numCompacted,
+                 "ranges were produced");
+
+        int64_t totalCells = 0;
+        for (int64_t i = 0; i < numRanges; i++) {
+            totalCells += rangeSize(&ranges[i]);
+            if (i > 0) {
+                int64_t lastMax;
+                int64_t nextMin;
+                t_assertSuccess(
+                    H3_EXPORT(cellToRank)(ranges[i - 1].max, &lastMax));
+                t_assertSuccess(
+                    H3_EXPORT(cellToRank)(ranges[i].min, &nextMin));
+                t_assert(nextMin > lastMax + 1,
+                         "ranges are sorted and not adjacent");
+            }
+        }
+        t_assert(totalCells == expectedCells,
+                 "ranges cover the uncompacted set");
+
+        H3Index *uncompacted = calloc(expectedCells, sizeof(H3Index));
+        t_assertSuccess(H3_EXPORT(uncompactCells)(
+            compacted, numCompacted, uncompacted, expectedCells, res));
+        for (int64_t i = 0; i < expectedCells; i++) {
+            bool found = false;
+            for (int64_t j = 0; j < numRanges; j++) {
+                if (uncompacted[i] >= ranges[j].min &&
+                    uncompacted[i] <= ranges[j].max) {
+                    found = true;
+                }
+            }
+            t_assert(found, "uncompacted cell is in a range");
+        }
+
+        free(uncompacted);
+        free(ranges);
+        free(compacted);
+        free(cells);
+        free(disk);
+    }
+
+    TEST(compactCellsToRanges_allBaseCells) {
+        H3Index baseCells[NUM_BASE_CELLS + 1];
+        t_assertSuccess(H3_EXPORT(getRes0Cells)(baseCells));
+        // H3_NULL entries are skipped
+        baseCells[NUM_BASE_CELLS] = H3_NULL;
+        CellRange ranges[NUM_BASE_CELLS + 1];
+        int64_t numRanges;
+        t_assertSuccess(H3_EXPORT(compactCellsToRanges)(
+            baseCells, NUM_BASE_CELLS + 1, 2, ranges, &numRanges));
+        t_assert(numRanges == 1, "all base cells give one range");
+        int64_t numCells;
+        t_assertSuccess(H3_EXPORT(getNumCells)(2, &numCells));
+        t_assert(rangeSize(&ranges[0]) == numCells, "range covers all cells");
+    }
+
+    TEST(compactCellsToRanges_overlapping) {
+        // random res 8 cell and its parent
+        H3Index cells[2] = {0x88283080ddfffff, 0x87283080dffffff};
+        CellRange ranges[2];
+        int64_t numRanges;
+        t_assertSuccess(
+            H3_EXPORT(compactCellsToRanges)(cells, 2, 9, ranges, &numRanges));
+        t_assert(numRanges == 1, "overlapping ranges are merged");
+        CellRange parentRange;
+        t_assertSuccess(
+            H3_EXPORT(cellToChildrenRange)(cells[1], 9, &parentRange));
+        t_assert(ranges[0].min == parentRange.min &&
+                     ranges[0].max == parentRange.max,
+                 "merged range is the parent's range");
+    }
+
+    TEST(compactCellsToRanges_errors) {
+        H3Index cells[1] = {0x88283080ddfffff};
+        CellRange ranges[1];
+        int64_t numRanges;
+        t_assert(H3_EXPORT(compactCellsToRanges)(cells, 1, 7, ranges,
+                                                 &numRanges) == E_RES_MISMATCH,
+                 "cell finer than res fails");
+
+        H3Index reserved = 0x85283473fffffff;
+        H3_SET_RESERVED_BITS(reserved, 1);
+        t_assert(H3_EXPORT(compactCellsToRanges)(&reserved, 1, 7, ranges,
+                                                 &numRanges) == E_CELL_INVALID,
+                 "invalid cell fails");
+    }
+}
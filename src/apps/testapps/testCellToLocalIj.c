@@ -339,4 +339,104 @@ SUITE(h3ToLocalIj) {
         t_assert(H3_EXPORT(localIjToCell)(origin, &ij, 0, &out) == E_FAILED,
                  "Particular high magnitude J and I components fail (5)");
     }
+
+    TEST(localIjOrigin) {
+        H3Index origin = 0x8828308281fffff;
+        H3Index cells[3] = {origin, 0x882830828dfffff, 0x8928308280fffff};
+        LocalIjOrigin prepared;
+        t_assertSuccess(H3_EXPORT(prepareLocalIjOrigin)(origin, &prepared));
+
+        CoordIJ ij[3];
+        H3Error errors[3];
+        t_assertSuccess(H3_EXPORT(cellsToLocalIjFromOrigin)(
+            &prepared, cells, 3, 0, ij, errors));
+        t_assertSuccess(errors[0]);
+        t_assertSuccess(errors[1]);
+        t_assert(errors[2] == E_RES_MISMATCH, "resolution mismatch reported");
+        for (int i = 0; i < 2; i++) {
+            CoordIJ expected;
+            t_assertSuccess(
+                H3_EXPORT(cellToLocalIj)(origin, cells[i], 0, &expected));
+            t_assert(ij[i].i == expected.i && ij[i].j == expected.j,
+                     "batch coordinates match cellToLocalIj");
+        }
+        t_assert(H3_EXPORT(cellsToLocalIjFromOrigin)(&prepared, cells, 3, 0,
+                                                     ij, NULL) ==
+                     E_RES_MISMATCH,
+                 "first error returned without errors array");
+        t_assert(H3_EXPORT(cellsToLocalIjFromOrigin)(&prepared, cells, 3, 1,
+                                                     ij, errors) ==
+                     E_OPTION_INVALID,
+                 "invalid mode rejected");
+
+        int64_t distances[3];
+        t_assertSuccess(H3_EXPORT(gridDistancesFromOrigin)(&prepared, cells, 3,
+                                                           distances));
+        t_assert(distances[0] == 0, "distance to origin");
+        int64_t expectedDistance;
+        t_assertSuccess(
+            H3_EXPORT(gridDistance)(origin, cells[1], &expectedDistance));
+        t_assert(distances[1] == expectedDistance, "distance to neighbor");
+        t_assert(distances[2] == -1, "failed distance is -1");
+    }
+
+    TEST(localIjOriginInvalid) {
+        LocalIjOrigin prepared;
+        t_assert(H3_EXPORT(prepareLocalIjOrigin)(0x7fffffffffffffff,
+                                                 &prepared) == E_CELL_INVALID,
+                 "invalid origin rejected");
+    }
+
+    TEST(localIjToCells) {
+        H3Index origin = 0x8828308281fffff;
+        CoordIJ originIj;
+        t_assertSuccess(H3_EXPORT(cellToLocalIj)(origin, origin, 0, &originIj));
+        CoordIJ ij[3] = {
+            originIj, {originIj.i + 1, originIj.j}, {INT32_MAX, 0}};
+        H3Index out[3];
+        t_assertSuccess(H3_EXPORT(localIjToCells)(origin, ij, 3, 0, out));
+        t_assert(out[0] == origin, "origin coordinates give origin");
+        H3Index expected;
+        t_assertSuccess(H3_EXPORT(localIjToCell)(origin, &ij[1], 0, &expected));
+        t_assert(out[1] == expected, "neighbor coordinates match");
+        t_assert(out[2] == H3_NULL, "undefined coordinates give H3_NULL");
+        t_assert(H3_EXPORT(localIjToCells)(origin, ij, 3, 1, out) ==
+                     E_OPTION_INVALID,
+                 "invalid mode rejected");
+    }
+
+    TEST(localIjRectToCells) {
+        H3Index origin = 0x8828308281fffff;
+        CoordIJ min = {-1, -1};
+        CoordIJ max = {1, 0};
+        int64_t sz;
+        t_assertSuccess(H3_EXPORT(localIjRectSize)(&min, &max, &sz));
+        t_assert(sz == 6, "rect size");
+        t_assert(H3_EXPORT(localIjRectSize)(&max, &min, &sz) == E_DOMAIN,
+                 "empty rect rejected");
+        CoordIJ wideMin = {INT32_MIN, INT32_MIN};
+        CoordIJ wideMax = {INT32_MAX, INT32_MAX};
+        t_assert(
+            H3_EXPORT(localIjRectSize)(&wideMin, &wideMax, &sz) == E_DOMAIN,
+            "oversized rect rejected");
+
+        H3Index out[6];
+        t_assertSuccess(
+            H3_EXPORT(localIjRectToCells)(origin, &min, &max, 0, out));
+        t_assert(H3_EXPORT(localIjRectToCells)(origin, &min, &max, 1, out) ==
+                     E_OPTION_INVALID,
+                 "invalid mode rejected");
+        int n = 0;
+        for (int j = min.j; j <= max.j; j++) {
+            for (int i = min.i; i <= max.i; i++) {
+                CoordIJ ij = {i, j};
+                H3Index expected;
+                if (H3_EXPORT(localIjToCell)(origin, &ij, 0, &expected)) {
+                    expected = H3_NULL;
+                }
+                t_assert(out[n] == expected, "rect cell matches");
+                n++;
+            }
+        }
+    }
 }
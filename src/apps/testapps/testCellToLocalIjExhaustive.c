@@ -275,6 +275,52 @@ void localIjToH3_traverse_assertions(H3Index h3) {
     }
 }
 
+void localIjToH3_rect_assertions(H3Index h3) {
+    int r = H3_GET_RESOLUTION(h3);
+    t_assert(r <= 5, "resolution supported by test function (rect)");
+    int k = MAX_DISTANCES[r];
+
+    CoordIJ originIj;
+    t_assert(H3_EXPORT(cellToLocalIj)(h3, h3, 0, &originIj) == 0,
+             "Got origin coordinates");
+    CoordIJ min = {originIj.i - k, originIj.j - k};
+    CoordIJ max = {originIj.i + k, originIj.j + k};
+
+    int64_t sz;
+    t_assertSuccess(H3_EXPORT(localIjRectSize)(&min, &max, &sz));
+    t_assert(sz == (int64_t)(2 * k + 1) * (2 * k + 1), "rect size");
+    H3Index *rect = calloc(sz, sizeof(H3Index));
+    CoordIJ *coords = calloc(sz, sizeof(CoordIJ));
+    H3Index *list = calloc(sz, sizeof(H3Index));
+    t_assertSuccess(H3_EXPORT(localIjRectToCells)(h3, &min, &max, 0, rect));
+
+    int64_t n = 0;
+    for (int j = min.j; j <= max.j; j++) {
+        for (int i = min.i; i <= max.i; i++) {
+            CoordIJ ij = {i, j};
+            H3Index expected;
+            if (H3_EXPORT(localIjToCell)(h3, &ij, 0, &expected)) {
+                expected = H3_NULL;
+            }
+            t_assert(rect[n] == expected,
+                     "localIjRectToCells matches localIjToCell");
+            // List the coordinates in reverse, to jump around more
+            coords[sz - 1 - n] = ij;
+            n++;
+        }
+    }
+
+    t_assertSuccess(H3_EXPORT(localIjToCells)(h3, coords, sz, 0, list));
+    for (int64_t i = 0; i < sz; i++) {
+        t_assert(list[sz - 1 - i] == rect[i],
+                 "localIjToCells matches localIjRectToCells");
+    }
+
+    free(list);
+    free(coords);
+    free(rect);
+}
+
 SUITE(h3ToLocalIj) {
     TEST(localIjToH3_identity) {
         iterateAllIndexesAtRes(0, localIjToH3_identity_assertions);
@@ -316,4 +362,12 @@ SUITE(h3ToLocalIj) {
         iterateAllIndexesAtResPartial(3, localIjToH3_traverse_assertions, 27);
         // Further resolutions aren't tested to save time.
     }
+
+    TEST(localIjToH3_rect) {
+        iterateAllIndexesAtRes(0, localIjToH3_rect_assertions);
+        iterateAllIndexesAtRes(1, localIjToH3_rect_assertions);
+        iterateAllIndexesAtRes(2, localIjToH3_rect_assertions);
+        // Don't iterate all of res 3, to save time
+        iterateAllIndexesAtResPartial(3, localIjToH3_rect_assertions, 27);
+    }
 }
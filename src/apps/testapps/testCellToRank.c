@@ -0,0 +1,139 @@
+/*
+ * Copyright 2023 Uber Technologies, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/** @file
+ * @brief tests H3 functions `cellToRank` and `rankToCell`
+ *
+ *  usage: `testCellToRank`
+ */
+
+#include <stdlib.h>
+
+#include "h3Index.h"
+#include "h3api.h"
+#include "test.h"
+#include "utility.h"
+
+static void rank_assertions(int res) {
+    int64_t numCells;
+    t_assertSuccess(H3_EXPORT(getNumCells)(res, &numCells));
+
+    // Ranks follow base cell order, then child position order, which is the
+    // order cellToChildren produces
+    int64_t rank = 0;
+    for (int baseCell = 0; baseCell < NUM_BASE_CELLS; baseCell++) {
+        H3Index parent;
+        setH3Index(&parent, 0, baseCell, 0);
+        int64_t numChildren;
+        t_assertSuccess(
+            H3_EXPORT(cellToChildrenSize)(parent, res, &numChildren));
+        H3Index *children = calloc(numChildren, sizeof(H3Index));
+        t_assertSuccess(H3_EXPORT(cellToChildren)(parent, res, children));
+
+        for (int64_t i = 0; i < numChildren; i++) {
+            int64_t cellRank;
+            t_assertSuccess(H3_EXPORT(cellToRank)(children[i], &cellRank));
+            t_assert(cellRank == rank, "rank matches iteration index");
+            H3Index cell;
+            t_assertSuccess(H3_EXPORT(rankToCell)(rank, res, &cell));
+            t_assert(cell == children[i], "cell matches expected");
+            rank++;
+        }
+
+        free(children);
+    }
+    t_assert(rank == numCells, "ranks cover all cells at resolution");
+}
+
+SUITE(cellToRank) {
+    TEST(rank_correctness) {
+        for (int res = 0; res <= 3; res++) {
+            rank_assertions(res);
+        }
+    }
+
+    TEST(rank_finestResolution) {
+        int64_t numCells;
+        t_assertSuccess(H3_EXPORT(getNumCells)(MAX_H3_RES, &numCells));
+        int64_t ranks[4] = {0, 1, numCells / 2, numCells - 1};
+        H3Index cells[4];
+        t_assertSuccess(H3_EXPORT(ranksToCells)(ranks, 4, MAX_H3_RES, cells));
+        int64_t roundTrip[4];
+        t_assertSuccess(H3_EXPORT(cellsToRanks)(cells, 4, roundTrip));
+        for (int i = 0; i < 4; i++) {
+            t_assert(H3_EXPORT(isValidCell)(cells[i]), "cell is valid");
+            t_assert(roundTrip[i] == ranks[i], "rank round trips");
+        }
+    }
+
+    TEST(rankToCell_errors) {
+        int64_t numCells;
+        t_assertSuccess(H3_EXPORT(getNumCells)(5, &numCells));
+        H3Index cell;
+        t_assert(H3_EXPORT(rankToCell)(-1, 5, &cell) == E_DOMAIN,
+                 "negative rank fails");
+        t_assert(H3_EXPORT(rankToCell)(numCells, 5, &cell) == E_DOMAIN,
+                 "rank past the last cell fails");
+        t_assert(H3_EXPORT(rankToCell)(0, -1, &cell) == E_RES_DOMAIN,
+                 "negative resolution fails");
+        t_assert(H3_EXPORT(rankToCell)(0, 16, &cell) == E_RES_DOMAIN,
+                 "resolution too high fails");
+        int64_t ranks[2] = {0, numCells};
+        H3Index cells[2];
+        t_assert(H3_EXPORT(ranksToCells)(ranks, 2, 5, cells) == E_DOMAIN,
+                 "batch fails on out of range rank");
+    }
+
+    TEST(cellToRank_errors) {
+        int64_t rank;
+        H3Index cell = 0x85283473fffffff;
+        H3Index invalidDigit = cell;
+        H3_SET_INDEX_DIGIT(invalidDigit, 2, INVALID_DIGIT);
+        t_assert(H3_EXPORT(cellToRank)(invalidDigit, &rank) == E_CELL_INVALID,
+                 "invalid digit fails");
+
+        H3Index pentagonKAxis;
+        setH3Index(&pentagonKAxis, 2, 4, CENTER_DIGIT);
+        H3_SET_INDEX_DIGIT(pentagonKAxis, 2, K_AXES_DIGIT);
+        t_assert(
+            H3_EXPORT(cellToRank)(pentagonKAxis, &rank) == E_CELL_INVALID,
+            "deleted pentagon subsequence fails");
+
+        H3Index edge = cell;
+        H3_SET_MODE(edge, H3_DIRECTEDEDGE_MODE);
+        t_assert(H3_EXPORT(cellToRank)(edge, &rank) == E_CELL_INVALID,
+                 "non-cell index fails");
+
+        H3Index highBit = cell;
+        H3_SET_HIGH_BIT(highBit, 1);
+        t_assert(H3_EXPORT(cellToRank)(highBit, &rank) == E_CELL_INVALID,
+                 "high bit fails");
+
+        H3Index reserved = cell;
+        H3_SET_RESERVED_BITS(reserved, 1);
+        t_assert(H3_EXPORT(cellToRank)(reserved, &rank) == E_CELL_INVALID,
+                 "reserved bits fail");
+
+        H3Index unusedDigit = cell;
+        H3_SET_INDEX_DIGIT(unusedDigit, 6, CENTER_DIGIT);
+        t_assert(H3_EXPORT(cellToRank)(unusedDigit, &rank) == E_CELL_INVALID,
+                 "unused digit other than 7 fails");
+
+        H3Index cells[2] = {cell, invalidDigit};
+        int64_t ranks[2];
+        t_assert(H3_EXPORT(cellsToRanks)(cells, 2, ranks) == E_CELL_INVALID,
+                 "batch fails on invalid cell");
+    }
+}
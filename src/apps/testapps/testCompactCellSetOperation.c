@@ -0,0 +1,224 @@
+/*
+ * Copyright 2023 Uber Technologies, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/** @file
+ * @brief tests H3 function `compactCellSetOperation`
+ *
+ *  usage: `testCompactCellSetOperation`
+ */
+
+#include <stdbool.h>
+#include <stdlib.h>
+
+#include "h3Index.h"
+#include "h3api.h"
+#include "test.h"
+#include "utility.h"
+
+static int compareCells(const void *a, const void *b) {
+    H3Index cellA = *(const H3Index *)a;
+    H3Index cellB = *(const H3Index *)b;
+    return cellA < cellB ? -1 : cellA > cellB;
+}
+
+static bool inSortedSet(const H3Index *set, int64_t numCells, H3Index cell) {
+    return bsearch(&cell, set, numCells, sizeof(H3Index), compareCells) !=
+           NULL;
+}
+
+/**
+ * Disk of cells, compacted, with H3_NULL entries removed. The uncompacted
+ * disk is returned sorted in disk.
+ */
+static H3Index *compactedDisk(H3Index origin, int k, H3Index **disk,
+                              int64_t *numDisk, int64_t *numCompacted) {
+    t_assertSuccess(H3_EXPORT(maxGridDiskSize)(k, numDisk));
+    *disk = calloc(*numDisk, sizeof(H3Index));
+    t_assertSuccess(H3_EXPORT(gridDisk)(origin, k, *disk));
+    int64_t n = 0;
+    for (int64_t i = 0; i < *numDisk; i++) {
+        if ((*disk)[i]) {
+            (*disk)[n++] = (*disk)[i];
+        }
+    }
+    *numDisk = n;
+    qsort(*disk, n, sizeof(H3Index), compareCells);
+
+    H3Index *compacted = calloc(n, sizeof(H3Index));
+    t_assertSuccess(H3_EXPORT(compactCells)(*disk, compacted, n));
+    *numCompacted = 0;
+    for (int64_t i = 0; i < n; i++) {
+        if (compacted[i]) {
+            compacted[(*numCompacted)++] = compacted[i];
+        }
+    }
+    return compacted;
+}
+
+/**
+ * Checks each operation on compacted disks against the same operation on
+ * the uncompacted disks.
+ */
+static void setOperation_assertions(H3Index originA, int kA, H3Index originB,
+                                    int kB) {
+    int res = H3_GET_RESOLUTION(originA);
+    H3Index *diskA;
+    H3Index *diskB;
+    int64_t numDiskA, numDiskB, numA, numB;
+    H3Index *setA = compactedDisk(originA, kA, &diskA, &numDiskA, &numA);
+    H3Index *setB = compactedDisk(originB, kB, &diskB, &numDiskB, &numB);
+    t_assert(numA < numDiskA, "first set was compacted");
+
+    for (uint32_t op = CELL_SET_UNION; op <= CELL_SET_SYMMETRIC_DIFFERENCE;
+         op++) {
+        // Expected result, from the uncompacted sets
+        H3Index *expected = calloc(numDiskA + numDiskB, sizeof(H3Index));
+        int64_t numExpected = 0;
+        for (int64_t i = 0; i < numDiskA; i++) {
+            bool inB = inSortedSet(diskB, numDiskB, diskA[i]);
+            if (op == CELL_SET_UNION || (op == CELL_SET_INTERSECTION && inB) ||
+                (op != CELL_SET_INTERSECTION && !inB)) {
+                expected[numExpected++] = diskA[i];
+            }
+        }
+        if (op == CELL_SET_UNION || op == CELL_SET_SYMMETRIC_DIFFERENCE) {
+            for (int64_t i = 0; i < numDiskB; i++) {
+                if (!inSortedSet(diskA, numDiskA, diskB[i])) {
+                    expected[numExpected++] = diskB[i];
+                }
+            }
+        }
+        H3Index *expectedCompacted = calloc(numExpected + 1, sizeof(H3Index));
+        t_assertSuccess(H3_EXPORT(compactCells)(expected, expectedCompacted,
+                                                numExpected));
+        int64_t numExpectedCompacted = 0;
+        for (int64_t i = 0; i < numExpected; i++) {
+            if (expectedCompacted[i]) {
+                expectedCompacted[numExpectedCompacted++] =
+                    expectedCompacted[i];
+            }
+        }
+        qsort(expectedCompacted, numExpectedCompacted, sizeof(H3Index),
+              compareCells);
+
+        int64_t size;
+        t_assertSuccess(H3_EXPORT(compactCellSetOperationSize)(
+            setA, numA, setB, numB, op, &size));
+        t_assert(size == numExpectedCompacted, "size matches compacted set");
+        H3Index *out = calloc(size + 1, sizeof(H3Index));
+        out[size] = 1;
+        t_assertSuccess(H3_EXPORT(compactCellSetOperation)(
+            setA, numA, setB, numB, op, out, size + 1));
+        t_assert(out[size] == H3_NULL, "unused output is H3_NULL");
+        qsort(out, size, sizeof(H3Index), compareCells);
+        for (int64_t i = 0; i < size; i++) {
+            t_assert(out[i] == expectedCompacted[i],
+                     "result matches compacted set");
+        }
+
+        int64_t uncompactedSize;
+        t_assertSuccess(H3_EXPORT(uncompactCellsSize)(out, size, res,
+                                                      &uncompactedSize));
+        t_assert(uncompactedSize == numExpected,
+                 "result covers the expected cells");
+
+        free(out);
+        free(expectedCompacted);
+        free(expected);
+    }
+
+    free(setB);
+    free(setA);
+    free(diskB);
+    free(diskA);
+}
+
+SUITE(compactCellSetOperation) {
+    TEST(overlappingDisks) {
+        H3Index origin = 0x88283080ddfffff;
+        H3Index otherOrigin;
+        // Some cell partway across the first disk
+        CoordIJ ij;
+        t_assertSuccess(H3_EXPORT(cellToLocalIj)(origin, origin, 0, &ij));
+        ij.i += 12;
+        t_assertSuccess(H3_EXPORT(localIjToCell)(origin, &ij, 0, &otherOrigin));
+        setOperation_assertions(origin, 20, otherOrigin, 15);
+        setOperation_assertions(otherOrigin, 15, origin, 20);
+    }
+
+    TEST(nestedDisks) {
+        H3Index origin = 0x88283080ddfffff;
+        setOperation_assertions(origin, 20, origin, 8);
+        setOperation_assertions(origin, 8, origin, 20);
+        setOperation_assertions(origin, 20, origin, 20);
+    }
+
+    TEST(pentagon) {
+        H3Index pentagon;
+        setH3Index(&pentagon, 4, 4, CENTER_DIGIT);
+        H3Index neighbor;
+        setH3Index(&neighbor, 4, 4, J_AXES_DIGIT);
+        setOperation_assertions(pentagon, 6, neighbor, 4);
+    }
+
+    TEST(emptySets) {
+        H3Index cell = 0x88283080ddfffff;
+        int64_t size;
+        t_assertSuccess(H3_EXPORT(compactCellSetOperationSize)(
+            NULL, 0, &cell, 1, CELL_SET_UNION, &size));
+        t_assert(size == 1, "union with empty set");
+        t_assertSuccess(H3_EXPORT(compactCellSetOperationSize)(
+            NULL, 0, &cell, 1, CELL_SET_INTERSECTION, &size));
+        t_assert(size == 0, "intersection with empty set");
+        t_assertSuccess(H3_EXPORT(compactCellSetOperationSize)(
+            &cell, 1, &cell, 1, CELL_SET_DIFFERENCE, &size));
+        t_assert(size == 0, "difference with itself");
+    }
+
+    TEST(differenceOfParent) {
+        // A cell minus its center child at a finer resolution leaves six
+        // siblings at each resolution in between
+        H3Index cell = 0x85283473fffffff;
+        H3Index child;
+        t_assertSuccess(H3_EXPORT(cellToCenterChild)(cell, 8, &child));
+        int64_t size;
+        t_assertSuccess(H3_EXPORT(compactCellSetOperationSize)(
+            &cell, 1, &child, 1, CELL_SET_DIFFERENCE, &size));
+        t_assert(size == 18, "six cells for each resolution");
+    }
+
+    TEST(errors) {
+        H3Index cell = 0x85283473fffffff;
+        int64_t size;
+        t_assert(H3_EXPORT(compactCellSetOperationSize)(&cell, 1, &cell, 1, 4,
+                                                        &size) ==
+                     E_OPTION_INVALID,
+                 "invalid operation fails");
+        H3Index invalid = cell;
+        H3_SET_BASE_CELL(invalid, 122);
+        t_assert(H3_EXPORT(compactCellSetOperationSize)(
+                     &cell, 1, &invalid, 1, CELL_SET_UNION, &size) ==
+                     E_CELL_INVALID,
+                 "invalid cell fails");
+
+        H3Index child;
+        t_assertSuccess(H3_EXPORT(cellToCenterChild)(cell, 8, &child));
+        H3Index out[17];
+        t_assert(H3_EXPORT(compactCellSetOperation)(
+                     &cell, 1, &child, 1, CELL_SET_DIFFERENCE, out, 17) ==
+                     E_MEMORY_BOUNDS,
+                 "too small output fails");
+    }
+}
@@ -0,0 +1,144 @@
+/*
+ * Copyright 2023 Uber Technologies, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/** @file
+ * @brief tests H3 functions `cellToCurveKey` and `curveKeyToCell`
+ *
+ *  usage: `testCurveKey`
+ */
+
+#include <stdlib.h>
+
+#include "h3Index.h"
+#include "h3api.h"
+#include "iterators.h"
+#include "test.h"
+#include "utility.h"
+
+static void roundTrip_assertions(H3Index cell) {
+    uint64_t key;
+    t_assertSuccess(H3_EXPORT(cellToCurveKey)(cell, &key));
+    H3Index roundTrip;
+    t_assertSuccess(H3_EXPORT(curveKeyToCell)(key, &roundTrip));
+    t_assert(roundTrip == cell, "key round trips to the cell");
+}
+
+SUITE(curveKey) {
+    TEST(roundTripAllCells) {
+        for (int res = 0; res <= 3; res++) {
+            IterCellsResolution iter = iterInitRes(res);
+            for (; iter.h; iterStepRes(&iter)) {
+                roundTrip_assertions(iter.h);
+            }
+        }
+    }
+
+    TEST(roundTripFinestResolution) {
+        // Cells spread over every face, at the finest resolutions where face
+        // coordinates are largest
+        for (int lat = -89; lat <= 89; lat += 7) {
+            for (int lng = -179; lng <= 179; lng += 11) {
+                LatLng point = {.lat = H3_EXPORT(degsToRads)(lat + 0.123),
+                                .lng = H3_EXPORT(degsToRads)(lng + 0.456)};
+                for (int res = 13; res <= MAX_H3_RES; res++) {
+                    H3Index cell;
+                    t_assertSuccess(
+                        H3_EXPORT(latLngToCell)(&point, res, &cell));
+                    roundTrip_assertions(cell);
+                }
+            }
+        }
+    }
+
+    TEST(roundTripPentagons) {
+        H3Index pentagons[12];
+        for (int res = 0; res <= MAX_H3_RES; res++) {
+            t_assertSuccess(H3_EXPORT(getPentagons)(res, pentagons));
+            for (int i = 0; i < 12; i++) {
+                roundTrip_assertions(pentagons[i]);
+            }
+        }
+    }
+
+    TEST(resolutionOrder) {
+        H3Index parent = 0x85283473fffffff;
+        H3Index child;
+        t_assertSuccess(H3_EXPORT(cellToCenterChild)(parent, 6, &child));
+        uint64_t parentKey, childKey;
+        t_assertSuccess(H3_EXPORT(cellToCurveKey)(parent, &parentKey));
+        t_assertSuccess(H3_EXPORT(cellToCurveKey)(child, &childKey));
+        t_assert(parentKey < childKey, "coarser resolution sorts first");
+    }
+
+    TEST(neighborsAreClose) {
+        // On one face, neighbors are within a small part of the curve
+        H3Index origin = 0x89283080ddbffff;
+        H3Index neighbors[7];
+        t_assertSuccess(H3_EXPORT(gridDisk)(origin, 1, neighbors));
+        uint64_t keys[7];
+        t_assertSuccess(H3_EXPORT(cellsToCurveKeys)(neighbors, 7, keys));
+        for (int i = 1; i < 7; i++) {
+            uint64_t diff = keys[i] > keys[0] ? keys[i] - keys[0]
+                                              : keys[0] - keys[i];
+            t_assert(diff < (UINT64_C(1) << 40), "neighbor key is close");
+        }
+    }
+
+    TEST(batch) {
+        H3Index cells[] = {0x85283473fffffff, 0x8009fffffffffff,
+                           0x8f754e64992d6d8};
+        uint64_t keys[3];
+        t_assertSuccess(H3_EXPORT(cellsToCurveKeys)(cells, 3, keys));
+        H3Index out[3];
+        t_assertSuccess(H3_EXPORT(curveKeysToCells)(keys, 3, out));
+        for (int i = 0; i < 3; i++) {
+            t_assert(out[i] == cells[i], "batch round trips");
+        }
+
+        cells[1] = 0;
+        t_assert(H3_EXPORT(cellsToCurveKeys)(cells, 3, keys) == E_CELL_INVALID,
+                 "invalid cell fails batch");
+        keys[1] = UINT64_MAX;
+        t_assert(H3_EXPORT(curveKeysToCells)(keys, 3, out) == E_DOMAIN,
+                 "invalid key fails batch");
+    }
+
+    TEST(invalid) {
+        uint64_t key;
+        t_assert(H3_EXPORT(cellToCurveKey)(0, &key) == E_CELL_INVALID,
+                 "null cell fails");
+        t_assert(H3_EXPORT(cellToCurveKey)(0x11283473fffffff, &key) ==
+                     E_CELL_INVALID,
+                 "directed edge fails");
+
+        H3Index cell;
+        t_assert(H3_EXPORT(curveKeyToCell)(UINT64_MAX, &cell) == E_DOMAIN,
+                 "key past the last resolution fails");
+        t_assert(H3_EXPORT(curveKeyToCell)(UINT64_C(20) << 48, &cell) ==
+                     E_DOMAIN,
+                 "key past the last face fails");
+        t_assert(H3_EXPORT(curveKeyToCell)(0, &cell) == E_DOMAIN,
+                 "key far off the face fails");
+
+        // A key on a face, but for a cell keyed by another face
+        t_assertSuccess(
+            H3_EXPORT(cellToCurveKey)(0x8009fffffffffff, &key));
+        int face = (int)((key >> 48) & 0x1f);
+        uint64_t otherFace = (key & ~(UINT64_C(0x1f) << 48)) |
+                             ((uint64_t)((face + 1) % 20) << 48);
+        t_assert(H3_EXPORT(curveKeyToCell)(otherFace, &cell) == E_DOMAIN,
+                 "key for another face fails");
+    }
+}
@@ -70,6 +70,40 @@ static void gridDistance_gridDisk_assertions(H3Index h3) {
         }
     }
 
+    // The prepared origin functions agree with the single cell functions,
+    // including which cells fail
+    LocalIjOrigin origin;
+    t_assertSuccess(H3_EXPORT(prepareLocalIjOrigin)(h3, &origin));
+    int64_t *batchDistances = calloc(sz, sizeof(int64_t));
+    CoordIJ *batchIj = calloc(sz, sizeof(CoordIJ));
+    H3Error *batchErrors = calloc(sz, sizeof(H3Error));
+    t_assertSuccess(H3_EXPORT(gridDistancesFromOrigin)(&origin, neighbors, sz,
+                                                       batchDistances));
+    t_assertSuccess(H3_EXPORT(cellsToLocalIjFromOrigin)(
+        &origin, neighbors, sz, 0, batchIj, batchErrors));
+    for (int64_t i = 0; i < sz; i++) {
+        if (neighbors[i] == 0) {
+            continue;
+        }
+        int64_t distance;
+        H3Error distanceError =
+            H3_EXPORT(gridDistance)(h3, neighbors[i], &distance);
+        t_assert(batchDistances[i] == (distanceError ? -1 : distance),
+                 "gridDistancesFromOrigin matches gridDistance");
+
+        CoordIJ ij;
+        H3Error ijError = H3_EXPORT(cellToLocalIj)(h3, neighbors[i], 0, &ij);
+        t_assert(batchErrors[i] == ijError,
+                 "cellsToLocalIjFromOrigin error matches cellToLocalIj");
+        if (!ijError) {
+            t_assert(batchIj[i].i == ij.i && batchIj[i].j == ij.j,
+                     "cellsToLocalIjFromOrigin matches cellToLocalIj");
+        }
+    }
+
+    free(batchErrors);
+    free(batchIj);
+    free(batchDistances);
     free(distances);
     free(neighbors);
 }
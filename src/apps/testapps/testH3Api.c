@@ -123,4 +123,25 @@ SUITE(h3Api) {
         t_assert(H3_VERSION_MINOR >= 0, "minor version is set");
         t_assert(H3_VERSION_PATCH >= 0, "patch version is set");
     }
+
+    TEST(allocationStatsNotKept) {
+        AllocationStats stats = {.allocations = 1};
+        t_assert(H3_EXPORT(getAllocationStats)(&stats) == E_FAILED,
+                 "counts are not kept by the default build");
+        t_assert(stats.allocations == 0 && stats.peakBytes == 0,
+                 "counts are zero");
+        t_assert(H3_EXPORT(resetAllocationStats)() == E_FAILED,
+                 "counts cannot be reset");
+    }
+
+#ifndef H3_HOT_PATH_COUNTERS
+    TEST(hotPathCountersNotKept) {
+        HotPathCounters counters = {.neighborCalls = 1};
+        t_assert(H3_EXPORT(getHotPathCounters)(&counters) == E_FAILED,
+                 "counters are not kept by the default build");
+        t_assert(counters.neighborCalls == 0, "counters are zero");
+        t_assert(H3_EXPORT(resetHotPathCounters)() == E_FAILED,
+                 "counters cannot be reset");
+    }
+#endif
 }
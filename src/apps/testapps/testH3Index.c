@@ -19,6 +19,8 @@
  *  usage: `testH3Index`
  */
 
+#include <inttypes.h>
+#include <math.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
@@ -43,6 +45,37 @@ SUITE(h3Index) {
         t_assertSuccess(H3_EXPORT(latLngToCell)(&g4, 0, &h));
     }
 
+    TEST(latLngsToCells) {
+        LatLng points[4];
+        setGeoDegs(&points[0], 37.775, -122.419);
+        setGeoDegs(&points[1], -33.868, 151.209);
+        setGeoDegs(&points[2], 90, 0);
+        setGeoDegs(&points[3], 0, 1E45);
+        H3Index out[4];
+        for (int res = 0; res <= MAX_H3_RES; res++) {
+            t_assertSuccess(H3_EXPORT(latLngsToCells)(points, 4, res, out));
+            for (int i = 0; i < 4; i++) {
+                H3Index expected;
+                t_assertSuccess(
+                    H3_EXPORT(latLngToCell)(&points[i], res, &expected));
+                t_assert(out[i] == expected, "same cell as latLngToCell");
+            }
+        }
+
+        t_assert(H3_EXPORT(latLngsToCells)(points, 4, -1, out) == E_RES_DOMAIN,
+                 "invalid resolution fails");
+        t_assert(H3_EXPORT(latLngsToCells)(points, 4, 16, out) == E_RES_DOMAIN,
+                 "resolution too high fails");
+
+        points[1].lng = NAN;
+        t_assert(
+            H3_EXPORT(latLngsToCells)(points, 4, 9, out) == E_LATLNG_DOMAIN,
+            "non-finite point fails");
+        t_assert(out[1] == H3_NULL, "non-finite point gives H3_NULL");
+        t_assert(out[0] != H3_NULL && out[2] != H3_NULL && out[3] != H3_NULL,
+                 "other points still converted");
+    }
+
     TEST(faceIjkToH3ExtremeCoordinates) {
         FaceIJK fijk0I = {0, {3, 0, 0}};
         t_assert(_faceIjkToH3(&fijk0I, 0) == 0, "i out of bounds at res 0");
@@ -87,6 +120,24 @@ SUITE(h3Index) {
                  "isValidCell failed on invalid unused digits");
     }
 
+    TEST(isValidCells) {
+        H3Index cells[] = {0x85283473fffffff, 0x85283473fffffff ^ 1,
+                           0x8009fffffffffff, 0x1,
+                           0x820807fffffffff, H3_NULL,
+                           0x8f28308280f18f2, 0x8f28308280f18f2 | 7,
+                           0x11283473fffffff, 0x89283470c27ffff};
+        int numCells = sizeof(cells) / sizeof(cells[0]);
+        int out[sizeof(cells) / sizeof(cells[0])];
+        t_assertSuccess(H3_EXPORT(isValidCells)(cells, numCells, out));
+        for (int i = 0; i < numCells; i++) {
+            t_assert(out[i] == H3_EXPORT(isValidCell)(cells[i]),
+                     "isValidCells agrees with isValidCell");
+        }
+        t_assert(out[0] && !out[1] && out[2] && !out[3] && out[4] && !out[5],
+                 "isValidCells found the expected cells");
+        t_assertSuccess(H3_EXPORT(isValidCells)(cells, 0, out));
+    }
+
     TEST(isValidCellBaseCell) {
         for (int i = 0; i < NUM_BASE_CELLS; i++) {
             H3Index h = H3_INIT;
@@ -190,6 +241,111 @@ SUITE(h3Index) {
         t_assert(h3 == 0xffffffffffffffff, "got expected on large input");
     }
 
+    TEST(stringToH3MatchesScanf) {
+        const char *strings[] = {"85283473fffffff",
+                                 "85283473FFFFFFF",
+                                 "  \t85283473fffffff",
+                                 "85283473fffffff\n",
+                                 "85283473fffffff,37.5",
+                                 "0x85283473fffffff",
+                                 "0X85283473fffffff",
+                                 "0",
+                                 "0x",
+                                 "0xz",
+                                 "x5",
+                                 "-1",
+                                 "+85283473fffffff",
+                                 "ffffffffffffffff",
+                                 "1ffffffffffffffff",
+                                 "0000000000000000085283473fffffff",
+                                 "   ",
+                                 "g"};
+        for (size_t i = 0; i < sizeof(strings) / sizeof(strings[0]); i++) {
+            H3Index expected = H3_NULL;
+            int read = sscanf(strings[i], "%" PRIx64, &expected);
+            H3Index h3 = H3_NULL;
+            H3Error err = H3_EXPORT(stringToH3)(strings[i], &h3);
+            t_assert((err == E_SUCCESS) == (read == 1),
+                     "parses the same strings as sscanf");
+            t_assert(err || h3 == expected, "same value as sscanf");
+        }
+    }
+
+    TEST(h3ToStringMatchesPrintf) {
+        H3Index indexes[] = {0, 0x1, 0xf, 0x10, 0x85283473fffffff,
+                             0x8f754e64992d6d8, 0xffffffffffffffff};
+        for (size_t i = 0; i < sizeof(indexes) / sizeof(indexes[0]); i++) {
+            char expected[17];
+            char buf[17];
+            snprintf(expected, sizeof(expected), "%" PRIx64, indexes[i]);
+            t_assertSuccess(H3_EXPORT(h3ToString)(indexes[i], buf, 17));
+            t_assert(strcmp(buf, expected) == 0, "same string as printf");
+        }
+    }
+
+    TEST(stringsToH3) {
+        const char *strings[] = {"85283473fffffff", "0x1", "8f754e64992d6d8"};
+        H3Index out[3];
+        t_assertSuccess(H3_EXPORT(stringsToH3)(strings, 3, out));
+        t_assert(out[0] == 0x85283473fffffff, "first string parsed");
+        t_assert(out[1] == 0x1, "second string parsed");
+        t_assert(out[2] == 0x8f754e64992d6d8, "third string parsed");
+
+        strings[1] = "**";
+        t_assert(H3_EXPORT(stringsToH3)(strings, 3, out) == E_FAILED,
+                 "junk string fails");
+    }
+
+    TEST(packedStrings) {
+        H3Index indexes[] = {0x85283473fffffff, 0, 0xffffffffffffffff,
+                             0x8f754e64992d6d8};
+        const size_t stride = 20;
+        char buf[4 * 20];
+        t_assertSuccess(H3_EXPORT(h3ToPackedStrings)(indexes, 4, buf, stride));
+        t_assert(strcmp(buf + stride, "0") == 0, "packed string written");
+        t_assert(strcmp(buf + 2 * stride, "ffffffffffffffff") == 0,
+                 "largest packed string written");
+
+        H3Index out[4];
+        t_assertSuccess(H3_EXPORT(packedStringsToH3)(buf, stride, 4, out));
+        for (int i = 0; i < 4; i++) {
+            t_assert(out[i] == indexes[i], "packed strings round trip");
+        }
+
+        t_assert(H3_EXPORT(h3ToPackedStrings)(indexes, 4, buf, 16) ==
+                     E_MEMORY_BOUNDS,
+                 "too small stride fails");
+        t_assert(H3_EXPORT(packedStringsToH3)(buf, 16, 4, out) ==
+                     E_MEMORY_BOUNDS,
+                 "too small stride fails to parse");
+    }
+
+    TEST(packedStringsUnterminated) {
+        // Records padded with blanks, with no null terminators
+        char buf[3 * 20];
+        memset(buf, ' ', sizeof(buf));
+        memcpy(buf, "+5", 2);
+        memcpy(buf + 20, "\n", 1);
+        memcpy(buf + 40, "85283473fffffff", 15);
+
+        H3Index out[3];
+        t_assertSuccess(H3_EXPORT(packedStringsToH3)(buf, 20, 1, out));
+        t_assert(out[0] == 0x5, "signed record parsed within its stride");
+        t_assert(H3_EXPORT(packedStringsToH3)(buf + 20, 20, 2, out) ==
+                     E_FAILED,
+                 "blank record does not parse the next record");
+
+        memcpy(buf + 20, "-1", 2);
+        t_assertSuccess(H3_EXPORT(packedStringsToH3)(buf, 20, 3, out));
+        t_assert(out[1] == 0xffffffffffffffff, "negative record parsed");
+        t_assert(out[2] == 0x85283473fffffff, "record after signed records");
+
+        // A blank last record, ending at the end of the buffer
+        memset(buf + 40, ' ', 20);
+        t_assert(H3_EXPORT(packedStringsToH3)(buf, 20, 3, out) == E_FAILED,
+                 "blank last record fails");
+    }
+
     TEST(setH3Index) {
         H3Index h;
         setH3Index(&h, 5, 12, 1);
@@ -0,0 +1,118 @@
+/*
+ * Copyright 2023 Uber Technologies, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/** @file
+ * @brief tests the inline accessors in h3inline.h against the exported
+ * functions and internal macros they duplicate.
+ *
+ *  usage: `testH3Inline`
+ */
+
+#include "h3inline.h"
+
+#include "constants.h"
+#include "h3Index.h"
+#include "iterators.h"
+#include "test.h"
+
+/**
+ * Asserts that each inline accessor agrees with the library on cell h.
+ */
+static void assertInlineAccessors(H3Index h) {
+    t_assert(h3GetResolution(h) == H3_EXPORT(getResolution)(h),
+             "resolution matches");
+    t_assert(h3GetBaseCell(h) == H3_EXPORT(getBaseCellNumber)(h),
+             "base cell matches");
+    t_assert(h3GetMode(h) == H3_GET_MODE(h), "mode matches");
+    for (int res = 1; res <= MAX_H3_RES; res++) {
+        t_assert(h3GetIndexDigit(h, res) == (int)H3_GET_INDEX_DIGIT(h, res),
+                 "digit matches");
+    }
+    t_assert(h3IsResClassIII(h) == H3_EXPORT(isResClassIII)(h),
+             "class III matches");
+    t_assert(h3IsPentagon(h) == H3_EXPORT(isPentagon)(h),
+             "pentagon matches");
+
+    int res = H3_GET_RESOLUTION(h);
+    for (int parentRes = 0; parentRes <= res; parentRes++) {
+        H3Index parent;
+        t_assertSuccess(H3_EXPORT(cellToParent)(h, parentRes, &parent));
+        t_assert(h3CellToParent(h, parentRes) == parent, "parent matches");
+    }
+}
+
+SUITE(h3Inline) {
+    TEST(allCellsToRes3) {
+        for (int res = 0; res <= 3; res++) {
+            for (IterCellsResolution iter = iterInitRes(res); iter.h;
+                 iterStepRes(&iter)) {
+                assertInlineAccessors(iter.h);
+            }
+        }
+    }
+
+    TEST(pentagonDescendants) {
+        // Children of each pentagon, and their descendants at the finest
+        // resolution, including the pentagon and those next to it
+        for (int baseCell = 0; baseCell < NUM_BASE_CELLS; baseCell++) {
+            H3Index base;
+            setH3Index(&base, 0, baseCell, CENTER_DIGIT);
+            if (!H3_EXPORT(isPentagon)(base)) {
+                continue;
+            }
+            for (IterCellsChildren iter = iterInitParent(base, 2); iter.h;
+                 iterStepChild(&iter)) {
+                assertInlineAccessors(iter.h);
+                H3Index child;
+                t_assertSuccess(H3_EXPORT(cellToCenterChild)(
+                    iter.h, MAX_H3_RES, &child));
+                assertInlineAccessors(child);
+            }
+        }
+    }
+
+    TEST(isPentagon) {
+        H3Index pentagon;
+        setH3Index(&pentagon, 15, 4, CENTER_DIGIT);
+        t_assert(h3IsPentagon(pentagon), "finest pentagon is a pentagon");
+        H3_SET_INDEX_DIGIT(pentagon, 15, K_AXES_DIGIT);
+        t_assert(!h3IsPentagon(pentagon), "neighbor is not a pentagon");
+
+        H3Index unused;
+        setH3Index(&unused, 15, 127, CENTER_DIGIT);
+        t_assert(!h3IsPentagon(unused), "unused base cell is not a pentagon");
+        t_assert(h3IsPentagon(unused) == H3_EXPORT(isPentagon)(unused),
+                 "unused base cell matches");
+    }
+
+    TEST(directedEdge) {
+        H3Index origin = 0x8928308280fffff;
+        H3Index edge;
+        t_assertSuccess(
+            H3_EXPORT(cellsToDirectedEdge)(origin, 0x8928308280bffff, &edge));
+        t_assert(h3GetMode(edge) == H3_DIRECTEDEDGE_MODE, "edge mode");
+        t_assert(h3GetMode(origin) == H3_CELL_MODE, "cell mode");
+        t_assert(h3GetResolution(edge) == 9, "edge resolution");
+        t_assert(h3GetBaseCell(edge) == h3GetBaseCell(origin),
+                 "edge base cell is that of the origin");
+    }
+
+    TEST(cellToParentOutOfRange) {
+        H3Index h = 0x8928308280fffff;
+        t_assert(h3CellToParent(h, -1) == H3_NULL, "negative resolution");
+        t_assert(h3CellToParent(h, 10) == H3_NULL, "finer resolution");
+        t_assert(h3CellToParent(h, 9) == h, "own resolution");
+    }
+}
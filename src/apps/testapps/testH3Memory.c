@@ -223,4 +223,155 @@ SUITE(h3Memory) {
         t_assert(actualNumIndexes == 1253, "got expected polygonToCells size");
         free(hexagons);
     }
+
+    TEST(polygonToCellsWithWorkspace) {
+        sfGeoPolygon.geoloop = sfGeoLoop;
+        sfGeoPolygon.numHoles = 0;
+
+        int64_t numHexagons;
+        t_assertSuccess(H3_EXPORT(maxPolygonToCellsSize)(&sfGeoPolygon, 9, 0,
+                                                         &numHexagons));
+        H3Index *hexagons = calloc(numHexagons, sizeof(H3Index));
+        PolygonToCellsWorkspace workspace = {0};
+
+        resetMemoryCounters(0);
+        failAlloc = true;
+        H3Error err = H3_EXPORT(polygonToCellsWithWorkspace)(
+            &sfGeoPolygon, 9, 0, &workspace, hexagons);
+        t_assert(err == E_MEMORY_ALLOC, "polygonToCellsWithWorkspace failed");
+        t_assert(actualFreeCalls == 0, "free not called");
+
+        resetMemoryCounters(0);
+        t_assertSuccess(H3_EXPORT(polygonToCellsWithWorkspace)(
+            &sfGeoPolygon, 9, 0, &workspace, hexagons));
+        t_assert(actualAllocCalls == 3, "first call allocates scratch");
+        t_assert(actualFreeCalls == 0, "first call keeps scratch");
+
+        resetMemoryCounters(0);
+        memset(hexagons, 0, numHexagons * sizeof(H3Index));
+        t_assertSuccess(H3_EXPORT(polygonToCellsWithWorkspace)(
+            &sfGeoPolygon, 9, 0, &workspace, hexagons));
+        t_assert(actualAllocCalls == 0, "steady state call did not alloc");
+        t_assert(actualFreeCalls == 0, "steady state call did not free");
+        t_assert(countNonNullIndexes(hexagons, numHexagons) == 1253,
+                 "got expected polygonToCells size");
+
+        resetMemoryCounters(0);
+        H3_EXPORT(destroyPolygonToCellsWorkspace)(&workspace);
+        t_assert(actualFreeCalls == 3, "destroy frees scratch");
+        free(hexagons);
+    }
+
+    TEST(createCellCoverage) {
+        int k = 2;
+        int64_t hexCount;
+        t_assertSuccess(H3_EXPORT(maxGridDiskSize)(k, &hexCount));
+        H3Index *cells = calloc(hexCount, sizeof(H3Index));
+        t_assertSuccess(H3_EXPORT(gridDisk)(sunnyvale, k, cells));
+        CellCoverage coverage;
+
+        for (int permitted = 1; permitted <= 3; permitted++) {
+            resetMemoryCounters(permitted - 1);
+            failAlloc = permitted == 1;
+            t_assert(H3_EXPORT(createCellCoverage)(cells, hexCount,
+                                                   &coverage) == E_MEMORY_ALLOC,
+                     "createCellCoverage returns E_MEMORY_ALLOC");
+            t_assert(actualAllocCalls == permitted, "alloc called");
+            t_assert(actualFreeCalls == permitted - 1,
+                     "allocated memory freed");
+            t_assert(coverage.mins == NULL && coverage.maxes == NULL,
+                     "no coverage on failure");
+        }
+
+        resetMemoryCounters(0);
+        t_assertSuccess(
+            H3_EXPORT(createCellCoverage)(cells, hexCount, &coverage));
+        t_assert(actualAllocCalls == 3, "createCellCoverage called alloc");
+        t_assert(actualFreeCalls == 1, "createCellCoverage freed scratch");
+
+        resetMemoryCounters(0);
+        H3_EXPORT(destroyCellCoverage)(&coverage);
+        t_assert(actualFreeCalls == 2, "destroy frees coverage");
+        free(cells);
+    }
+
+    TEST(createCellGeometryTable) {
+        CellGeometryTable table;
+        for (int permitted = 1; permitted <= 3; permitted++) {
+            resetMemoryCounters(permitted - 1);
+            failAlloc = permitted == 1;
+            t_assert(H3_EXPORT(createCellGeometryTable)(1, &table) ==
+                         E_MEMORY_ALLOC,
+                     "createCellGeometryTable returns E_MEMORY_ALLOC");
+            t_assert(actualAllocCalls == permitted, "alloc called");
+            t_assert(actualFreeCalls == permitted - 1,
+                     "allocated memory freed");
+            t_assert(table.centers == NULL && table.verts == NULL,
+                     "no table on failure");
+        }
+
+        // Failing to shrink the vertexes keeps them at the maximum size
+        resetMemoryCounters(3);
+        t_assertSuccess(H3_EXPORT(createCellGeometryTable)(1, &table));
+        t_assert(actualAllocCalls == 4, "createCellGeometryTable shrank");
+        t_assert(actualFreeCalls == 0, "createCellGeometryTable kept all");
+        LatLng center;
+        t_assertSuccess(H3_EXPORT(cellToLatLngWithTable)(
+            &table, 0x8009fffffffffff, &center));
+
+        resetMemoryCounters(0);
+        H3_EXPORT(destroyCellGeometryTable)(&table);
+        t_assert(actualFreeCalls == 3, "destroy frees table");
+    }
+
+    TEST(compactCellSetOperation) {
+        H3Index cell = 0x85283473fffffff;
+        H3Index child;
+        t_assertSuccess(H3_EXPORT(cellToCenterChild)(cell, 8, &child));
+        int64_t size;
+
+        for (int permitted = 1; permitted <= 2; permitted++) {
+            resetMemoryCounters(permitted - 1);
+            failAlloc = permitted == 1;
+            t_assert(H3_EXPORT(compactCellSetOperationSize)(
+                         &cell, 1, &child, 1, CELL_SET_DIFFERENCE, &size) ==
+                         E_MEMORY_ALLOC,
+                     "compactCellSetOperationSize returns E_MEMORY_ALLOC");
+            t_assert(actualAllocCalls == permitted, "alloc called");
+            t_assert(actualFreeCalls == permitted - 1,
+                     "allocated memory freed");
+        }
+
+        resetMemoryCounters(0);
+        t_assertSuccess(H3_EXPORT(compactCellSetOperationSize)(
+            &cell, 1, &child, 1, CELL_SET_DIFFERENCE, &size));
+        t_assert(actualAllocCalls == 2, "alloc called for both sets");
+        t_assert(actualFreeCalls == 2, "scratch memory freed");
+    }
+
+    TEST(sortCells) {
+        int k = 5;
+        int64_t hexCount;
+        t_assertSuccess(H3_EXPORT(maxGridDiskSize)(k, &hexCount));
+        H3Index *cells = calloc(hexCount, sizeof(H3Index));
+        t_assertSuccess(H3_EXPORT(gridDisk)(sunnyvale, k, cells));
+
+        resetMemoryCounters(0);
+        failAlloc = true;
+        t_assert(H3_EXPORT(sortCells)(cells, hexCount) == E_MEMORY_ALLOC,
+                 "sortCells returns E_MEMORY_ALLOC");
+        t_assert(actualAllocCalls == 1, "alloc called");
+        t_assert(actualFreeCalls == 0, "free not called");
+
+        resetMemoryCounters(0);
+        t_assertSuccess(H3_EXPORT(sortCells)(cells, hexCount));
+        t_assert(actualAllocCalls == 1, "alloc called for scratch");
+        t_assert(actualFreeCalls == 1, "scratch freed");
+
+        // Small arrays are sorted without scratch memory
+        resetMemoryCounters(0);
+        t_assertSuccess(H3_EXPORT(sortCells)(cells, 7));
+        t_assert(actualAllocCalls == 0, "alloc not called");
+        free(cells);
+    }
 }
@@ -0,0 +1,124 @@
+/*
+ * Copyright 2023 Uber Technologies, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/** @file
+ * @brief tests the counters of a library built with H3_HOT_PATH_COUNTERS.
+ *
+ *  usage: `testHotPathCounters`
+ */
+
+#include <stdlib.h>
+
+#include "h3api.h"
+#include "test.h"
+#include "utility.h"
+
+H3Index sunnyvale = 0x89283470c27ffff;
+H3Index pentagon = 0x89080000003ffff;
+
+static LatLng sfVerts[] = {
+    {0.659966917655, -2.1364398519396},  {0.6595011102219, -2.1359434279405},
+    {0.6583348114025, -2.1354884206045}, {0.6581220034068, -2.1382437718946},
+    {0.6594479998527, -2.1384597563896}, {0.6599990002976, -2.1376771158464}};
+static GeoLoop sfGeoLoop = {.numVerts = 6, .verts = sfVerts};
+
+SUITE(hotPathCounters) {
+    TEST(reset) {
+        HotPathCounters counters;
+        H3Index cell;
+        LatLng point = {0.659966917655, -2.1364398519396};
+        t_assertSuccess(H3_EXPORT(latLngToCell)(&point, 9, &cell));
+        t_assertSuccess(H3_EXPORT(resetHotPathCounters)());
+        t_assertSuccess(H3_EXPORT(getHotPathCounters)(&counters));
+        t_assert(counters.neighborCalls == 0, "reset to zero");
+        t_assert(counters.polygonToCellsPointTests == 0, "reset to zero");
+        t_assert(counters.gridDiskFallbacks == 0, "reset to zero");
+    }
+
+    TEST(gridDisk) {
+        int k = 2;
+        int64_t size;
+        t_assertSuccess(H3_EXPORT(maxGridDiskSize)(k, &size));
+        H3Index *out = calloc(size, sizeof(H3Index));
+
+        HotPathCounters counters;
+        t_assertSuccess(H3_EXPORT(resetHotPathCounters)());
+        t_assertSuccess(H3_EXPORT(gridDisk)(sunnyvale, k, out));
+        t_assertSuccess(H3_EXPORT(getHotPathCounters)(&counters));
+        t_assert(counters.gridDiskFallbacks == 0, "hexagon does not fall back");
+        t_assert(counters.gridDiskSafeVisits == 0, "safe algorithm not used");
+        t_assert(counters.neighborCalls > 0, "neighbors were found");
+
+        for (int64_t i = 0; i < size; i++) {
+            out[i] = H3_NULL;
+        }
+        t_assertSuccess(H3_EXPORT(resetHotPathCounters)());
+        t_assertSuccess(H3_EXPORT(gridDisk)(pentagon, k, out));
+        t_assertSuccess(H3_EXPORT(getHotPathCounters)(&counters));
+        t_assert(counters.gridDiskFallbacks == 1, "pentagon falls back");
+        t_assert(counters.gridDiskSafeVisits >= size - 1,
+                 "safe algorithm visited every cell");
+        t_assert(counters.neighborPentagonAdjustments > 0,
+                 "crossed the deleted subsequence");
+        t_assert(counters.neighborRotations > 0, "rotated around pentagon");
+
+        free(out);
+    }
+
+    TEST(polygonToCells) {
+        GeoPolygon polygon = {.geoloop = sfGeoLoop};
+        int64_t size;
+        t_assertSuccess(
+            H3_EXPORT(maxPolygonToCellsSize)(&polygon, 9, 0, &size));
+        H3Index *out = calloc(size, sizeof(H3Index));
+
+        HotPathCounters counters;
+        t_assertSuccess(H3_EXPORT(resetHotPathCounters)());
+        t_assertSuccess(H3_EXPORT(polygonToCells)(&polygon, 9, 0, out));
+        t_assertSuccess(H3_EXPORT(getHotPathCounters)(&counters));
+
+        int64_t numCells = 0;
+        for (int64_t i = 0; i < size; i++) {
+            numCells += out[i] != H3_NULL;
+        }
+        t_assert(counters.polygonToCellsPointTests >= numCells,
+                 "every cell found was tested");
+        t_assert(counters.polygonToCellsRounds > 0, "search took rounds");
+
+        free(out);
+    }
+
+    TEST(compactCells) {
+        H3Index parent = 0x85283473fffffff;
+        int64_t numChildren;
+        t_assertSuccess(
+            H3_EXPORT(cellToChildrenSize)(parent, 7, &numChildren));
+        H3Index *children = calloc(numChildren, sizeof(H3Index));
+        H3Index *compacted = calloc(numChildren, sizeof(H3Index));
+        t_assertSuccess(H3_EXPORT(cellToChildren)(parent, 7, children));
+
+        HotPathCounters counters;
+        t_assertSuccess(H3_EXPORT(resetHotPathCounters)());
+        t_assertSuccess(
+            H3_EXPORT(compactCells)(children, compacted, numChildren));
+        t_assertSuccess(H3_EXPORT(getHotPathCounters)(&counters));
+        t_assert(compacted[0] == parent, "compacted to the parent");
+        t_assert(counters.compactCellsRounds >= 2,
+                 "one round per resolution compacted");
+
+        free(compacted);
+        free(children);
+    }
+}
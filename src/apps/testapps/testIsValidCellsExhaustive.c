@@ -0,0 +1,84 @@
+/*
+ * Copyright 2023 Uber Technologies, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/** @file
+ * @brief tests that isValidCells agrees with isValidCell on every cell of
+ *        coarse resolutions, and on variations of each with single bits
+ *        flipped, single digits changed, and other resolutions.
+ *
+ *  usage: `testIsValidCellsExhaustive`
+ */
+
+#include "constants.h"
+#include "h3Index.h"
+#include "h3api.h"
+#include "iterators.h"
+#include "test.h"
+#include "utility.h"
+
+/** Resolutions to test all cells of */
+#define MAX_EXHAUSTIVE_RES 4
+
+/** Variations of each cell: bit flips, digit changes, resolutions, itself */
+#define NUM_VARIATIONS \
+    (H3_NUM_BITS + MAX_H3_RES * (H3_DIGIT_MASK + 1) + MAX_H3_RES + 2)
+
+/**
+ * Checks isValidCells against isValidCell on variations of a cell. The
+ * variations are checked from several offsets, so that each is checked in
+ * the tail loop of the kernels as well as in their vector loop.
+ */
+static void isValidCells_assert(H3Index cell) {
+    H3Index variations[NUM_VARIATIONS];
+    int numVariations = 0;
+    variations[numVariations++] = cell;
+    for (int bit = 0; bit < H3_NUM_BITS; bit++) {
+        variations[numVariations++] = cell ^ ((H3Index)1 << bit);
+    }
+    for (int r = 1; r <= MAX_H3_RES; r++) {
+        for (Direction digit = CENTER_DIGIT; digit <= INVALID_DIGIT;
+             digit++) {
+            H3Index h = cell;
+            H3_SET_INDEX_DIGIT(h, r, digit);
+            variations[numVariations++] = h;
+        }
+    }
+    for (int res = 0; res <= MAX_H3_RES; res++) {
+        H3Index h = cell;
+        H3_SET_RESOLUTION(h, res);
+        variations[numVariations++] = h;
+    }
+
+    for (int offset = 0; offset < 8; offset++) {
+        int out[NUM_VARIATIONS];
+        t_assertSuccess(H3_EXPORT(isValidCells)(
+            &variations[offset], numVariations - offset, out));
+        for (int i = offset; i < numVariations; i++) {
+            t_assert(out[i - offset] == H3_EXPORT(isValidCell)(variations[i]),
+                     "isValidCells agrees with isValidCell");
+        }
+    }
+}
+
+SUITE(isValidCells) {
+    TEST(isValidCells_variations) {
+        for (int res = 0; res <= MAX_EXHAUSTIVE_RES; res++) {
+            for (IterCellsResolution iter = iterInitRes(res); iter.h;
+                 iterStepRes(&iter)) {
+                isValidCells_assert(iter.h);
+            }
+        }
+    }
+}
@@ -17,6 +17,7 @@
 #include <assert.h>
 #include <math.h>
 #include <stdlib.h>
+#include <string.h>
 
 #include "algos.h"
 #include "constants.h"
@@ -204,6 +205,51 @@ SUITE(polygonToCells) {
         free(hexagons);
     }
 
+    TEST(polygonToCellsWithWorkspace) {
+        PolygonToCellsWorkspace workspace = {0};
+        int64_t numHexagons;
+        t_assertSuccess(H3_EXPORT(maxPolygonToCellsSize)(&holeGeoPolygon, 9, 0,
+                                                         &numHexagons));
+        H3Index *expected = calloc(numHexagons, sizeof(H3Index));
+        H3Index *hexagons = calloc(numHexagons, sizeof(H3Index));
+        t_assertSuccess(
+            H3_EXPORT(polygonToCells)(&holeGeoPolygon, 9, 0, expected));
+
+        // Reuse the same workspace for different polygons and resolutions,
+        // including going back to a smaller one.
+        for (int round = 0; round < 2; round++) {
+            memset(hexagons, 0, numHexagons * sizeof(H3Index));
+            t_assertSuccess(H3_EXPORT(polygonToCellsWithWorkspace)(
+                &holeGeoPolygon, 9, 0, &workspace, hexagons));
+            for (int64_t i = 0; i < numHexagons; i++) {
+                t_assert(hexagons[i] == expected[i],
+                         "workspace output matches polygonToCells");
+            }
+
+            int64_t smallSize;
+            t_assertSuccess(H3_EXPORT(maxPolygonToCellsSize)(
+                &sfGeoPolygon, 7, 0, &smallSize));
+            H3Index *small = calloc(smallSize, sizeof(H3Index));
+            t_assertSuccess(H3_EXPORT(polygonToCellsWithWorkspace)(
+                &sfGeoPolygon, 7, 0, &workspace, small));
+            t_assert(countNonNullIndexes(small, smallSize) > 0,
+                     "filled smaller polygon with workspace");
+            free(small);
+        }
+        t_assert(workspace.capacity >= numHexagons, "workspace has grown");
+
+        t_assert(H3_EXPORT(polygonToCellsWithWorkspace)(
+                     &sfGeoPolygon, 9, 1, &workspace, hexagons) ==
+                     E_OPTION_INVALID,
+                 "invalid flags rejected with workspace");
+
+        H3_EXPORT(destroyPolygonToCellsWorkspace)(&workspace);
+        t_assert(workspace.search == NULL && workspace.capacity == 0,
+                 "workspace reset by destroy");
+        free(hexagons);
+        free(expected);
+    }
+
     TEST(polygonToCellsEmpty) {
         int64_t numHexagons;
         t_assertSuccess(H3_EXPORT(maxPolygonToCellsSize)(&emptyGeoPolygon, 9, 0,
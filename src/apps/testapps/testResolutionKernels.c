@@ -0,0 +1,162 @@
+/*
+ * Copyright 2023 Uber Technologies, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/** @file
+ * @brief tests the encoding and decoding kernels for each resolution against
+ * loops over the digits built from the functions in coordijk.c.
+ *
+ *  usage: `testResolutionKernels`
+ */
+
+#include "baseCells.h"
+#include "coordijk.h"
+#include "faceijk.h"
+#include "h3Index.h"
+#include "iterators.h"
+#include "resolutionKernels.h"
+#include "test.h"
+#include "utility.h"
+
+/**
+ * Sets the digits of h from ijk, one resolution at a time, and moves ijk to
+ * the base cell.
+ */
+static void referenceFaceIjkToDigits(CoordIJK *ijk, int res, H3Index *h) {
+    for (int r = res; r >= 1; r--) {
+        CoordIJK lastIJK = *ijk;
+        CoordIJK lastCenter;
+        if (isResolutionClassIII(r)) {
+            _upAp7(ijk);
+            lastCenter = *ijk;
+            _downAp7(&lastCenter);
+        } else {
+            _upAp7r(ijk);
+            lastCenter = *ijk;
+            _downAp7r(&lastCenter);
+        }
+        CoordIJK diff;
+        _ijkSub(&lastIJK, &lastCenter, &diff);
+        _ijkNormalize(&diff);
+        H3_SET_INDEX_DIGIT(*h, r, _unitIjkToDigit(&diff));
+    }
+}
+
+/**
+ * Moves ijk from the base cell to cell h, one resolution at a time.
+ */
+static void referenceDigitsToFaceIjk(H3Index h, int res, CoordIJK *ijk) {
+    for (int r = 1; r <= res; r++) {
+        if (isResolutionClassIII(r)) {
+            _downAp7(ijk);
+        } else {
+            _downAp7r(ijk);
+        }
+        _neighbor(ijk, H3_GET_INDEX_DIGIT(h, r));
+    }
+}
+
+/**
+ * Asserts that the kernels for res and the generic kernels encode ijk as
+ * the reference does.
+ */
+static void assertEncodes(const CoordIJK *ijk, int res) {
+    CoordIJK expectedIjk = *ijk;
+    H3Index expected = H3_INIT;
+    referenceFaceIjkToDigits(&expectedIjk, res, &expected);
+
+    CoordIJK specializedIjk = *ijk;
+    H3Index specialized = H3_INIT;
+    _resolutionKernels(res)->faceIjkToDigits(&specializedIjk, &specialized);
+    t_assert(specialized == expected, "specialized digits match");
+    t_assert(_ijkMatches(&specializedIjk, &expectedIjk),
+             "specialized base cell coordinates match");
+
+    CoordIJK genericIjk = *ijk;
+    H3Index generic = H3_INIT;
+    _faceIjkToDigitsGeneric(&genericIjk, res, &generic);
+    t_assert(generic == expected, "generic digits match");
+    t_assert(_ijkMatches(&genericIjk, &expectedIjk),
+             "generic base cell coordinates match");
+}
+
+/**
+ * Asserts that the kernels for the resolution of h and the generic kernels
+ * decode h as the reference does.
+ */
+static void assertDecodes(H3Index h) {
+    int res = H3_GET_RESOLUTION(h);
+    CoordIJK home = baseCellData[H3_GET_BASE_CELL(h)].homeFijk.coord;
+
+    CoordIJK expected = home;
+    referenceDigitsToFaceIjk(h, res, &expected);
+
+    CoordIJK specialized = home;
+    _resolutionKernels(res)->digitsToFaceIjk(h, &specialized);
+    t_assert(_ijkMatches(&specialized, &expected), "specialized matches");
+
+    CoordIJK generic = home;
+    _digitsToFaceIjkGeneric(h, res, &generic);
+    t_assert(_ijkMatches(&generic, &expected), "generic matches");
+}
+
+SUITE(resolutionKernels) {
+    TEST(encodeRandomPoints) {
+        for (int i = 0; i < 1000; i++) {
+            LatLng point;
+            randomGeo(&point);
+            for (int res = 0; res <= MAX_H3_RES; res++) {
+                FaceIJK fijk;
+                _geoToFaceIjk(&point, res, &fijk);
+                assertEncodes(&fijk.coord, res);
+            }
+        }
+    }
+
+    TEST(encodeNegativeCoordinates) {
+        // Coordinates off the face, as given when encoding overages
+        for (int i = -20; i <= 20; i++) {
+            for (int j = -20; j <= 20; j++) {
+                CoordIJK ijk = {i, j, 0};
+                for (int res = 0; res <= MAX_H3_RES; res++) {
+                    assertEncodes(&ijk, res);
+                }
+            }
+        }
+    }
+
+    TEST(decodeAllCellsToRes3) {
+        for (int res = 0; res <= 3; res++) {
+            for (IterCellsResolution iter = iterInitRes(res); iter.h;
+                 iterStepRes(&iter)) {
+                assertDecodes(iter.h);
+            }
+        }
+    }
+
+    TEST(decodeRandomPoints) {
+        for (int i = 0; i < 1000; i++) {
+            LatLng point;
+            randomGeo(&point);
+            for (int res = 0; res <= MAX_H3_RES; res++) {
+                H3Index h;
+                t_assertSuccess(H3_EXPORT(latLngToCell)(&point, res, &h));
+                assertDecodes(h);
+                // Invalid digits are skipped
+                H3_SET_INDEX_DIGIT(h, MAX_H3_RES, INVALID_DIGIT);
+                assertDecodes(h);
+            }
+        }
+    }
+}
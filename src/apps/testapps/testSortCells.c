@@ -0,0 +1,127 @@
+/*
+ * Copyright 2023 Uber Technologies, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/** @file
+ * @brief tests H3 functions `sortCells` and `dedupSortedCells`
+ *
+ *  usage: `testSortCells`
+ */
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "h3api.h"
+#include "test.h"
+#include "utility.h"
+
+static int compareCells(const void *a, const void *b) {
+    H3Index cellA = *(const H3Index *)a;
+    H3Index cellB = *(const H3Index *)b;
+    return cellA < cellB ? -1 : cellA > cellB;
+}
+
+/** Checks sortCells against qsort */
+static void sort_assertions(const H3Index *cells, int64_t numCells) {
+    H3Index *sorted = calloc(numCells + 1, sizeof(H3Index));
+    H3Index *expected = calloc(numCells + 1, sizeof(H3Index));
+    memcpy(sorted, cells, numCells * sizeof(H3Index));
+    memcpy(expected, cells, numCells * sizeof(H3Index));
+    qsort(expected, numCells, sizeof(H3Index), compareCells);
+
+    t_assertSuccess(H3_EXPORT(sortCells)(sorted, numCells));
+    for (int64_t i = 0; i < numCells; i++) {
+        t_assert(sorted[i] == expected[i], "sorted like qsort");
+    }
+    free(expected);
+    free(sorted);
+}
+
+SUITE(sortCells) {
+    TEST(gridDisk) {
+        // Sizes on both sides of the insertion sort cutoff
+        int ks[] = {0, 1, 4, 5, 30};
+        for (size_t i = 0; i < sizeof(ks) / sizeof(ks[0]); i++) {
+            int64_t numCells;
+            t_assertSuccess(H3_EXPORT(maxGridDiskSize)(ks[i], &numCells));
+            H3Index *cells = calloc(numCells, sizeof(H3Index));
+            t_assertSuccess(
+                H3_EXPORT(gridDisk)(0x89283080ddbffff, ks[i], cells));
+            sort_assertions(cells, numCells);
+            free(cells);
+        }
+    }
+
+    TEST(pentagonDiskWithNulls) {
+        // A disk around a pentagon has H3_NULL gaps
+        int64_t numCells;
+        t_assertSuccess(H3_EXPORT(maxGridDiskSize)(10, &numCells));
+        H3Index *cells = calloc(numCells, sizeof(H3Index));
+        H3Index pentagon;
+        t_assertSuccess(H3_EXPORT(cellToCenterChild)(0x8009fffffffffff, 7,
+                                                     &pentagon));
+        t_assertSuccess(H3_EXPORT(gridDisk)(pentagon, 10, cells));
+        sort_assertions(cells, numCells);
+        free(cells);
+    }
+
+    TEST(mixedValues) {
+        // Every byte varies, including the high bytes
+        int64_t numCells = 1000;
+        H3Index *cells = calloc(numCells, sizeof(H3Index));
+        uint64_t state = 12345;
+        for (int64_t i = 0; i < numCells; i++) {
+            state = state * 6364136223846793005ULL + 1442695040888963407ULL;
+            cells[i] = state;
+        }
+        sort_assertions(cells, numCells);
+        free(cells);
+    }
+
+    TEST(constant) {
+        H3Index cells[100];
+        for (int i = 0; i < 100; i++) {
+            cells[i] = 0x89283080ddbffff;
+        }
+        t_assertSuccess(H3_EXPORT(sortCells)(cells, 100));
+        for (int i = 0; i < 100; i++) {
+            t_assert(cells[i] == 0x89283080ddbffff, "constant array unchanged");
+        }
+        t_assertSuccess(H3_EXPORT(sortCells)(NULL, 0));
+    }
+
+    TEST(dedupSortedCells) {
+        H3Index cells[] = {0, 0, 0x85283473fffffff, 0x85283473fffffff,
+                           0x852834777ffffff, 0x89283080ddbffff,
+                           0x89283080ddbffff};
+        int64_t numUnique;
+        t_assertSuccess(H3_EXPORT(dedupSortedCells)(cells, 7, &numUnique));
+        t_assert(numUnique == 3, "repeats and H3_NULL removed");
+        t_assert(cells[0] == 0x85283473fffffff, "first unique cell");
+        t_assert(cells[1] == 0x852834777ffffff, "second unique cell");
+        t_assert(cells[2] == 0x89283080ddbffff, "third unique cell");
+
+        t_assertSuccess(H3_EXPORT(dedupSortedCells)(NULL, 0, &numUnique));
+        t_assert(numUnique == 0, "empty array");
+
+        H3Index unsorted[] = {0x852834777ffffff, 0x85283473fffffff,
+                              0x85283473fffffff};
+        t_assert(H3_EXPORT(dedupSortedCells)(unsorted, 3, &numUnique) ==
+                     E_DOMAIN,
+                 "unsorted array fails");
+        t_assert(unsorted[1] == 0x85283473fffffff &&
+                     unsorted[2] == 0x85283473fffffff,
+                 "unsorted array not modified");
+    }
+}
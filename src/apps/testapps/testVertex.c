@@ -203,4 +203,98 @@ SUITE(Vertex) {
         t_assert(H3_EXPORT(cellToVertexes)(invalid, verts) == E_FAILED,
                  "cellToVertexes fails for invalid cell");
     }
+
+    TEST(cellsToVertexes) {
+        // Pentagon and its first ring, plus a null entry and a duplicate
+        H3Index cells[8] = {0};
+        t_assertSuccess(H3_EXPORT(gridDisk)(0x85080003fffffff, 1, cells));
+        cells[7] = cells[0];
+        int64_t numCells = 8;
+
+        int64_t maxVertexes;
+        t_assertSuccess(
+            H3_EXPORT(maxCellsToVertexesSize)(numCells, &maxVertexes));
+        t_assert(maxVertexes == 48, "expected max vertex count");
+        H3Index *vertexes = calloc(maxVertexes, sizeof(H3Index));
+        int64_t cellVertexes[8 * NUM_HEX_VERTS];
+        int64_t numVertexes;
+        t_assertSuccess(H3_EXPORT(cellsToVertexes)(cells, numCells, vertexes,
+                                                   &numVertexes, cellVertexes));
+        // 5 pentagon vertexes, plus 4 more outer vertexes on each of the 5
+        // hexagons minus the 5 shared between neighboring hexagons
+        t_assert(numVertexes == 5 + 5 * 4 - 5, "expected vertex count");
+
+        for (int64_t i = 0; i < numCells; i++) {
+            H3Index expected[NUM_HEX_VERTS] = {0};
+            if (cells[i] != H3_NULL) {
+                t_assertSuccess(H3_EXPORT(cellToVertexes)(cells[i], expected));
+            }
+            for (int v = 0; v < NUM_HEX_VERTS; v++) {
+                int64_t pos = cellVertexes[i * NUM_HEX_VERTS + v];
+                if (expected[v] == H3_NULL) {
+                    t_assert(pos == -1, "unused slot is -1");
+                } else {
+                    t_assert(vertexes[pos] == expected[v],
+                             "vertex matches cellToVertexes");
+                }
+            }
+        }
+        for (int64_t a = 0; a < numVertexes; a++) {
+            for (int64_t b = a + 1; b < numVertexes; b++) {
+                t_assert(vertexes[a] != vertexes[b], "vertexes are unique");
+            }
+        }
+        free(vertexes);
+    }
+
+    TEST(cellsToVertexes_invalid) {
+        H3Index cells[] = {0xFFFFFFFFFFFFFFFF};
+        H3Index vertexes[6];
+        int64_t cellVertexes[6];
+        int64_t numVertexes;
+        t_assert(H3_EXPORT(cellsToVertexes)(cells, 1, vertexes, &numVertexes,
+                                            cellVertexes) == E_FAILED,
+                 "cellsToVertexes fails for invalid cell");
+        t_assert(H3_EXPORT(cellsToVertexes)(cells, -1, vertexes, &numVertexes,
+                                            cellVertexes) == E_DOMAIN,
+                 "cellsToVertexes fails for negative count");
+    }
+
+    TEST(cellsToVertexMesh) {
+        H3Index cells[19] = {0};
+        t_assertSuccess(H3_EXPORT(gridDisk)(0x89283080ddbffff, 2, cells));
+        int64_t numCells = 19;
+        H3Index vertexes[19 * NUM_HEX_VERTS];
+        LatLng coords[19 * NUM_HEX_VERTS];
+        int64_t cellVertexes[19 * NUM_HEX_VERTS];
+        int64_t numVertexes;
+        t_assertSuccess(H3_EXPORT(cellsToVertexMesh)(
+            cells, numCells, vertexes, coords, &numVertexes, cellVertexes));
+        // 19 cells in 3 rings: 6 * 19 vertexes minus those shared
+        t_assert(numVertexes == 54, "expected vertex count");
+
+        for (int64_t i = 0; i < numVertexes; i++) {
+            LatLng expected;
+            t_assertSuccess(H3_EXPORT(vertexToLatLng)(vertexes[i], &expected));
+            t_assert(coords[i].lat == expected.lat &&
+                         coords[i].lng == expected.lng,
+                     "coordinates match vertexToLatLng");
+        }
+        for (int64_t i = 0; i < numCells; i++) {
+            CellBoundary boundary;
+            t_assertSuccess(H3_EXPORT(cellToBoundary)(cells[i], &boundary));
+            t_assert(boundary.numVerts == NUM_HEX_VERTS, "no distortion");
+            for (int v = 0; v < NUM_HEX_VERTS; v++) {
+                LatLng *coord = &coords[cellVertexes[i * NUM_HEX_VERTS + v]];
+                t_assert(geoAlmostEqual(coord, &boundary.verts[v]),
+                         "mesh vertex matches boundary vertex");
+            }
+        }
+
+        H3Index invalid[] = {0xFFFFFFFFFFFFFFFF};
+        t_assert(H3_EXPORT(cellsToVertexMesh)(invalid, 1, vertexes, coords,
+                                              &numVertexes,
+                                              cellVertexes) == E_FAILED,
+                 "cellsToVertexMesh fails for invalid cell");
+    }
 }
@@ -103,6 +103,50 @@ static void cellToVertex_neighbor_assertions(H3Index h3) {
     }
 }
 
+static H3Index *allCells;
+static int64_t allCellsCount;
+
+static void collectCell(H3Index h3) { allCells[allCellsCount++] = h3; }
+
+static void cellsToVertexes_assertions(int res) {
+    int64_t numCells;
+    t_assertSuccess(H3_EXPORT(getNumCells)(res, &numCells));
+    allCells = calloc(numCells, sizeof(H3Index));
+    allCellsCount = 0;
+    iterateAllIndexesAtRes(res, collectCell);
+    t_assert(allCellsCount == numCells, "collected all cells");
+
+    int64_t maxVertexes;
+    t_assertSuccess(H3_EXPORT(maxCellsToVertexesSize)(numCells, &maxVertexes));
+    H3Index *vertexes = calloc(maxVertexes, sizeof(H3Index));
+    int64_t *cellVertexes = calloc(numCells * NUM_HEX_VERTS, sizeof(int64_t));
+    int64_t numVertexes;
+    t_assertSuccess(H3_EXPORT(cellsToVertexes)(allCells, numCells, vertexes,
+                                               &numVertexes, cellVertexes));
+
+    // Every vertex of the sphere is shared by three cells
+    t_assert(numVertexes == 2 * numCells - 4, "got expected vertex count");
+
+    for (int64_t i = 0; i < numCells; i++) {
+        H3Index expected[NUM_HEX_VERTS] = {0};
+        t_assertSuccess(H3_EXPORT(cellToVertexes)(allCells[i], expected));
+        for (int v = 0; v < NUM_HEX_VERTS; v++) {
+            int64_t pos = cellVertexes[i * NUM_HEX_VERTS + v];
+            if (expected[v] == H3_NULL) {
+                t_assert(pos == -1, "no vertex for missing pentagon vertex");
+            } else {
+                t_assert(pos >= 0 && pos < numVertexes, "position in range");
+                t_assert(vertexes[pos] == expected[v],
+                         "cellsToVertexes matches cellToVertexes");
+            }
+        }
+    }
+
+    free(cellVertexes);
+    free(vertexes);
+    free(allCells);
+}
+
 SUITE(Vertex) {
     TEST(directionForVertexNum_symmetry) {
         iterateAllIndexesAtRes(0, directionForVertexNum_symmetry_assertions);
@@ -150,4 +194,11 @@ SUITE(Vertex) {
         iterateAllIndexesAtRes(3, cellToVertex_validity_assertions);
         iterateAllIndexesAtRes(4, cellToVertex_validity_assertions);
     }
+
+    TEST(cellsToVertexes_allCells) {
+        cellsToVertexes_assertions(0);
+        cellsToVertexes_assertions(1);
+        cellsToVertexes_assertions(2);
+        cellsToVertexes_assertions(3);
+    }
 }
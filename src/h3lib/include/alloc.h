@@ -27,23 +27,38 @@
 #include "h3api.h"  // for TJOIN
 
 #ifdef H3_ALLOC_PREFIX
-#define H3_MEMORY(name) TJOIN(H3_ALLOC_PREFIX, name)
+#define H3_BASE_MEMORY(name) TJOIN(H3_ALLOC_PREFIX, name)
 
 #ifdef __cplusplus
 extern "C" {
 #endif
 
-void *H3_MEMORY(malloc)(size_t size);
-void *H3_MEMORY(calloc)(size_t num, size_t size);
-void *H3_MEMORY(realloc)(void *ptr, size_t size);
-void H3_MEMORY(free)(void *ptr);
+void *H3_BASE_MEMORY(malloc)(size_t size);
+void *H3_BASE_MEMORY(calloc)(size_t num, size_t size);
+void *H3_BASE_MEMORY(realloc)(void *ptr, size_t size);
+void H3_BASE_MEMORY(free)(void *ptr);
 
 #ifdef __cplusplus
 }
 #endif
 
 #else
-#define H3_MEMORY(name) name
+#define H3_BASE_MEMORY(name) name
+#endif
+
+#ifdef H3_ALLOCATION_STATS
+/*
+ * Allocations are counted by the functions in allocationStats.c, which call
+ * the allocators above.
+ */
+#define H3_MEMORY(name) TJOIN(_counted_, name)
+
+void *H3_MEMORY(malloc)(size_t size);
+void *H3_MEMORY(calloc)(size_t num, size_t size);
+void *H3_MEMORY(realloc)(void *ptr, size_t size);
+void H3_MEMORY(free)(void *ptr);
+#else
+#define H3_MEMORY(name) H3_BASE_MEMORY(name)
 #endif
 
 #endif
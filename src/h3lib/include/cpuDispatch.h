@@ -0,0 +1,70 @@
+/*
+ * Copyright 2023 Uber Technologies, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/** @file cpuDispatch.h
+ * @brief   Selection of kernels specialized for the features of the CPU
+ *
+ * Kernels are inner loops over arrays that have a portable scalar version
+ * and may have versions that use instruction set extensions. The CPU is
+ * detected on first use, and each kernel is called through the table for
+ * the best level the CPU supports. Building with H3_CPU_LEVEL defined to
+ * a CpuLevel pins the level, or the best level below it that the CPU
+ * supports.
+ */
+
+#ifndef CPU_DISPATCH_H
+#define CPU_DISPATCH_H
+
+#include <stdint.h>
+
+#include "h3api.h"
+
+/*
+ * Versions using instruction set extensions are built where the compiler
+ * can target them function by function.
+ */
+#if (defined(__x86_64__) || defined(__i386__)) && \
+    (defined(__GNUC__) || defined(__clang__))
+#define H3_HAVE_X86_KERNELS 1
+#endif
+
+/** Levels of CPU features that kernels are specialized for */
+typedef enum {
+    /** Portable C */
+    CPU_LEVEL_SCALAR = 0,
+    /** x86 AVX2 */
+    CPU_LEVEL_AVX2 = 1,
+    /** x86 AVX-512 Foundation */
+    CPU_LEVEL_AVX512 = 2,
+    /** Number of levels */
+    NUM_CPU_LEVELS = 3
+} CpuLevel;
+
+/** Kernels, as specialized for one CPU level */
+typedef struct {
+    /** See isValidCells */
+    void (*isValidCells)(const H3Index *cells, int64_t numCells, int *out);
+} Kernels;
+
+CpuLevel _cpuLevel(void);
+const Kernels *_kernels(void);
+
+void _isValidCellsScalar(const H3Index *cells, int64_t numCells, int *out);
+#ifdef H3_HAVE_X86_KERNELS
+void _isValidCellsAvx2(const H3Index *cells, int64_t numCells, int *out);
+void _isValidCellsAvx512(const H3Index *cells, int64_t numCells, int *out);
+#endif
+
+#endif
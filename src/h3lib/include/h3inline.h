@@ -0,0 +1,103 @@
+/*
+ * Copyright 2023 Uber Technologies, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/** @file h3inline.h
+ * @brief   Inline accessors for the bit fields of an H3Index.
+ *
+ * This file defines `static inline` versions of the H3 functions that only
+ * read or mask the bits of an index, so that callers can inline them into
+ * loops over many indexes instead of calling into the library for each one.
+ * They are part of the public API and follow the same versioning as the
+ * functions in h3api.h. The exported functions, such as getResolution and
+ * isPentagon, remain and return the same results.
+ *
+ * Like the exported functions, these do not validate their input: the
+ * result for an index that is not a valid cell is unspecified unless
+ * documented otherwise.
+ */
+
+#ifndef H3INLINE_H
+#define H3INLINE_H
+
+#include "h3api.h"
+
+/*
+ * H3 is compiled as C, not C++ code. `extern "C"` is needed for C++ code
+ * to be able to use the library.
+ */
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Version of the functions in this file, increased when any are added */
+#define H3_INLINE_VERSION 1
+
+/** @brief returns the resolution of an index. The same as getResolution.
+ * Works on both cells and directed edges. */
+static inline int h3GetResolution(H3Index h) { return (int)((h >> 52) & 15); }
+
+/** @brief returns the base cell "number" (0 to 121) of an index. The same as
+ * getBaseCellNumber. */
+static inline int h3GetBaseCell(H3Index h) { return (int)((h >> 45) & 127); }
+
+/** @brief returns the mode of an index: 1 for a cell, 2 for a directed edge,
+ * or 4 for a vertex */
+static inline int h3GetMode(H3Index h) { return (int)((h >> 59) & 15); }
+
+/** @brief returns the digit (0 to 6, or 7 when unused) of an index at a
+ * resolution from 1 to MAX_H3_RES. The digit is the child of the cell at the
+ * previous resolution that the index is within. */
+static inline int h3GetIndexDigit(H3Index h, int res) {
+    return (int)((h >> (3 * (15 - res))) & 7);
+}
+
+/** @brief returns the parent of a cell at parentRes, or H3_NULL if parentRes
+ * is not between 0 and the resolution of the cell. The same as cellToParent
+ * for valid cells. */
+static inline H3Index h3CellToParent(H3Index h, int parentRes) {
+    int res = h3GetResolution(h);
+    if (parentRes < 0 || parentRes > res) {
+        return H3_NULL;
+    }
+    // Set the resolution, and set the digits after it to 7
+    uint64_t unusedDigits = (UINT64_C(1) << (3 * (15 - parentRes))) - 1;
+    return ((h & ~(UINT64_C(15) << 52)) | ((uint64_t)parentRes << 52)) |
+           unusedDigits;
+}
+
+/** @brief determines if a cell is Class III (or Class II). The same as
+ * isResClassIII. */
+static inline int h3IsResClassIII(H3Index h) { return h3GetResolution(h) & 1; }
+
+/** @brief determines if a cell is a pentagon. The same as isPentagon. */
+static inline int h3IsPentagon(H3Index h) {
+    // Pentagon base cells, as a bit set split into cells below 64 and the rest
+    const uint64_t pentagonsLow = UINT64_C(0x8402004001004010);
+    const uint64_t pentagonsHigh = UINT64_C(0x20080200080100);
+    int baseCell = h3GetBaseCell(h);
+    uint64_t isPentagonBaseCell =
+        (baseCell < 64 ? pentagonsLow : pentagonsHigh) >> (baseCell & 63);
+    // All digits up to the resolution of a pentagon are 0
+    uint64_t unusedDigits =
+        (UINT64_C(1) << (3 * (15 - h3GetResolution(h)))) - 1;
+    uint64_t digits = h & UINT64_C(0x1fffffffffff) & ~unusedDigits;
+    return (int)(isPentagonBaseCell & 1) && digits == 0;
+}
+
+#ifdef __cplusplus
+}  // extern "C"
+#endif
+
+#endif
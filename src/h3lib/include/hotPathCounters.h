@@ -0,0 +1,45 @@
+/*
+ * Copyright 2023 Uber Technologies, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/** @file hotPathCounters.h
+ * @brief   Counters of work done in the inner loops of the core algorithms
+ *
+ * H3_COUNT and H3_COUNT_N add to a field of HotPathCounters in builds with
+ * H3_HOT_PATH_COUNTERS defined, and compile to nothing otherwise, so they
+ * can be placed in inner loops.
+ */
+
+#ifndef HOT_PATH_COUNTERS_H
+#define HOT_PATH_COUNTERS_H
+
+#include "h3api.h"
+
+#ifdef H3_HOT_PATH_COUNTERS
+
+extern HotPathCounters _hotPathCounters;
+
+/** Adds one to a counter */
+#define H3_COUNT(counter) (_hotPathCounters.counter++)
+/** Adds n to a counter */
+#define H3_COUNT_N(counter, n) (_hotPathCounters.counter += (n))
+
+#else
+
+#define H3_COUNT(counter) ((void)0)
+#define H3_COUNT_N(counter, n) ((void)0)
+
+#endif
+
+#endif
@@ -0,0 +1,150 @@
+/*
+ * Copyright 2023 Uber Technologies, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/** @file
+ * @brief Include file for the kernels of one resolution. This includes the
+ *        encoding and decoding steps for each digit up to RES, unrolled so
+ *        that the class of each resolution and the offset of each digit
+ *        are constants. This file is intended to be included inline in a
+ *        file that defines RES as a resolution literal, and the static
+ *        functions _encodeDigit and _decodeDigit.
+ */
+
+#include "coordijk.h"
+#include "h3api.h"
+
+#ifndef RES
+#error "RES must be defined before including this header"
+#endif
+
+#define RES_ALGO_XTJOIN(a, b) a##b
+#define RES_ALGO_TJOIN(a, b) RES_ALGO_XTJOIN(a, b)
+#define RES_ALGO(func) RES_ALGO_TJOIN(func, RES_ALGO_TJOIN(Res, RES))
+
+/**
+ * faceIjkToDigits for resolution RES. Digits are found from the finest
+ * resolution up.
+ * @param ijk The IJK+ coordinates of the cell, replaced with those of the
+ *            base cell
+ * @param h   The index whose digits are set
+ */
+void RES_ALGO(_faceIjkToDigits)(CoordIJK *ijk, H3Index *h) {
+#if RES >= 15
+    _encodeDigit(ijk, 15, h);
+#endif
+#if RES >= 14
+    _encodeDigit(ijk, 14, h);
+#endif
+#if RES >= 13
+    _encodeDigit(ijk, 13, h);
+#endif
+#if RES >= 12
+    _encodeDigit(ijk, 12, h);
+#endif
+#if RES >= 11
+    _encodeDigit(ijk, 11, h);
+#endif
+#if RES >= 10
+    _encodeDigit(ijk, 10, h);
+#endif
+#if RES >= 9
+    _encodeDigit(ijk, 9, h);
+#endif
+#if RES >= 8
+    _encodeDigit(ijk, 8, h);
+#endif
+#if RES >= 7
+    _encodeDigit(ijk, 7, h);
+#endif
+#if RES >= 6
+    _encodeDigit(ijk, 6, h);
+#endif
+#if RES >= 5
+    _encodeDigit(ijk, 5, h);
+#endif
+#if RES >= 4
+    _encodeDigit(ijk, 4, h);
+#endif
+#if RES >= 3
+    _encodeDigit(ijk, 3, h);
+#endif
+#if RES >= 2
+    _encodeDigit(ijk, 2, h);
+#endif
+#if RES >= 1
+    _encodeDigit(ijk, 1, h);
+#else
+    (void)ijk;
+    (void)h;
+#endif
+}
+
+/**
+ * digitsToFaceIjk for resolution RES. Digits are applied from the coarsest
+ * resolution down.
+ * @param h   The index whose digits are applied
+ * @param ijk The IJK+ coordinates of the base cell, replaced with those of
+ *            the cell
+ */
+void RES_ALGO(_digitsToFaceIjk)(H3Index h, CoordIJK *ijk) {
+#if RES >= 1
+    _decodeDigit(h, 1, ijk);
+#else
+    (void)h;
+    (void)ijk;
+#endif
+#if RES >= 2
+    _decodeDigit(h, 2, ijk);
+#endif
+#if RES >= 3
+    _decodeDigit(h, 3, ijk);
+#endif
+#if RES >= 4
+    _decodeDigit(h, 4, ijk);
+#endif
+#if RES >= 5
+    _decodeDigit(h, 5, ijk);
+#endif
+#if RES >= 6
+    _decodeDigit(h, 6, ijk);
+#endif
+#if RES >= 7
+    _decodeDigit(h, 7, ijk);
+#endif
+#if RES >= 8
+    _decodeDigit(h, 8, ijk);
+#endif
+#if RES >= 9
+    _decodeDigit(h, 9, ijk);
+#endif
+#if RES >= 10
+    _decodeDigit(h, 10, ijk);
+#endif
+#if RES >= 11
+    _decodeDigit(h, 11, ijk);
+#endif
+#if RES >= 12
+    _decodeDigit(h, 12, ijk);
+#endif
+#if RES >= 13
+    _decodeDigit(h, 13, ijk);
+#endif
+#if RES >= 14
+    _decodeDigit(h, 14, ijk);
+#endif
+#if RES >= 15
+    _decodeDigit(h, 15, ijk);
+#endif
+}
@@ -0,0 +1,52 @@
+/*
+ * Copyright 2023 Uber Technologies, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/** @file resolutionKernels.h
+ * @brief   Encoding and decoding kernels specialized for each resolution
+ *
+ * Converting between a cell and its IJK+ coordinates on a face takes one
+ * step per resolution digit. The kernels for each resolution are generated
+ * from resolutionAlgos.h with the steps unrolled, and are looked up by
+ * resolution in a table. The generic versions loop over the digits, and
+ * are kept as the reference for tests and benchmarks.
+ */
+
+#ifndef RESOLUTION_KERNELS_H
+#define RESOLUTION_KERNELS_H
+
+#include "constants.h"
+#include "coordijk.h"
+#include "h3api.h"
+
+/** Kernels, as specialized for one resolution */
+typedef struct {
+    /**
+     * Sets the digits of h from the IJK+ coordinates of a cell on a face,
+     * and replaces the coordinates with those of the base cell.
+     */
+    void (*faceIjkToDigits)(CoordIJK *ijk, H3Index *h);
+    /**
+     * Moves IJK+ coordinates, initialized to those of the base cell, to
+     * those of cell h on the same face.
+     */
+    void (*digitsToFaceIjk)(H3Index h, CoordIJK *ijk);
+} ResolutionKernels;
+
+DECLSPEC const ResolutionKernels *_resolutionKernels(int res);
+
+DECLSPEC void _faceIjkToDigitsGeneric(CoordIJK *ijk, int res, H3Index *h);
+DECLSPEC void _digitsToFaceIjkGeneric(H3Index h, int res, CoordIJK *ijk);
+
+#endif
@@ -33,6 +33,7 @@
 #include "h3Assert.h"
 #include "h3Index.h"
 #include "h3api.h"
+#include "hotPathCounters.h"
 #include "latLng.h"
 #include "linkedGeo.h"
 #include "polygon.h"
@@ -224,6 +225,7 @@ H3Error H3_EXPORT(gridDiskDistances)(H3Index origin, int k, H3Index *out,
     const H3Error failed =
         H3_EXPORT(gridDiskDistancesUnsafe)(origin, k, out, distances);
     if (failed) {
+        H3_COUNT(gridDiskFallbacks);
         int64_t maxIdx;
         H3Error err = H3_EXPORT(maxGridDiskSize)(k, &maxIdx);
         if (err) {
@@ -271,9 +273,11 @@ H3Error H3_EXPORT(gridDiskDistances)(H3Index origin, int k, H3Index *out,
  */
 H3Error _gridDiskDistancesInternal(H3Index origin, int k, H3Index *out,
                                    int *distances, int64_t maxIdx, int curK) {
+    H3_COUNT(gridDiskSafeVisits);
     // Put origin in the output array. out is used as a hash set.
     int64_t off = origin % maxIdx;
     while (out[off] != 0 && out[off] != origin) {
+        H3_COUNT(gridDiskSafeProbes);
         off = (off + 1) % maxIdx;
     }
 
@@ -356,9 +360,11 @@ H3Error h3NeighborRotations(H3Index origin, Direction dir, int *rotations,
     if (dir < CENTER_DIGIT || dir >= INVALID_DIGIT) {
         return E_FAILED;
     }
+    H3_COUNT(neighborCalls);
     // Ensure that rotations is modulo'd by 6 before any possible addition,
     // to protect against signed integer overflow.
     *rotations = *rotations % 6;
+    H3_COUNT_N(neighborRotations, *rotations);
     for (int i = 0; i < *rotations; i++) {
         dir = _rotate60ccw(dir);
     }
@@ -388,6 +394,7 @@ H3Error h3NeighborRotations(H3Index origin, Direction dir, int *rotations,
 
                 // perform the adjustment for the k-subsequence we're skipping
                 // over.
+                H3_COUNT(neighborRotations);
                 current = _h3Rotate60ccw(current);
                 *rotations = *rotations + 1;
             }
@@ -424,6 +431,7 @@ H3Error h3NeighborRotations(H3Index origin, Direction dir, int *rotations,
 
         // force rotation out of missing k-axes sub-sequence
         if (_h3LeadingNonZeroDigit(current) == K_AXES_DIGIT) {
+            H3_COUNT(neighborPentagonAdjustments);
             if (oldBaseCell != newBaseCell) {
                 // in this case, we traversed into the deleted
                 // k subsequence of a pentagon base cell.
@@ -434,10 +442,12 @@ H3Error h3NeighborRotations(H3Index origin, Direction dir, int *rotations,
                 if (ALWAYS(_baseCellIsCwOffset(
                         newBaseCell,
                         baseCellData[oldBaseCell].homeFijk.face))) {
+                    H3_COUNT(neighborRotations);
                     current = _h3Rotate60cw(current);
                 } else {
                     // See cwOffsetPent in testGridDisk.c for why this is
                     // unreachable.
+                    H3_COUNT(neighborRotations);
                     current = _h3Rotate60ccw(current);
                 }
                 alreadyAdjustedKSubsequence = 1;
@@ -452,12 +462,14 @@ H3Error h3NeighborRotations(H3Index origin, Direction dir, int *rotations,
                     // Rotate out of the deleted k subsequence
                     // We also need an additional change to the direction we're
                     // moving in
+                    H3_COUNT(neighborRotations);
                     current = _h3Rotate60ccw(current);
                     *rotations = *rotations + 1;
                 } else if (oldLeadingDigit == IK_AXES_DIGIT) {
                     // Rotate out of the deleted k subsequence
                     // We also need an additional change to the direction we're
                     // moving in
+                    H3_COUNT(neighborRotations);
                     current = _h3Rotate60cw(current);
                     *rotations = *rotations + 5;
                 } else {
@@ -467,6 +479,7 @@ H3Error h3NeighborRotations(H3Index origin, Direction dir, int *rotations,
             }
         }
 
+        H3_COUNT_N(neighborRotations, newRotations);
         for (int i = 0; i < newRotations; i++)
             current = _h3RotatePent60ccw(current);
 
@@ -488,6 +501,7 @@ H3Error h3NeighborRotations(H3Index origin, Direction dir, int *rotations,
             }
         }
     } else {
+        H3_COUNT_N(neighborRotations, newRotations);
         for (int i = 0; i < newRotations; i++)
             current = _h3Rotate60ccw(current);
     }
@@ -859,6 +873,7 @@ H3Error _getEdgeHexagons(const GeoLoop *geoloop, int64_t numHexagons, int res,
                 if (found[loc] == pointHex)
                     break;  // At least two points of the geoloop index to the
                             // same cell
+                H3_COUNT(polygonToCellsProbes);
                 loc = (loc + 1) % numHexagons;
                 loopCount++;
             }
@@ -874,6 +889,84 @@ H3Error _getEdgeHexagons(const GeoLoop *geoloop, int64_t numHexagons, int res,
     return E_SUCCESS;
 }
 
+/**
+ * Ensures the workspace scratch buffers can hold the bounding boxes for
+ * `numBBoxes` loops and `numHexagons` cells. Buffers are only reallocated when
+ * they are too small, and their previous contents are not preserved.
+ *
+ * @param workspace The workspace to grow
+ * @param numBBoxes Number of bounding boxes needed
+ * @param numHexagons Number of cells needed in the search and found buffers
+ * @return E_SUCCESS, or E_MEMORY_ALLOC if an allocation failed. On failure the
+ * workspace remains valid and may be destroyed or reused.
+ */
+static H3Error _reservePolygonToCellsWorkspace(
+    PolygonToCellsWorkspace *workspace, int numBBoxes, int64_t numHexagons) {
+    if (workspace->bboxesCapacity < numBBoxes) {
+        if (workspace->bboxes) {
+            H3_MEMORY(free)(workspace->bboxes);
+        }
+        workspace->bboxes = H3_MEMORY(malloc)(numBBoxes * sizeof(BBox));
+        if (!workspace->bboxes) {
+            workspace->bboxesCapacity = 0;
+            return E_MEMORY_ALLOC;
+        }
+        workspace->bboxesCapacity = numBBoxes;
+    }
+    if (workspace->capacity < numHexagons) {
+        // Grow geometrically so a stream of slightly larger polygons does not
+        // reallocate on every call.
+        int64_t capacity = workspace->capacity * 2;
+        if (capacity < numHexagons) {
+            capacity = numHexagons;
+        }
+        if (workspace->search) {
+            H3_MEMORY(free)(workspace->search);
+        }
+        if (workspace->found) {
+            H3_MEMORY(free)(workspace->found);
+        }
+        workspace->found = NULL;
+        workspace->capacity = 0;
+        workspace->search = H3_MEMORY(malloc)(capacity * sizeof(H3Index));
+        if (!workspace->search) {
+            return E_MEMORY_ALLOC;
+        }
+        workspace->found = H3_MEMORY(malloc)(capacity * sizeof(H3Index));
+        if (!workspace->found) {
+            H3_MEMORY(free)(workspace->search);
+            workspace->search = NULL;
+            return E_MEMORY_ALLOC;
+        }
+        workspace->capacity = capacity;
+    }
+    return E_SUCCESS;
+}
+
+/**
+ * Frees the scratch buffers owned by a workspace and resets it to the empty
+ * (zeroed) state. The workspace struct itself is not freed.
+ *
+ * @param workspace The workspace to release
+ */
+void H3_EXPORT(destroyPolygonToCellsWorkspace)(
+    PolygonToCellsWorkspace *workspace) {
+    if (workspace->bboxes) {
+        H3_MEMORY(free)(workspace->bboxes);
+    }
+    if (workspace->search) {
+        H3_MEMORY(free)(workspace->search);
+    }
+    if (workspace->found) {
+        H3_MEMORY(free)(workspace->found);
+    }
+    workspace->bboxes = NULL;
+    workspace->bboxesCapacity = 0;
+    workspace->search = NULL;
+    workspace->found = NULL;
+    workspace->capacity = 0;
+}
+
 /**
  * polygonToCells takes a given GeoJSON-like data structure and preallocated,
  * zeroed memory, and fills it with the hexagons that are contained by
@@ -890,6 +983,29 @@ H3Error _getEdgeHexagons(const GeoLoop *geoloop, int64_t numHexagons, int res,
  */
 H3Error H3_EXPORT(polygonToCells)(const GeoPolygon *geoPolygon, int res,
                                   uint32_t flags, H3Index *out) {
+    PolygonToCellsWorkspace workspace = {0};
+    H3Error err = H3_EXPORT(polygonToCellsWithWorkspace)(geoPolygon, res, flags,
+                                                         &workspace, out);
+    H3_EXPORT(destroyPolygonToCellsWorkspace)(&workspace);
+    return err;
+}
+
+/**
+ * polygonToCellsWithWorkspace is polygonToCells using caller owned scratch
+ * memory. The workspace buffers are grown as needed and kept for the next
+ * call, so repeatedly filling polygons of similar size does not allocate.
+ * Only the portion of the scratch memory used by this call is cleared.
+ *
+ * A workspace must not be used by more than one thread at a time.
+ *
+ * @param geoPolygon The geoloop and holes defining the relevant area
+ * @param res The Hexagon resolution (0-15)
+ * @param workspace Zero-initialized or previously used workspace
+ * @param out The slab of zeroed memory to write to. Assumed to be big enough.
+ */
+H3Error H3_EXPORT(polygonToCellsWithWorkspace)(
+    const GeoPolygon *geoPolygon, int res, uint32_t flags,
+    PolygonToCellsWorkspace *workspace, H3Index *out) {
     if (flags != 0) {
         return E_OPTION_INVALID;
     }
@@ -910,34 +1026,30 @@ H3Error H3_EXPORT(polygonToCells)(const GeoPolygon *geoPolygon, int res,
     //
     // This first part is identical to the maxPolygonToCellsSize above.
 
-    // Get the bounding boxes for the polygon and any holes
-    BBox *bboxes = H3_MEMORY(malloc)((geoPolygon->numHoles + 1) * sizeof(BBox));
-    if (!bboxes) {
-        return E_MEMORY_ALLOC;
-    }
-    bboxesFromGeoPolygon(geoPolygon, bboxes);
-
-    // Get the estimated number of hexagons and allocate some temporary memory
-    // for the hexagons
+    // Get the estimated number of hexagons and make sure the workspace has
+    // enough temporary memory for the bounding boxes and the hexagons
     int64_t numHexagons;
     H3Error numHexagonsError =
         H3_EXPORT(maxPolygonToCellsSize)(geoPolygon, res, flags, &numHexagons);
     if (numHexagonsError) {
-        H3_MEMORY(free)(bboxes);
         return numHexagonsError;
     }
-    H3Index *search = H3_MEMORY(calloc)(numHexagons, sizeof(H3Index));
-    if (!search) {
-        H3_MEMORY(free)(bboxes);
-        return E_MEMORY_ALLOC;
-    }
-    H3Index *found = H3_MEMORY(calloc)(numHexagons, sizeof(H3Index));
-    if (!found) {
-        H3_MEMORY(free)(bboxes);
-        H3_MEMORY(free)(search);
-        return E_MEMORY_ALLOC;
+    H3Error reserveError = _reservePolygonToCellsWorkspace(
+        workspace, geoPolygon->numHoles + 1, numHexagons);
+    if (reserveError) {
+        return reserveError;
     }
 
+    // Get the bounding boxes for the polygon and any holes
+    BBox *bboxes = workspace->bboxes;
+    bboxesFromGeoPolygon(geoPolygon, bboxes);
+
+    H3Index *search = workspace->search;
+    H3Index *found = workspace->found;
+    // Only the found hash needs to start out zeroed; the search buffer is
+    // always written before it is read.
+    memset(found, 0, numHexagons * sizeof(H3Index));
+
     // Some metadata for tracking the state of the search and found memory
     // blocks
     int64_t numSearchHexes = 0;
@@ -951,12 +1063,9 @@ H3Error H3_EXPORT(polygonToCells)(const GeoPolygon *geoPolygon, int res,
     H3Error edgeHexError = _getEdgeHexagons(&geoloop, numHexagons, res,
                                             &numSearchHexes, search, found);
     // If this branch is reached, we have exceeded the maximum number of
-    // hexagons possible and need to clean up the allocated memory.
+    // hexagons possible.
     // TODO: Reachable via fuzzer
     if (edgeHexError) {
-        H3_MEMORY(free)(search);
-        H3_MEMORY(free)(found);
-        H3_MEMORY(free)(bboxes);
         return edgeHexError;
     }
 
@@ -970,12 +1079,9 @@ H3Error H3_EXPORT(polygonToCells)(const GeoPolygon *geoPolygon, int res,
         edgeHexError = _getEdgeHexagons(hole, numHexagons, res, &numSearchHexes,
                                         search, found);
         // If this branch is reached, we have exceeded the maximum number of
-        // hexagons possible and need to clean up the allocated memory.
+        // hexagons possible.
         // TODO: Reachable via fuzzer
         if (edgeHexError) {
-            H3_MEMORY(free)(search);
-            H3_MEMORY(free)(found);
-            H3_MEMORY(free)(bboxes);
             return edgeHexError;
         }
     }
@@ -985,6 +1091,7 @@ H3Error H3_EXPORT(polygonToCells)(const GeoPolygon *geoPolygon, int res,
 
     // 4. Begin main loop. While the search hash is not empty do the following
     while (numSearchHexes > 0) {
+        H3_COUNT(polygonToCellsRounds);
         // Iterate through all hexagons in the current search hash, then loop
         // through all neighbors and test Point-in-Poly, if point-in-poly
         // succeeds, add to out and found hashes if not already there.
@@ -1009,16 +1116,13 @@ H3Error H3_EXPORT(polygonToCells)(const GeoPolygon *geoPolygon, int res,
                 int64_t loopCount = 0;
                 while (out[loc] != 0) {
                     // If this branch is reached, we have exceeded the maximum
-                    // number of hexagons possible and need to clean up the
-                    // allocated memory.
+                    // number of hexagons possible.
                     // TODO: Reachable via fuzzer
                     if (loopCount > numHexagons) {
-                        H3_MEMORY(free)(search);
-                        H3_MEMORY(free)(found);
-                        H3_MEMORY(free)(bboxes);
                         return E_FAILED;
                     }
                     if (out[loc] == hex) break;  // Skip duplicates found
+                    H3_COUNT(polygonToCellsProbes);
                     loc = (loc + 1) % numHexagons;
                     loopCount++;
                 }
@@ -1031,6 +1135,7 @@ H3Error H3_EXPORT(polygonToCells)(const GeoPolygon *geoPolygon, int res,
                 H3_EXPORT(cellToLatLng)(hex, &hexCenter);
 
                 // If not, skip
+                H3_COUNT(polygonToCellsPointTests);
                 if (!pointInsidePolygon(geoPolygon, bboxes, &hexCenter)) {
                     continue;
                 }
@@ -1057,9 +1162,6 @@ H3Error H3_EXPORT(polygonToCells)(const GeoPolygon *geoPolygon, int res,
         // Repeat until no new hexagons are found
     }
     // The out memory structure should be complete, end it here
-    H3_MEMORY(free)(bboxes);
-    H3_MEMORY(free)(search);
-    H3_MEMORY(free)(found);
     return E_SUCCESS;
 }
 
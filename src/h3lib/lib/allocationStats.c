@@ -0,0 +1,154 @@
+/*
+ * Copyright 2023 Uber Technologies, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/** @file allocationStats.c
+ * @brief   Counts of the memory allocated by the library
+ *
+ * In builds with H3_ALLOCATION_STATS defined, H3_MEMORY calls the counting
+ * allocators here, which record each allocation and then call the
+ * allocators the library would otherwise use. Each allocation is preceded
+ * by a header holding its size, so that frees can be counted in bytes.
+ *
+ * The counts are global and are not synchronized, so they are only exact
+ * while a single thread calls the library.
+ */
+
+#include <stdint.h>
+
+#include "alloc.h"
+#include "h3api.h"
+
+#ifdef H3_ALLOCATION_STATS
+
+/** Header before each counted allocation, aligned for any type */
+typedef union {
+    size_t size;
+    long double alignLongDouble;
+    long long alignLongLong;
+    void *alignPointer;
+} AllocHeader;
+
+/** Largest size that fits after a header */
+#define MAX_COUNTED_SIZE (SIZE_MAX - sizeof(AllocHeader))
+
+static AllocationStats stats;
+
+/**
+ * Counts an allocation of size bytes, and returns the memory after its
+ * header, or NULL if the allocation failed.
+ */
+static void *_countAllocation(AllocHeader *header, size_t size) {
+    if (!header) {
+        return NULL;
+    }
+    header->size = size;
+    stats.allocations++;
+    stats.allocatedBytes += (int64_t)size;
+    stats.liveBytes += (int64_t)size;
+    if (stats.liveBytes > stats.peakBytes) {
+        stats.peakBytes = stats.liveBytes;
+    }
+    return header + 1;
+}
+
+void *H3_MEMORY(malloc)(size_t size) {
+    if (size > MAX_COUNTED_SIZE) {
+        return NULL;
+    }
+    return _countAllocation(
+        H3_BASE_MEMORY(malloc)(sizeof(AllocHeader) + size), size);
+}
+
+void *H3_MEMORY(calloc)(size_t num, size_t size) {
+    if (size > 0 && num > MAX_COUNTED_SIZE / size) {
+        return NULL;
+    }
+    return _countAllocation(
+        H3_BASE_MEMORY(calloc)(1, sizeof(AllocHeader) + num * size),
+        num * size);
+}
+
+void *H3_MEMORY(realloc)(void *ptr, size_t size) {
+    if (!ptr) {
+        return H3_MEMORY(malloc)(size);
+    }
+    if (size > MAX_COUNTED_SIZE) {
+        return NULL;
+    }
+    AllocHeader *header = (AllocHeader *)ptr - 1;
+    size_t oldSize = header->size;
+    AllocHeader *moved =
+        H3_BASE_MEMORY(realloc)(header, sizeof(AllocHeader) + size);
+    if (!moved) {
+        return NULL;
+    }
+    stats.liveBytes -= (int64_t)oldSize;
+    return _countAllocation(moved, size);
+}
+
+void H3_MEMORY(free)(void *ptr) {
+    if (!ptr) {
+        return;
+    }
+    AllocHeader *header = (AllocHeader *)ptr - 1;
+    stats.frees++;
+    stats.liveBytes -= (int64_t)header->size;
+    H3_BASE_MEMORY(free)(header);
+}
+
+#endif
+
+/**
+ * Returns counts of the memory allocated by the library since the last
+ * call to resetAllocationStats, or since the program started. liveBytes
+ * counts every allocation that has not been freed, including those made
+ * before the reset.
+ *
+ * The peak memory of a call to the library is the peakBytes after the call,
+ * less the liveBytes before it, when the counts are reset just before the
+ * call.
+ *
+ * @param out The counts. Set to zero if counts are not kept.
+ * @return 0 (E_SUCCESS) on success, or E_FAILED if this build of the
+ * library does not keep counts.
+ */
+H3Error H3_EXPORT(getAllocationStats)(AllocationStats *out) {
+#ifdef H3_ALLOCATION_STATS
+    *out = stats;
+    return E_SUCCESS;
+#else
+    *out = (AllocationStats){0};
+    return E_FAILED;
+#endif
+}
+
+/**
+ * Resets the counts of allocations, frees, and allocated bytes to zero,
+ * and peakBytes to the current liveBytes.
+ *
+ * @return 0 (E_SUCCESS) on success, or E_FAILED if this build of the
+ * library does not keep counts.
+ */
+H3Error H3_EXPORT(resetAllocationStats)(void) {
+#ifdef H3_ALLOCATION_STATS
+    stats.allocations = 0;
+    stats.frees = 0;
+    stats.allocatedBytes = 0;
+    stats.peakBytes = stats.liveBytes;
+    return E_SUCCESS;
+#else
+    return E_FAILED;
+#endif
+}
@@ -829,6 +829,18 @@ int _isBaseCellPentagon(int baseCell) {
     return baseCellData[baseCell].isPentagon;
 }
 
+/** @brief Return the number of pentagon base cells numbered lower than the
+ * indicated base cell. */
+int _baseCellPentagonsBefore(int baseCell) {
+    static const int pentagonBaseCells[NUM_PENTAGONS] = {
+        4, 14, 24, 38, 49, 58, 63, 72, 83, 97, 107, 117};
+    int count = 0;
+    while (count < NUM_PENTAGONS && pentagonBaseCells[count] < baseCell) {
+        count++;
+    }
+    return count;
+}
+
 /** @brief Return whether the indicated base cell is a pentagon where all
  * neighbors are oriented towards it. */
 bool _isBaseCellPolarPentagon(int baseCell) {
@@ -0,0 +1,255 @@
+/*
+ * Copyright 2023 Uber Technologies, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/** @file cellCoverage.c
+ * @brief   Read-only index of the area covered by a set of cells
+ *
+ * The coverage is stored as the sorted, merged ranges of the finest
+ * resolution descendants of the cells (see compactCellsToRanges). A cell at
+ * any resolution is covered if its own finest resolution range lies inside
+ * one of them. The ranges are laid out in Eytzinger (breadth first binary
+ * tree) order, so a search touches cache lines in a predictable order.
+ */
+
+#include <stdlib.h>
+
+#include "alloc.h"
+#include "constants.h"
+#include "h3Index.h"
+
+/** Every index digit set to 6 (IJ_AXES_DIGIT) */
+#define ALL_SIX_DIGITS UINT64_C(0666666666666666)
+
+/** Number of queries searched for together by coverageContainsCells */
+#define COVERAGE_BATCH_SIZE 8
+
+/**
+ * Copies sorted ranges into Eytzinger order, by an in-order walk of the
+ * implicit tree rooted at node k. Nodes past the last range are filled with
+ * empty ranges that sort after every cell.
+ *
+ * @param sorted The sorted ranges
+ * @param numRanges Number of ranges
+ * @param i Next sorted range to place
+ * @param k Tree node, 1-based
+ * @param numNodes Number of nodes in the tree
+ * @param mins Tree of range minimums
+ * @param maxes Tree of range maximums
+ * @return The next sorted range to place after this subtree
+ */
+static int64_t _fillEytzinger(const CellRange *sorted, int64_t numRanges,
+                              int64_t i, int64_t k, int64_t numNodes,
+                              H3Index *mins, H3Index *maxes) {
+    if (k <= numNodes) {
+        i = _fillEytzinger(sorted, numRanges, i, 2 * k, numNodes, mins, maxes);
+        if (i < numRanges) {
+            mins[k] = sorted[i].min;
+            maxes[k] = sorted[i].max;
+        } else {
+            mins[k] = UINT64_MAX;
+            maxes[k] = UINT64_MAX;
+        }
+        i++;
+        i = _fillEytzinger(sorted, numRanges, i, 2 * k + 1, numNodes, mins,
+                           maxes);
+    }
+    return i;
+}
+
+/**
+ * Creates a coverage from a set of cells. The cells may be at different
+ * resolutions, and need not be compacted or deduplicated.
+ *
+ * @param cells The cells. H3_NULL entries are skipped.
+ * @param numCells Number of cells
+ * @param out The coverage. Must be freed with destroyCellCoverage.
+ * @return 0 on success, or another value if a cell is invalid or memory
+ * could not be allocated.
+ */
+H3Error H3_EXPORT(createCellCoverage)(const H3Index *cells,
+                                      const int64_t numCells,
+                                      CellCoverage *out) {
+    out->mins = NULL;
+    out->maxes = NULL;
+    out->numRanges = 0;
+    out->depth = 0;
+
+    CellRange *ranges =
+        H3_MEMORY(malloc)((numCells > 0 ? numCells : 1) * sizeof(CellRange));
+    if (!ranges) {
+        return E_MEMORY_ALLOC;
+    }
+    int64_t numRanges;
+    H3Error rangesError = H3_EXPORT(compactCellsToRanges)(
+        cells, numCells, MAX_H3_RES, ranges, &numRanges);
+    if (rangesError) {
+        H3_MEMORY(free)(ranges);
+        return rangesError;
+    }
+
+    // The tree is padded to be complete, so every search takes depth steps.
+    // Trees are 1-based, node 0 is unused.
+    int depth = 0;
+    int64_t numNodes = 0;
+    while (numNodes < numRanges) {
+        depth++;
+        numNodes = 2 * numNodes + 1;
+    }
+    H3Index *mins = H3_MEMORY(malloc)((numNodes + 1) * sizeof(H3Index));
+    if (!mins) {
+        H3_MEMORY(free)(ranges);
+        return E_MEMORY_ALLOC;
+    }
+    H3Index *maxes = H3_MEMORY(malloc)((numNodes + 1) * sizeof(H3Index));
+    if (!maxes) {
+        H3_MEMORY(free)(mins);
+        H3_MEMORY(free)(ranges);
+        return E_MEMORY_ALLOC;
+    }
+    mins[0] = UINT64_MAX;
+    maxes[0] = UINT64_MAX;
+    _fillEytzinger(ranges, numRanges, 0, 1, numNodes, mins, maxes);
+    H3_MEMORY(free)(ranges);
+
+    out->mins = mins;
+    out->maxes = maxes;
+    out->numRanges = numRanges;
+    out->depth = depth;
+    return E_SUCCESS;
+}
+
+/**
+ * Frees the memory of a coverage created by createCellCoverage.
+ *
+ * @param coverage The coverage
+ */
+void H3_EXPORT(destroyCellCoverage)(CellCoverage *coverage) {
+    H3_MEMORY(free)(coverage->mins);
+    H3_MEMORY(free)(coverage->maxes);
+    coverage->mins = NULL;
+    coverage->maxes = NULL;
+    coverage->numRanges = 0;
+    coverage->depth = 0;
+}
+
+/**
+ * Finest resolution descendant range of a cell. Same as cellToChildrenRange
+ * at MAX_H3_RES, kept inline for the query loops.
+ */
+static inline void _finestRange(H3Index cell, H3Index *min, H3Index *max) {
+    int res = H3_GET_RESOLUTION(cell);
+    H3Index digitsMask =
+        (UINT64_C(1) << ((MAX_H3_RES - res) * H3_PER_DIGIT_OFFSET)) - 1;
+    *min = cell & ~digitsMask;
+    H3_SET_RESOLUTION(*min, MAX_H3_RES);
+    *max = *min | (ALL_SIX_DIGITS & digitsMask);
+}
+
+/**
+ * One step of the search for the first range ending at or after min. The
+ * comparison result picks the child, rather than branching on it.
+ */
+static inline void _searchStep(const H3Index *maxes, H3Index min, int64_t *k,
+                               int64_t *found) {
+    int64_t right = maxes[*k] < min;
+    *found = right ? *found : *k;
+    *k = 2 * *k + right;
+}
+
+/**
+ * Returns whether the range [min, max] is inside the range at tree node
+ * found. found is 0 if every range ends before min.
+ */
+static inline int _rangeContains(const CellCoverage *coverage, int64_t found,
+                                 H3Index min, H3Index max) {
+    return found && coverage->mins[found] <= min &&
+           max <= coverage->maxes[found];
+}
+
+/**
+ * Returns whether a cell is covered, that is, whether the cell or its
+ * ancestors are in the set the coverage was created from, or the cell is
+ * entirely covered by its descendants in that set.
+ *
+ * @param coverage The coverage
+ * @param cell The cell, at any resolution
+ * @param out 1 if the cell is covered, 0 otherwise
+ * @return 0 on success, or E_CELL_INVALID if the cell is invalid.
+ */
+H3Error H3_EXPORT(coverageContainsCell)(const CellCoverage *coverage,
+                                        H3Index cell, int *out) {
+    if (H3_GET_MODE(cell) != H3_CELL_MODE) {
+        return E_CELL_INVALID;
+    }
+    H3Index min;
+    H3Index max;
+    _finestRange(cell, &min, &max);
+    int64_t k = 1;
+    int64_t found = 0;
+    for (int level = 0; level < coverage->depth; level++) {
+        _searchStep(coverage->maxes, min, &k, &found);
+    }
+    *out = _rangeContains(coverage, found, min, max);
+    return E_SUCCESS;
+}
+
+/**
+ * Returns whether each of a set of cells is covered. See
+ * coverageContainsCell.
+ *
+ * Several searches are run side by side, so that the memory loads of one
+ * search overlap with those of the others.
+ *
+ * @param coverage The coverage
+ * @param cells The cells, at any resolutions
+ * @param numCells Number of cells
+ * @param out 1 for each cell that is covered, 0 otherwise
+ * @return 0 on success, or E_CELL_INVALID if any cell is invalid.
+ */
+H3Error H3_EXPORT(coverageContainsCells)(const CellCoverage *coverage,
+                                         const H3Index *cells,
+                                         const int64_t numCells, int *out) {
+    int64_t i = 0;
+    for (; i + COVERAGE_BATCH_SIZE <= numCells; i += COVERAGE_BATCH_SIZE) {
+        H3Index mins[COVERAGE_BATCH_SIZE];
+        H3Index maxes[COVERAGE_BATCH_SIZE];
+        int64_t k[COVERAGE_BATCH_SIZE];
+        int64_t found[COVERAGE_BATCH_SIZE];
+        for (int j = 0; j < COVERAGE_BATCH_SIZE; j++) {
+            if (H3_GET_MODE(cells[i + j]) != H3_CELL_MODE) {
+                return E_CELL_INVALID;
+            }
+            _finestRange(cells[i + j], &mins[j], &maxes[j]);
+            k[j] = 1;
+            found[j] = 0;
+        }
+        for (int level = 0; level < coverage->depth; level++) {
+            for (int j = 0; j < COVERAGE_BATCH_SIZE; j++) {
+                _searchStep(coverage->maxes, mins[j], &k[j], &found[j]);
+            }
+        }
+        for (int j = 0; j < COVERAGE_BATCH_SIZE; j++) {
+            out[i + j] = _rangeContains(coverage, found[j], mins[j], maxes[j]);
+        }
+    }
+    for (; i < numCells; i++) {
+        H3Error err =
+            H3_EXPORT(coverageContainsCell)(coverage, cells[i], &out[i]);
+        if (err) {
+            return err;
+        }
+    }
+    return E_SUCCESS;
+}
@@ -0,0 +1,212 @@
+/*
+ * Copyright 2023 Uber Technologies, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/** @file cellGeometryTable.c
+ * @brief   Precomputed centers and boundaries of coarse cells
+ *
+ * Every cell up to the finest resolution of a table is stored at its
+ * position: the number of cells at coarser resolutions plus its rank (see
+ * cellToRank). Centers are stored one per position. Boundaries have
+ * different numbers of vertexes, so they are stored one after the other,
+ * with the offset of the first vertex of each cell.
+ */
+
+#include <string.h>
+
+#include "alloc.h"
+#include "constants.h"
+#include "h3Index.h"
+#include "h3api.h"
+
+/**
+ * Returns the number of cells from resolution 0 to maxRes.
+ */
+static int64_t _numTableCells(int maxRes) {
+    int64_t total = 0;
+    for (int res = 0; res <= maxRes; res++) {
+        int64_t numCells;
+        H3_EXPORT(getNumCells)(res, &numCells);
+        total += numCells;
+    }
+    return total;
+}
+
+/**
+ * Returns the maximum memory, in bytes, of a table of the cells from
+ * resolution 0 to maxRes, taking every boundary to have the maximum number
+ * of vertexes. The memory of a table once created is its numBytes.
+ *
+ * @param maxRes Finest resolution of the table, from 0 to
+ * MAX_CELL_GEOMETRY_TABLE_RES
+ * @param out The maximum size in bytes
+ * @return 0 on success, or E_RES_DOMAIN if maxRes is invalid.
+ */
+H3Error H3_EXPORT(maxCellGeometryTableSize)(int maxRes, int64_t *out) {
+    if (maxRes < 0 || maxRes > MAX_CELL_GEOMETRY_TABLE_RES) {
+        return E_RES_DOMAIN;
+    }
+    int64_t numCells = _numTableCells(maxRes);
+    *out = numCells * (int64_t)sizeof(LatLng) +
+           (numCells + 1) * (int64_t)sizeof(uint32_t) +
+           numCells * MAX_CELL_BNDRY_VERTS * (int64_t)sizeof(LatLng);
+    return E_SUCCESS;
+}
+
+/**
+ * Precomputes the centers and boundaries of all cells from resolution 0 to
+ * maxRes, so that cellToLatLngWithTable and cellToBoundaryWithTable read
+ * them instead of computing them. The memory held, in bytes, is set in
+ * numBytes of the table.
+ *
+ * @param maxRes Finest resolution of the table, from 0 to
+ * MAX_CELL_GEOMETRY_TABLE_RES
+ * @param out The table. Must be freed with destroyCellGeometryTable.
+ * @return 0 on success, E_RES_DOMAIN if maxRes is invalid, or
+ * E_MEMORY_ALLOC if memory could not be allocated.
+ */
+H3Error H3_EXPORT(createCellGeometryTable)(int maxRes,
+                                           CellGeometryTable *out) {
+    if (maxRes < 0 || maxRes > MAX_CELL_GEOMETRY_TABLE_RES) {
+        return E_RES_DOMAIN;
+    }
+    *out = (CellGeometryTable){.maxRes = -1};
+    int64_t numCells = _numTableCells(maxRes);
+    LatLng *centers = H3_MEMORY(malloc)(numCells * sizeof(LatLng));
+    if (!centers) {
+        return E_MEMORY_ALLOC;
+    }
+    uint32_t *vertexOffsets =
+        H3_MEMORY(malloc)((numCells + 1) * sizeof(uint32_t));
+    if (!vertexOffsets) {
+        H3_MEMORY(free)(centers);
+        return E_MEMORY_ALLOC;
+    }
+    // Allocated for the maximum number of vertexes, and shrunk once the
+    // number is known
+    LatLng *verts =
+        H3_MEMORY(malloc)(numCells * MAX_CELL_BNDRY_VERTS * sizeof(LatLng));
+    if (!verts) {
+        H3_MEMORY(free)(vertexOffsets);
+        H3_MEMORY(free)(centers);
+        return E_MEMORY_ALLOC;
+    }
+
+    int64_t position = 0;
+    uint32_t numVerts = 0;
+    for (int res = 0; res <= maxRes; res++) {
+        out->resOffsets[res] = position;
+        int64_t numResCells;
+        H3_EXPORT(getNumCells)(res, &numResCells);
+        for (int64_t rank = 0; rank < numResCells; rank++) {
+            H3Index cell;
+            H3_EXPORT(rankToCell)(rank, res, &cell);
+            H3_EXPORT(cellToLatLng)(cell, &centers[position]);
+            CellBoundary boundary;
+            H3_EXPORT(cellToBoundary)(cell, &boundary);
+            vertexOffsets[position] = numVerts;
+            memcpy(&verts[numVerts], boundary.verts,
+                   boundary.numVerts * sizeof(LatLng));
+            numVerts += boundary.numVerts;
+            position++;
+        }
+    }
+    vertexOffsets[numCells] = numVerts;
+
+    LatLng *shrunk = H3_MEMORY(realloc)(verts, numVerts * sizeof(LatLng));
+    if (shrunk) {
+        verts = shrunk;
+    }
+
+    out->centers = centers;
+    out->vertexOffsets = vertexOffsets;
+    out->verts = verts;
+    out->maxRes = maxRes;
+    out->numBytes = numCells * (int64_t)sizeof(LatLng) +
+                    (numCells + 1) * (int64_t)sizeof(uint32_t) +
+                    numVerts * (int64_t)sizeof(LatLng);
+    return E_SUCCESS;
+}
+
+/**
+ * Frees the memory of a table created by createCellGeometryTable.
+ *
+ * @param table The table
+ */
+void H3_EXPORT(destroyCellGeometryTable)(CellGeometryTable *table) {
+    H3_MEMORY(free)(table->centers);
+    H3_MEMORY(free)(table->vertexOffsets);
+    H3_MEMORY(free)(table->verts);
+    table->centers = NULL;
+    table->vertexOffsets = NULL;
+    table->verts = NULL;
+    table->maxRes = -1;
+    table->numBytes = 0;
+}
+
+/**
+ * Finds the position of a cell in a table.
+ *
+ * @return Whether the cell is in the table
+ */
+static bool _tablePosition(const CellGeometryTable *table, H3Index cell,
+                           int64_t *position) {
+    int res = H3_GET_RESOLUTION(cell);
+    int64_t rank;
+    if (res > table->maxRes || H3_EXPORT(cellToRank)(cell, &rank)) {
+        return false;
+    }
+    *position = table->resOffsets[res] + rank;
+    return true;
+}
+
+/**
+ * Determines the center of a cell as cellToLatLng does, reading it from the
+ * table if the cell is at a resolution in the table.
+ *
+ * @param table The table
+ * @param cell The H3 index
+ * @param out The center of the cell
+ * @return The same as cellToLatLng.
+ */
+H3Error H3_EXPORT(cellToLatLngWithTable)(const CellGeometryTable *table,
+                                         H3Index cell, LatLng *out) {
+    int64_t position;
+    if (!_tablePosition(table, cell, &position)) {
+        return H3_EXPORT(cellToLatLng)(cell, out);
+    }
+    *out = table->centers[position];
+    return E_SUCCESS;
+}
+
+/**
+ * Determines the boundary of a cell as cellToBoundary does, reading it from
+ * the table if the cell is at a resolution in the table.
+ *
+ * @param table The table
+ * @param cell The H3 index
+ * @param out The boundary of the cell
+ * @return The same as cellToBoundary.
+ */
+H3Error H3_EXPORT(cellToBoundaryWithTable)(const CellGeometryTable *table,
+                                           H3Index cell, CellBoundary *out) {
+    int64_t position;
+    if (!_tablePosition(table, cell, &position)) {
+        return H3_EXPORT(cellToBoundary)(cell, out);
+    }
+    uint32_t start = table->vertexOffsets[position];
+    out->numVerts = (int)(table->vertexOffsets[position + 1] - start);
+    memcpy(out->verts, &table->verts[start], out->numVerts * sizeof(LatLng));
+    return E_SUCCESS;
+}
@@ -0,0 +1,237 @@
+/*
+ * Copyright 2023 Uber Technologies, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/** @file cellKernels.c
+ * @brief   Kernels over arrays of cells, for each CPU level
+ *
+ * Validation works on the whole index at once instead of digit by digit,
+ * so that the same steps can run on several indexes in vector registers:
+ *
+ * - The top byte holds the high bit, mode, and reserved bits, and must be
+ *   that of a cell.
+ * - The base cell must be less than NUM_BASE_CELLS.
+ * - The digits after the resolution must all be 7. They are the low
+ *   3 * (MAX_H3_RES - res) bits.
+ * - The digits up to the resolution must not be 7. A digit is 7 when its
+ *   three bits are set, which shifting the digits by one and two bits and
+ *   masking to the low bit of each digit finds.
+ * - On a pentagon base cell, the first non-zero digit must not be 1 (the
+ *   deleted k subsequence). Its highest set bit is then the highest set bit
+ *   of all the digits, and is the low bit of a digit exactly when the digit
+ *   is 1.
+ */
+
+#include "constants.h"
+#include "cpuDispatch.h"
+#include "h3Index.h"
+
+#ifdef H3_HAVE_X86_KERNELS
+#include <immintrin.h>
+#endif
+
+/** Top byte of a cell: high bit 0, cell mode, and no reserved bits */
+#define CELL_TOP_BYTE UINT64_C(0x08)
+
+/** Offset of the top byte */
+#define TOP_BYTE_OFFSET 56
+
+/** Mask of a base cell, after shifting it down */
+#define BASE_CELL_MASK UINT64_C(0x7f)
+
+/** All bits of the resolution digits */
+#define DIGITS_MASK UINT64_C(0x1fffffffffff)
+
+/** The low bit of each resolution digit */
+#define DIGIT_LOW_BITS UINT64_C(0x49249249249)
+
+/** Bit set of the pentagon base cells below 64 */
+#define PENTAGONS_LOW UINT64_C(0x8402004001004010)
+
+/** Bit set of the pentagon base cells from 64, less 64 */
+#define PENTAGONS_HIGH UINT64_C(0x20080200080100)
+
+/**
+ * Returns whether h is a valid cell. The same as isValidCell.
+ */
+static inline int _isValidCellBits(H3Index h) {
+    int baseCell = (int)((h >> H3_BC_OFFSET) & BASE_CELL_MASK);
+    int res = H3_GET_RESOLUTION(h);
+    uint64_t unused =
+        (UINT64_C(1) << (H3_PER_DIGIT_OFFSET * (MAX_H3_RES - res))) - 1;
+    uint64_t digits = h & DIGITS_MASK & ~unused;
+    uint64_t sevens = digits & (digits >> 1) & (digits >> 2) & DIGIT_LOW_BITS;
+
+    // Highest set bit of the digits
+    uint64_t top = digits;
+    top |= top >> 1;
+    top |= top >> 2;
+    top |= top >> 4;
+    top |= top >> 8;
+    top |= top >> 16;
+    top |= top >> 32;
+    top ^= top >> 1;
+
+    uint64_t pentagons = baseCell < 64 ? PENTAGONS_LOW >> baseCell
+                                       : PENTAGONS_HIGH >> (baseCell - 64);
+    int deletedK = (pentagons & 1) && (top & DIGIT_LOW_BITS);
+    return (h >> TOP_BYTE_OFFSET) == CELL_TOP_BYTE &&
+           baseCell < NUM_BASE_CELLS && (h & unused) == unused && !sevens &&
+           !deletedK;
+}
+
+void _isValidCellsScalar(const H3Index *cells, int64_t numCells, int *out) {
+    for (int64_t i = 0; i < numCells; i++) {
+        out[i] = _isValidCellBits(cells[i]);
+    }
+}
+
+#ifdef H3_HAVE_X86_KERNELS
+
+__attribute__((target("avx2"))) void _isValidCellsAvx2(const H3Index *cells,
+                                                        int64_t numCells,
+                                                        int *out) {
+    const __m256i zero = _mm256_setzero_si256();
+    const __m256i one = _mm256_set1_epi64x(1);
+    const __m256i lowBits = _mm256_set1_epi64x((int64_t)DIGIT_LOW_BITS);
+    int64_t i = 0;
+    for (; i + 4 <= numCells; i += 4) {
+        __m256i h = _mm256_loadu_si256((const __m256i *)&cells[i]);
+        __m256i valid =
+            _mm256_cmpeq_epi64(_mm256_srli_epi64(h, TOP_BYTE_OFFSET),
+                               _mm256_set1_epi64x((int64_t)CELL_TOP_BYTE));
+
+        __m256i baseCell =
+            _mm256_and_si256(_mm256_srli_epi64(h, H3_BC_OFFSET),
+                             _mm256_set1_epi64x((int64_t)BASE_CELL_MASK));
+        valid = _mm256_and_si256(
+            valid,
+            _mm256_cmpgt_epi64(_mm256_set1_epi64x(NUM_BASE_CELLS), baseCell));
+
+        __m256i res = _mm256_and_si256(_mm256_srli_epi64(h, H3_RES_OFFSET),
+                                       _mm256_set1_epi64x(MAX_H3_RES));
+        __m256i numUnused =
+            _mm256_sub_epi64(_mm256_set1_epi64x(MAX_H3_RES), res);
+        numUnused = _mm256_add_epi64(_mm256_add_epi64(numUnused, numUnused),
+                                     numUnused);
+        __m256i unused =
+            _mm256_sub_epi64(_mm256_sllv_epi64(one, numUnused), one);
+        valid = _mm256_and_si256(
+            valid, _mm256_cmpeq_epi64(_mm256_and_si256(h, unused), unused));
+
+        __m256i digits = _mm256_andnot_si256(
+            unused, _mm256_and_si256(
+                        h, _mm256_set1_epi64x((int64_t)DIGITS_MASK)));
+        __m256i sevens = _mm256_and_si256(
+            _mm256_and_si256(digits, _mm256_srli_epi64(digits, 1)),
+            _mm256_and_si256(_mm256_srli_epi64(digits, 2), lowBits));
+        valid = _mm256_and_si256(valid, _mm256_cmpeq_epi64(sevens, zero));
+
+        __m256i top = digits;
+        top = _mm256_or_si256(top, _mm256_srli_epi64(top, 1));
+        top = _mm256_or_si256(top, _mm256_srli_epi64(top, 2));
+        top = _mm256_or_si256(top, _mm256_srli_epi64(top, 4));
+        top = _mm256_or_si256(top, _mm256_srli_epi64(top, 8));
+        top = _mm256_or_si256(top, _mm256_srli_epi64(top, 16));
+        top = _mm256_or_si256(top, _mm256_srli_epi64(top, 32));
+        top = _mm256_xor_si256(top, _mm256_srli_epi64(top, 1));
+        __m256i leadingK = _mm256_cmpeq_epi64(
+            _mm256_cmpeq_epi64(_mm256_and_si256(top, lowBits), zero), zero);
+
+        __m256i isHigh = _mm256_cmpgt_epi64(baseCell, _mm256_set1_epi64x(63));
+        __m256i pentagons = _mm256_blendv_epi8(
+            _mm256_set1_epi64x((int64_t)PENTAGONS_LOW),
+            _mm256_set1_epi64x((int64_t)PENTAGONS_HIGH), isHigh);
+        __m256i isPentagon = _mm256_cmpeq_epi64(
+            _mm256_and_si256(
+                _mm256_srlv_epi64(pentagons, _mm256_and_si256(
+                                                 baseCell,
+                                                 _mm256_set1_epi64x(63))),
+                one),
+            one);
+        valid = _mm256_andnot_si256(_mm256_and_si256(isPentagon, leadingK),
+                                    valid);
+
+        int lanes = _mm256_movemask_pd(_mm256_castsi256_pd(valid));
+        for (int lane = 0; lane < 4; lane++) {
+            out[i + lane] = (lanes >> lane) & 1;
+        }
+    }
+    _isValidCellsScalar(&cells[i], numCells - i, &out[i]);
+}
+
+__attribute__((target("avx512f"))) void _isValidCellsAvx512(
+    const H3Index *cells, int64_t numCells, int *out) {
+    const __m512i one = _mm512_set1_epi64(1);
+    const __m512i lowBits = _mm512_set1_epi64((int64_t)DIGIT_LOW_BITS);
+    int64_t i = 0;
+    for (; i + 8 <= numCells; i += 8) {
+        __m512i h = _mm512_loadu_si512((const void *)&cells[i]);
+        __mmask8 valid =
+            _mm512_cmpeq_epi64_mask(_mm512_srli_epi64(h, TOP_BYTE_OFFSET),
+                                    _mm512_set1_epi64((int64_t)CELL_TOP_BYTE));
+
+        __m512i baseCell =
+            _mm512_and_si512(_mm512_srli_epi64(h, H3_BC_OFFSET),
+                             _mm512_set1_epi64((int64_t)BASE_CELL_MASK));
+        valid &= _mm512_cmplt_epi64_mask(baseCell,
+                                         _mm512_set1_epi64(NUM_BASE_CELLS));
+
+        __m512i res = _mm512_and_si512(_mm512_srli_epi64(h, H3_RES_OFFSET),
+                                       _mm512_set1_epi64(MAX_H3_RES));
+        __m512i numUnused =
+            _mm512_sub_epi64(_mm512_set1_epi64(MAX_H3_RES), res);
+        numUnused = _mm512_add_epi64(_mm512_add_epi64(numUnused, numUnused),
+                                     numUnused);
+        __m512i unused =
+            _mm512_sub_epi64(_mm512_sllv_epi64(one, numUnused), one);
+        valid &= _mm512_cmpeq_epi64_mask(_mm512_and_si512(h, unused), unused);
+
+        __m512i digits = _mm512_andnot_si512(
+            unused,
+            _mm512_and_si512(h, _mm512_set1_epi64((int64_t)DIGITS_MASK)));
+        __m512i sevens = _mm512_and_si512(
+            _mm512_and_si512(digits, _mm512_srli_epi64(digits, 1)),
+            _mm512_and_si512(_mm512_srli_epi64(digits, 2), lowBits));
+        valid &= _mm512_testn_epi64_mask(sevens, sevens);
+
+        __m512i top = digits;
+        top = _mm512_or_si512(top, _mm512_srli_epi64(top, 1));
+        top = _mm512_or_si512(top, _mm512_srli_epi64(top, 2));
+        top = _mm512_or_si512(top, _mm512_srli_epi64(top, 4));
+        top = _mm512_or_si512(top, _mm512_srli_epi64(top, 8));
+        top = _mm512_or_si512(top, _mm512_srli_epi64(top, 16));
+        top = _mm512_or_si512(top, _mm512_srli_epi64(top, 32));
+        top = _mm512_xor_si512(top, _mm512_srli_epi64(top, 1));
+        __mmask8 leadingK = _mm512_test_epi64_mask(top, lowBits);
+
+        __mmask8 isHigh =
+            _mm512_cmpgt_epi64_mask(baseCell, _mm512_set1_epi64(63));
+        __m512i pentagons = _mm512_mask_blend_epi64(
+            isHigh, _mm512_set1_epi64((int64_t)PENTAGONS_LOW),
+            _mm512_set1_epi64((int64_t)PENTAGONS_HIGH));
+        __mmask8 isPentagon = _mm512_test_epi64_mask(
+            _mm512_srlv_epi64(pentagons, _mm512_and_si512(
+                                             baseCell, _mm512_set1_epi64(63))),
+            one);
+        valid &= ~(isPentagon & leadingK);
+
+        for (int lane = 0; lane < 8; lane++) {
+            out[i + lane] = (valid >> lane) & 1;
+        }
+    }
+    _isValidCellsScalar(&cells[i], numCells - i, &out[i]);
+}
+
+#endif
@@ -0,0 +1,323 @@
+/*
+ * Copyright 2023 Uber Technologies, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/** @file cellSet.c
+ * @brief   Set operations on compacted sets of cells
+ *
+ * Each input set is converted to the sorted, merged ranges of its finest
+ * resolution descendants (see compactCellsToRanges), and then to intervals
+ * of cellToRank at MAX_H3_RES. The operation is a single sweep over the
+ * boundaries of both interval lists, and each resulting interval is split
+ * back into the fewest cells that cover it exactly, which is the compacted
+ * form. Nothing is ever uncompacted.
+ */
+
+#include <stdbool.h>
+#include <string.h>
+
+#include "alloc.h"
+#include "baseCells.h"
+#include "constants.h"
+#include "h3Assert.h"
+#include "h3Index.h"
+
+/** Rank past the end of every interval */
+#define END_OF_RANKS INT64_MAX
+
+/**
+ * Output of a set operation: either a count of cells only, or cells written
+ * to a bounded array.
+ */
+typedef struct {
+    H3Index *out;          ///< output cells, or NULL to only count
+    int64_t numOut;        ///< capacity of out
+    int64_t count;         ///< cells produced so far
+    int64_t pendingStart;  ///< start rank of the interval being built
+    int64_t pendingEnd;    ///< end rank of the interval being built, or -1
+} CellSetOutput;
+
+/**
+ * Returns whether a cell is in the result of an operation, given whether it
+ * is in each input.
+ */
+static inline bool _inResult(uint32_t operation, bool inA, bool inB) {
+    switch (operation) {
+        case CELL_SET_UNION:
+            return inA || inB;
+        case CELL_SET_INTERSECTION:
+            return inA && inB;
+        case CELL_SET_DIFFERENCE:
+            return inA && !inB;
+        default:
+            return inA != inB;
+    }
+}
+
+/**
+ * Splits the rank interval [start, end) at MAX_H3_RES into the fewest cells
+ * covering it, in order. From each position, the coarsest cell that starts
+ * there and ends within the interval is taken.
+ */
+static H3Error _intervalToCells(int64_t start, int64_t end,
+                                CellSetOutput *output) {
+    while (start < end) {
+        H3Index cell;
+        H3Error rankError = H3_EXPORT(rankToCell)(start, MAX_H3_RES, &cell);
+        if (NEVER(rankError)) {
+            return rankError;
+        }
+        // Ancestors of the cell are pentagons above its first nonzero digit
+        int firstDigitRes = 0;
+        if (_isBaseCellPentagon(H3_GET_BASE_CELL(cell))) {
+            firstDigitRes = MAX_H3_RES + 1;
+            for (int r = 1; r <= MAX_H3_RES; r++) {
+                if (H3_GET_INDEX_DIGIT(cell, r) != CENTER_DIGIT) {
+                    firstDigitRes = r;
+                    break;
+                }
+            }
+        }
+        H3Index best = cell;
+        int64_t bestSize = 1;
+        int64_t width = 1;
+        for (int res = MAX_H3_RES - 1; res >= 0; res--) {
+            // The ancestor at res only starts here if the digit below it
+            // is 0
+            if (H3_GET_INDEX_DIGIT(cell, res + 1) != CENTER_DIGIT) {
+                break;
+            }
+            width *= 7;
+            // A pentagon is missing the descendants of its deleted
+            // subsequence at each finer resolution
+            int64_t size =
+                res < firstDigitRes ? 1 + 5 * (width - 1) / 6 : width;
+            if (size > end - start) {
+                break;
+            }
+            best = cell;
+            H3_SET_RESOLUTION(best, res);
+            for (int r = res + 1; r <= MAX_H3_RES; r++) {
+                H3_SET_INDEX_DIGIT(best, r, INVALID_DIGIT);
+            }
+            bestSize = size;
+        }
+
+        if (output->out) {
+            if (output->count >= output->numOut) {
+                return E_MEMORY_BOUNDS;
+            }
+            output->out[output->count] = best;
+        }
+        output->count++;
+        start += bestSize;
+    }
+    return E_SUCCESS;
+}
+
+/**
+ * Adds the rank interval [start, end) to the output, joining it to the
+ * previous interval if they touch.
+ */
+static H3Error _emitInterval(int64_t start, int64_t end,
+                             CellSetOutput *output) {
+    if (output->pendingEnd == start) {
+        output->pendingEnd = end;
+        return E_SUCCESS;
+    }
+    if (output->pendingEnd >= 0) {
+        H3Error err = _intervalToCells(output->pendingStart,
+                                       output->pendingEnd, output);
+        if (err) {
+            return err;
+        }
+    }
+    output->pendingStart = start;
+    output->pendingEnd = end;
+    return E_SUCCESS;
+}
+
+/**
+ * Returns the rank interval of a range of cells at MAX_H3_RES.
+ */
+static void _rangeToRanks(const CellRange *range, int64_t *start,
+                          int64_t *end) {
+    H3_EXPORT(cellToRank)(range->min, start);
+    H3_EXPORT(cellToRank)(range->max, end);
+    (*end)++;
+}
+
+/**
+ * Sweeps over the boundaries of two sorted lists of disjoint ranges,
+ * emitting the intervals where the result of the operation holds.
+ */
+static H3Error _sweep(const CellRange *rangesA, int64_t numA,
+                      const CellRange *rangesB, int64_t numB,
+                      uint32_t operation, CellSetOutput *output) {
+    int64_t ia = 0;
+    int64_t ib = 0;
+    bool inA = false;
+    bool inB = false;
+    int64_t startA = END_OF_RANKS;
+    int64_t endA = END_OF_RANKS;
+    int64_t startB = END_OF_RANKS;
+    int64_t endB = END_OF_RANKS;
+    if (numA > 0) _rangeToRanks(&rangesA[0], &startA, &endA);
+    if (numB > 0) _rangeToRanks(&rangesB[0], &startB, &endB);
+
+    int64_t pos = 0;
+    while (true) {
+        int64_t nextA = inA ? endA : startA;
+        int64_t nextB = inB ? endB : startB;
+        int64_t next = nextA < nextB ? nextA : nextB;
+        if (next == END_OF_RANKS) {
+            break;
+        }
+        if (pos < next && _inResult(operation, inA, inB)) {
+            H3Error err = _emitInterval(pos, next, output);
+            if (err) {
+                return err;
+            }
+        }
+        if (nextA == next) {
+            if (inA) {
+                ia++;
+                startA = endA = END_OF_RANKS;
+                if (ia < numA) _rangeToRanks(&rangesA[ia], &startA, &endA);
+            }
+            inA = !inA;
+        }
+        if (nextB == next) {
+            if (inB) {
+                ib++;
+                startB = endB = END_OF_RANKS;
+                if (ib < numB) _rangeToRanks(&rangesB[ib], &startB, &endB);
+            }
+            inB = !inB;
+        }
+        pos = next;
+    }
+
+    if (output->pendingEnd >= 0) {
+        H3Error err = _intervalToCells(output->pendingStart,
+                                       output->pendingEnd, output);
+        if (err) {
+            return err;
+        }
+        output->pendingEnd = -1;
+    }
+    return E_SUCCESS;
+}
+
+/**
+ * Runs a set operation, counting or writing the result.
+ */
+static H3Error _cellSetOperation(const H3Index *setA, const int64_t numA,
+                                 const H3Index *setB, const int64_t numB,
+                                 uint32_t operation, CellSetOutput *output) {
+    if (operation > CELL_SET_SYMMETRIC_DIFFERENCE) {
+        return E_OPTION_INVALID;
+    }
+
+    CellRange *rangesA =
+        H3_MEMORY(malloc)((numA > 0 ? numA : 1) * sizeof(CellRange));
+    if (!rangesA) {
+        return E_MEMORY_ALLOC;
+    }
+    CellRange *rangesB =
+        H3_MEMORY(malloc)((numB > 0 ? numB : 1) * sizeof(CellRange));
+    if (!rangesB) {
+        H3_MEMORY(free)(rangesA);
+        return E_MEMORY_ALLOC;
+    }
+
+    int64_t numRangesA;
+    int64_t numRangesB;
+    H3Error err = H3_EXPORT(compactCellsToRanges)(setA, numA, MAX_H3_RES,
+                                                  rangesA, &numRangesA);
+    if (!err) {
+        err = H3_EXPORT(compactCellsToRanges)(setB, numB, MAX_H3_RES, rangesB,
+                                              &numRangesB);
+    }
+    if (!err) {
+        err = _sweep(rangesA, numRangesA, rangesB, numRangesB, operation,
+                     output);
+    }
+
+    H3_MEMORY(free)(rangesB);
+    H3_MEMORY(free)(rangesA);
+    return err;
+}
+
+/**
+ * Returns the exact number of cells in the result of a set operation on two
+ * sets of cells. See compactCellSetOperation.
+ *
+ * @param setA The first set of cells
+ * @param numA Number of cells in the first set
+ * @param setB The second set of cells
+ * @param numB Number of cells in the second set
+ * @param operation The CellSetOperation to perform
+ * @param out The number of cells in the result
+ * @return 0 on success, or another value on failure.
+ */
+H3Error H3_EXPORT(compactCellSetOperationSize)(
+    const H3Index *setA, const int64_t numA, const H3Index *setB,
+    const int64_t numB, uint32_t operation, int64_t *out) {
+    CellSetOutput output = {.out = NULL, .pendingEnd = -1};
+    H3Error err =
+        _cellSetOperation(setA, numA, setB, numB, operation, &output);
+    if (err) {
+        return err;
+    }
+    *out = output.count;
+    return E_SUCCESS;
+}
+
+/**
+ * Performs a set operation on two sets of cells, without uncompacting
+ * them. The inputs may be compacted, at mixed resolutions, and in any
+ * order. H3_NULL entries are skipped. The result is compacted and
+ * ordered by position on the grid, as given by cellToRank at the finest
+ * resolution.
+ *
+ * @param setA The first set of cells
+ * @param numA Number of cells in the first set
+ * @param setB The second set of cells
+ * @param numB Number of cells in the second set
+ * @param operation The CellSetOperation to perform
+ * @param out The resulting cells. Entries past the end of the result are
+ * set to H3_NULL.
+ * @param numOut Size of out, at least compactCellSetOperationSize
+ * @return 0 on success, E_MEMORY_BOUNDS if out is too small, or another
+ * value on failure.
+ */
+H3Error H3_EXPORT(compactCellSetOperation)(const H3Index *setA,
+                                           const int64_t numA,
+                                           const H3Index *setB,
+                                           const int64_t numB,
+                                           uint32_t operation, H3Index *out,
+                                           const int64_t numOut) {
+    CellSetOutput output = {.out = out, .numOut = numOut, .pendingEnd = -1};
+    H3Error err =
+        _cellSetOperation(setA, numA, setB, numB, operation, &output);
+    if (err) {
+        return err;
+    }
+    if (output.count < numOut) {
+        memset(out + output.count, 0,
+               (numOut - output.count) * sizeof(H3Index));
+    }
+    return E_SUCCESS;
+}
@@ -0,0 +1,521 @@
+/*
+ * Copyright 2023 Uber Technologies, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/** @file cellSetEncoding.c
+ * @brief   Compact binary encoding of sorted sets of H3 indexes
+ *
+ * The encoding is designed to be written to a file and memory mapped: it
+ * can be searched in place, without decoding it in full. All integers are
+ * little endian and read byte by byte, so the buffer needs no alignment.
+ *
+ * Layout:
+ *
+ *     header (ENCODING_HEADER_SIZE bytes)
+ *         magic       4 bytes, "H3CS"
+ *         version     uint32
+ *         blockSize   uint32, indexes per block
+ *         reserved    uint32, 0
+ *         numCells    uint64
+ *         numBlocks   uint64
+ *         size        uint64, size of the whole encoding in bytes
+ *     block index (numBlocks entries of ENCODING_INDEX_ENTRY_SIZE bytes)
+ *         first       uint64, first index of the block
+ *         offset      uint64, byte offset of the block
+ *     blocks
+ *         shift       uint8, number of low zero bits common to the deltas
+ *         deltas      the differences between consecutive indexes of the
+ *                     block after the first, shifted right by shift, as
+ *                     unsigned LEB128 varints
+ *
+ * Each block ends where the next block begins, or at the end of the
+ * encoding for the last block.
+ */
+
+#include <stdbool.h>
+#include <string.h>
+
+#include "h3Index.h"
+#include "h3api.h"
+
+/** Identifies an encoded cell set */
+static const uint8_t ENCODING_MAGIC[4] = {'H', '3', 'C', 'S'};
+
+/** Version of the encoding written */
+#define ENCODING_VERSION 1
+
+/** Number of indexes in each block */
+#define ENCODING_BLOCK_SIZE 256
+
+/** Size of the header, in bytes */
+#define ENCODING_HEADER_SIZE 40
+
+/** Size of each block index entry, in bytes */
+#define ENCODING_INDEX_ENTRY_SIZE 16
+
+/** Maximum size of a varint encoding a 64-bit value, in bytes */
+#define MAX_VARINT_SIZE 10
+
+/** Header fields of an encoded cell set */
+typedef struct {
+    int64_t blockSize;  ///< indexes per block
+    int64_t numCells;   ///< number of indexes
+    int64_t numBlocks;  ///< number of blocks
+    int64_t size;       ///< size of the encoding in bytes
+} EncodingHeader;
+
+static void _writeUint32(uint8_t *p, uint32_t value) {
+    for (int i = 0; i < 4; i++) {
+        p[i] = (uint8_t)(value >> (8 * i));
+    }
+}
+
+static void _writeUint64(uint8_t *p, uint64_t value) {
+    for (int i = 0; i < 8; i++) {
+        p[i] = (uint8_t)(value >> (8 * i));
+    }
+}
+
+static uint32_t _readUint32(const uint8_t *p) {
+    uint32_t value = 0;
+    for (int i = 0; i < 4; i++) {
+        value |= (uint32_t)p[i] << (8 * i);
+    }
+    return value;
+}
+
+static uint64_t _readUint64(const uint8_t *p) {
+    uint64_t value = 0;
+    for (int i = 0; i < 8; i++) {
+        value |= (uint64_t)p[i] << (8 * i);
+    }
+    return value;
+}
+
+/** Returns the number of bytes in the varint encoding of value */
+static int _varintSize(uint64_t value) {
+    int size = 1;
+    while (value >= 0x80) {
+        value >>= 7;
+        size++;
+    }
+    return size;
+}
+
+/**
+ * Writes value as a varint.
+ * @return The number of bytes written
+ */
+static int _writeVarint(uint8_t *p, uint64_t value) {
+    int size = 0;
+    while (value >= 0x80) {
+        p[size++] = (uint8_t)(value | 0x80);
+        value >>= 7;
+    }
+    p[size++] = (uint8_t)value;
+    return size;
+}
+
+/**
+ * Reads a varint starting at *p, advancing *p past it.
+ * @return false if the varint runs past end or overflows 64 bits
+ */
+static bool _readVarint(const uint8_t **p, const uint8_t *end,
+                        uint64_t *out) {
+    uint64_t value = 0;
+    for (int i = 0; i < MAX_VARINT_SIZE && *p < end; i++) {
+        uint8_t byte = *(*p)++;
+        uint64_t bits = byte & 0x7f;
+        if (i == MAX_VARINT_SIZE - 1 && bits > 1) {
+            return false;
+        }
+        value |= bits << (7 * i);
+        if (!(byte & 0x80)) {
+            *out = value;
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * Encodes the deltas of one block. Deltas between indexes at the same
+ * resolution share their low bits, which are shifted out first, so a block
+ * of nearby cells takes about a byte per cell.
+ *
+ * @param block The indexes of the block, sorted
+ * @param numInBlock Number of indexes in the block
+ * @param out Output for the block's deltas, or NULL to only count them
+ * @return The size of the block's deltas, in bytes
+ */
+static int64_t _encodeBlock(const H3Index *block, int numInBlock,
+                            uint8_t *out) {
+    uint64_t allBits = 0;
+    for (int i = 1; i < numInBlock; i++) {
+        allBits |= block[i] - block[i - 1];
+    }
+    int shift = 0;
+    while (allBits && !((allBits >> shift) & 1)) {
+        shift++;
+    }
+
+    int64_t size = 1;
+    if (out) {
+        out[0] = (uint8_t)shift;
+    }
+    for (int i = 1; i < numInBlock; i++) {
+        uint64_t delta = (block[i] - block[i - 1]) >> shift;
+        size += out ? _writeVarint(out + size, delta) : _varintSize(delta);
+    }
+    return size;
+}
+
+/**
+ * Splits the indexes of a set into blocks, skipping H3_NULL, and checks
+ * that they are sorted and unique. Writes the block index and blocks if
+ * out is given.
+ *
+ * @param cells The indexes
+ * @param numCells Number of entries in cells
+ * @param out The encoding, with room for the blocks, or NULL to only count
+ * @param dataStart Offset of the first block in the encoding
+ * @param numFound Set to the number of indexes that are not H3_NULL
+ * @param dataBytes Set to the total size of the blocks
+ * @return E_DUPLICATE_INPUT if an index repeats, E_DOMAIN if the indexes
+ * are not sorted, or E_SUCCESS
+ */
+static H3Error _encodeCells(const H3Index *cells, const int64_t numCells,
+                            uint8_t *out, int64_t dataStart,
+                            int64_t *numFound, int64_t *dataBytes) {
+    H3Index block[ENCODING_BLOCK_SIZE];
+    int numInBlock = 0;
+    int64_t count = 0;
+    int64_t numBlocks = 0;
+    int64_t bytes = 0;
+    H3Index previous = H3_NULL;
+    for (int64_t i = 0; i <= numCells; i++) {
+        bool atEnd = i == numCells;
+        if (!atEnd) {
+            if (cells[i] == H3_NULL) {
+                continue;
+            }
+            if (count > 0) {
+                if (cells[i] == previous) {
+                    return E_DUPLICATE_INPUT;
+                }
+                if (cells[i] < previous) {
+                    return E_DOMAIN;
+                }
+            }
+            block[numInBlock++] = cells[i];
+            previous = cells[i];
+            count++;
+        }
+        if (numInBlock == ENCODING_BLOCK_SIZE || (atEnd && numInBlock > 0)) {
+            if (out) {
+                uint8_t *entry = out + ENCODING_HEADER_SIZE +
+                                 numBlocks * ENCODING_INDEX_ENTRY_SIZE;
+                _writeUint64(entry, block[0]);
+                _writeUint64(entry + 8, (uint64_t)(dataStart + bytes));
+            }
+            bytes += _encodeBlock(block, numInBlock,
+                                  out ? out + dataStart + bytes : NULL);
+            numBlocks++;
+            numInBlock = 0;
+        }
+    }
+    *numFound = count;
+    *dataBytes = bytes;
+    return E_SUCCESS;
+}
+
+static int64_t _numBlocks(int64_t numCells) {
+    return (numCells + ENCODING_BLOCK_SIZE - 1) / ENCODING_BLOCK_SIZE;
+}
+
+/**
+ * Reads and validates the header and block index bounds of an encoding.
+ */
+static H3Error _readHeader(const uint8_t *data, const int64_t dataSize,
+                           EncodingHeader *header) {
+    if (dataSize < ENCODING_HEADER_SIZE) {
+        return E_MEMORY_BOUNDS;
+    }
+    if (memcmp(data, ENCODING_MAGIC, sizeof(ENCODING_MAGIC)) != 0 ||
+        _readUint32(data + 4) != ENCODING_VERSION) {
+        return E_FAILED;
+    }
+    uint32_t blockSize = _readUint32(data + 8);
+    uint64_t numCells = _readUint64(data + 16);
+    uint64_t numBlocks = _readUint64(data + 24);
+    uint64_t size = _readUint64(data + 32);
+    if (size > (uint64_t)dataSize) {
+        return E_MEMORY_BOUNDS;
+    }
+    if (size < ENCODING_HEADER_SIZE || blockSize == 0 ||
+        numCells > INT64_MAX ||
+        numBlocks != (numCells + blockSize - 1) / blockSize ||
+        numBlocks > (size - ENCODING_HEADER_SIZE) / ENCODING_INDEX_ENTRY_SIZE) {
+        return E_FAILED;
+    }
+    // Each index after the first of its block takes at least one byte, so
+    // the count is bounded by the size of the blocks.
+    uint64_t dataStart =
+        ENCODING_HEADER_SIZE + numBlocks * ENCODING_INDEX_ENTRY_SIZE;
+    if (numCells > numBlocks + (size - dataStart)) {
+        return E_FAILED;
+    }
+    header->blockSize = blockSize;
+    header->numCells = (int64_t)numCells;
+    header->numBlocks = (int64_t)numBlocks;
+    header->size = (int64_t)size;
+    return E_SUCCESS;
+}
+
+/**
+ * Finds the bounds of a block, checking that they lie within the encoding.
+ */
+static H3Error _blockBounds(const uint8_t *data, const EncodingHeader *header,
+                            int64_t block, H3Index *first,
+                            const uint8_t **start, const uint8_t **end) {
+    int64_t dataStart = ENCODING_HEADER_SIZE +
+                        header->numBlocks * ENCODING_INDEX_ENTRY_SIZE;
+    const uint8_t *entry =
+        data + ENCODING_HEADER_SIZE + block * ENCODING_INDEX_ENTRY_SIZE;
+    uint64_t startOffset = _readUint64(entry + 8);
+    uint64_t endOffset = block + 1 < header->numBlocks
+                             ? _readUint64(entry + ENCODING_INDEX_ENTRY_SIZE +
+                                           8)
+                             : (uint64_t)header->size;
+    if (startOffset < (uint64_t)dataStart || startOffset > endOffset ||
+        endOffset > (uint64_t)header->size) {
+        return E_FAILED;
+    }
+    *first = _readUint64(entry);
+    *start = data + startOffset;
+    *end = data + endOffset;
+    return E_SUCCESS;
+}
+
+/**
+ * Decodes one block of an encoding, checking that it is well formed.
+ *
+ * @param out Output for the block's indexes, or NULL to stop at target
+ * @param target When out is NULL, decoding stops at the first index
+ * greater than or equal to target, which is then returned in found.
+ */
+static H3Error _decodeBlock(const uint8_t *data, const EncodingHeader *header,
+                            int64_t block, H3Index *out, H3Index target,
+                            H3Index *found) {
+    H3Index cell;
+    const uint8_t *p;
+    const uint8_t *end;
+    H3Error err = _blockBounds(data, header, block, &cell, &p, &end);
+    if (err) {
+        return err;
+    }
+    int64_t numInBlock = header->numCells - block * header->blockSize;
+    if (numInBlock > header->blockSize) {
+        numInBlock = header->blockSize;
+    }
+    if (p == end || *p >= 64) {
+        return E_FAILED;
+    }
+    int shift = *p++;
+    for (int64_t i = 0; i < numInBlock; i++) {
+        if (i > 0) {
+            uint64_t delta;
+            if (!_readVarint(&p, end, &delta) || delta == 0 ||
+                delta > (UINT64_MAX - cell) >> shift) {
+                return E_FAILED;
+            }
+            cell += delta << shift;
+        }
+        if (out) {
+            out[i] = cell;
+        } else if (cell >= target) {
+            *found = cell;
+            return E_SUCCESS;
+        }
+    }
+    if (out && p != end) {
+        return E_FAILED;
+    }
+    if (!out) {
+        *found = H3_NULL;
+    }
+    return E_SUCCESS;
+}
+
+/**
+ * Returns the size in bytes of the encoding of a set of indexes.
+ *
+ * @param cells The indexes, sorted and without repeats. H3_NULL entries
+ * are skipped.
+ * @param numCells Number of entries in cells
+ * @param out The size of the encoding, in bytes
+ * @return 0 on success, E_DUPLICATE_INPUT if an index repeats, or E_DOMAIN
+ * if the indexes are not sorted.
+ */
+H3Error H3_EXPORT(encodeCellSetSize)(const H3Index *cells,
+                                     const int64_t numCells, int64_t *out) {
+    int64_t numFound;
+    int64_t dataBytes;
+    H3Error err = _encodeCells(cells, numCells, NULL, 0, &numFound, &dataBytes);
+    if (err) {
+        return err;
+    }
+    *out = ENCODING_HEADER_SIZE +
+           _numBlocks(numFound) * ENCODING_INDEX_ENTRY_SIZE + dataBytes;
+    return E_SUCCESS;
+}
+
+/**
+ * Encodes a sorted set of indexes. Indexes are stored in blocks, each
+ * holding its first index in full and the differences between the rest as
+ * varints, with an index of blocks for searching in place.
+ *
+ * @param cells The indexes, sorted and without repeats. H3_NULL entries
+ * are skipped.
+ * @param numCells Number of entries in cells
+ * @param out The encoding
+ * @param size Size of out in bytes, at least encodeCellSetSize
+ * @return 0 on success, E_MEMORY_BOUNDS if out is too small, or another
+ * value if the indexes are not sorted and unique.
+ */
+H3Error H3_EXPORT(encodeCellSet)(const H3Index *cells, const int64_t numCells,
+                                 uint8_t *out, const int64_t size) {
+    int64_t numFound;
+    int64_t dataBytes;
+    H3Error err = _encodeCells(cells, numCells, NULL, 0, &numFound, &dataBytes);
+    if (err) {
+        return err;
+    }
+    int64_t numBlocks = _numBlocks(numFound);
+    int64_t dataStart =
+        ENCODING_HEADER_SIZE + numBlocks * ENCODING_INDEX_ENTRY_SIZE;
+    int64_t encodedSize = dataStart + dataBytes;
+    if (size < encodedSize) {
+        return E_MEMORY_BOUNDS;
+    }
+
+    memcpy(out, ENCODING_MAGIC, sizeof(ENCODING_MAGIC));
+    _writeUint32(out + 4, ENCODING_VERSION);
+    _writeUint32(out + 8, ENCODING_BLOCK_SIZE);
+    _writeUint32(out + 12, 0);
+    _writeUint64(out + 16, (uint64_t)numFound);
+    _writeUint64(out + 24, (uint64_t)numBlocks);
+    _writeUint64(out + 32, (uint64_t)encodedSize);
+    return _encodeCells(cells, numCells, out, dataStart, &numFound,
+                        &dataBytes);
+}
+
+/**
+ * Returns the number of indexes in an encoded set.
+ *
+ * @param data The encoding
+ * @param dataSize Size of data in bytes
+ * @param out The number of indexes
+ * @return 0 on success, E_MEMORY_BOUNDS if data is truncated, or E_FAILED if
+ * it is not a valid encoding.
+ */
+H3Error H3_EXPORT(decodeCellSetSize)(const uint8_t *data,
+                                     const int64_t dataSize, int64_t *out) {
+    EncodingHeader header;
+    H3Error err = _readHeader(data, dataSize, &header);
+    if (err) {
+        return err;
+    }
+    *out = header.numCells;
+    return E_SUCCESS;
+}
+
+/**
+ * Decodes an encoded set of indexes, in sorted order.
+ *
+ * @param data The encoding
+ * @param dataSize Size of data in bytes
+ * @param out The indexes
+ * @param numOut Size of out, at least decodeCellSetSize
+ * @return 0 on success, E_MEMORY_BOUNDS if data is truncated or out is too
+ * small, or E_FAILED if data is not a valid encoding.
+ */
+H3Error H3_EXPORT(decodeCellSet)(const uint8_t *data, const int64_t dataSize,
+                                 H3Index *out, const int64_t numOut) {
+    EncodingHeader header;
+    H3Error err = _readHeader(data, dataSize, &header);
+    if (err) {
+        return err;
+    }
+    if (numOut < header.numCells) {
+        return E_MEMORY_BOUNDS;
+    }
+    for (int64_t block = 0; block < header.numBlocks; block++) {
+        err = _decodeBlock(data, &header, block,
+                           out + block * header.blockSize, H3_NULL, NULL);
+        if (err) {
+            return err;
+        }
+        // Blocks must continue in order from the previous block
+        if (block > 0 && out[block * header.blockSize] <=
+                             out[block * header.blockSize - 1]) {
+            return E_FAILED;
+        }
+    }
+    return E_SUCCESS;
+}
+
+/**
+ * Searches an encoded set for an index in place, decoding only the block
+ * that may contain it.
+ *
+ * @param data The encoding
+ * @param dataSize Size of data in bytes
+ * @param cell The index to search for
+ * @param out Set to 1 if the set contains the index, 0 otherwise
+ * @return 0 on success, E_MEMORY_BOUNDS if data is truncated, or E_FAILED if
+ * it is not a valid encoding.
+ */
+H3Error H3_EXPORT(encodedCellSetContains)(const uint8_t *data,
+                                          const int64_t dataSize,
+                                          H3Index cell, int *out) {
+    EncodingHeader header;
+    H3Error err = _readHeader(data, dataSize, &header);
+    if (err) {
+        return err;
+    }
+    // Find the last block whose first index is at most cell
+    const uint8_t *index = data + ENCODING_HEADER_SIZE;
+    int64_t lo = 0;
+    int64_t hi = header.numBlocks;
+    while (lo < hi) {
+        int64_t mid = lo + (hi - lo) / 2;
+        if (_readUint64(index + mid * ENCODING_INDEX_ENTRY_SIZE) <= cell) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+    if (lo == 0) {
+        *out = 0;
+        return E_SUCCESS;
+    }
+    H3Index found;
+    err = _decodeBlock(data, &header, lo - 1, NULL, cell, &found);
+    if (err) {
+        return err;
+    }
+    *out = found == cell;
+    return E_SUCCESS;
+}
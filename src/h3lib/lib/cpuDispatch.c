@@ -0,0 +1,87 @@
+/*
+ * Copyright 2023 Uber Technologies, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/** @file cpuDispatch.c
+ * @brief   Detection of CPU features and the kernel table for each level
+ */
+
+#include "cpuDispatch.h"
+
+#ifdef H3_HAVE_X86_KERNELS
+#include <stdatomic.h>
+#endif
+
+/** Kernels for each CPU level, by level */
+static const Kernels KERNELS[NUM_CPU_LEVELS] = {
+    {.isValidCells = _isValidCellsScalar},
+#ifdef H3_HAVE_X86_KERNELS
+    {.isValidCells = _isValidCellsAvx2},
+    {.isValidCells = _isValidCellsAvx512},
+#else
+    {.isValidCells = _isValidCellsScalar},
+    {.isValidCells = _isValidCellsScalar},
+#endif
+};
+
+/**
+ * Returns the best level the CPU supports.
+ */
+static CpuLevel _detectCpuLevel(void) {
+#ifdef H3_HAVE_X86_KERNELS
+    __builtin_cpu_init();
+    // Also checks that the operating system saves the wider registers
+    if (__builtin_cpu_supports("avx512f")) {
+        return CPU_LEVEL_AVX512;
+    }
+    if (__builtin_cpu_supports("avx2")) {
+        return CPU_LEVEL_AVX2;
+    }
+#endif
+    return CPU_LEVEL_SCALAR;
+}
+
+/**
+ * Returns the level that kernels are dispatched for: the best level the
+ * CPU supports, or the pinned level if the CPU supports it.
+ *
+ * The CPU is detected on the first call. Calls racing on other threads
+ * detect the same level, and the cached level is atomic, so they may each
+ * store it.
+ */
+CpuLevel _cpuLevel(void) {
+#ifdef H3_HAVE_X86_KERNELS
+    static atomic_int level = -1;
+    int cached = atomic_load_explicit(&level, memory_order_relaxed);
+    if (cached < 0) {
+        CpuLevel detected = _detectCpuLevel();
+#ifdef H3_CPU_LEVEL
+        if (H3_CPU_LEVEL < detected) {
+            detected = H3_CPU_LEVEL;
+        }
+#endif
+        cached = detected;
+        atomic_store_explicit(&level, cached, memory_order_relaxed);
+    }
+    return (CpuLevel)cached;
+#else
+    // Only the scalar level is built, so there is nothing to detect
+    return CPU_LEVEL_SCALAR;
+#endif
+}
+
+/**
+ * Returns the kernels for the dispatched level.
+ */
+const Kernels *_kernels(void) { return &KERNELS[_cpuLevel()]; }
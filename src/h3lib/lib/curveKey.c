@@ -0,0 +1,211 @@
+/*
+ * Copyright 2023 Uber Technologies, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/** @file curveKey.c
+ * @brief   Locality preserving sort keys for cells
+ *
+ * Index order keeps the descendants of a cell together, but cells on either
+ * side of a base cell boundary are far apart in it. A curve key instead
+ * orders the cells of each icosahedron face along a Hilbert curve over
+ * their face IJ coordinates, so that cells that are close on a face are
+ * usually close in key order too.
+ *
+ * Key layout, from the most significant bit:
+ *
+ *     1 bit   0
+ *     6 bits  unused, 0
+ *     4 bits  resolution
+ *     5 bits  face
+ *     48 bits position on the Hilbert curve over the face IJ coordinates,
+ *             each offset by CURVE_COORD_OFFSET into 24 bits
+ */
+
+#include "coordijk.h"
+#include "faceijk.h"
+#include "h3Assert.h"
+#include "h3Index.h"
+
+/** Number of bits of each face coordinate */
+#define CURVE_COORD_BITS 24
+
+/**
+ * Offset added to face IJ coordinates, which are within about +/-5 million
+ * at resolution 15, to make them non-negative
+ */
+#define CURVE_COORD_OFFSET (1 << (CURVE_COORD_BITS - 1))
+
+/** Offset of the face in the key */
+#define CURVE_FACE_OFFSET (2 * CURVE_COORD_BITS)
+
+/** Offset of the resolution in the key */
+#define CURVE_RES_OFFSET (CURVE_FACE_OFFSET + 5)
+
+/** Mask of the Hilbert curve position in the key */
+#define CURVE_POS_MASK ((UINT64_C(1) << CURVE_FACE_OFFSET) - 1)
+
+/**
+ * Returns the position of (x, y) along a Hilbert curve filling the square
+ * of side 2^CURVE_COORD_BITS.
+ */
+static uint64_t _hilbertPos(uint32_t x, uint32_t y) {
+    uint64_t pos = 0;
+    for (uint32_t s = 1u << (CURVE_COORD_BITS - 1); s > 0; s >>= 1) {
+        uint32_t rx = (x & s) > 0;
+        uint32_t ry = (y & s) > 0;
+        pos += (uint64_t)s * s * ((3 * rx) ^ ry);
+        // Rotate the quadrant so that the curve within it starts and
+        // ends at the right corners
+        if (ry == 0) {
+            if (rx == 1) {
+                x = s - 1 - (x & (s - 1));
+                y = s - 1 - (y & (s - 1));
+            }
+            uint32_t t = x;
+            x = y;
+            y = t;
+        }
+    }
+    return pos;
+}
+
+/**
+ * Inverse of _hilbertPos.
+ */
+static void _hilbertCoords(uint64_t pos, uint32_t *x, uint32_t *y) {
+    uint32_t cx = 0;
+    uint32_t cy = 0;
+    for (uint32_t s = 1; s < (1u << CURVE_COORD_BITS); s <<= 1) {
+        uint32_t rx = 1 & (uint32_t)(pos >> 1);
+        uint32_t ry = 1 & (uint32_t)(pos ^ rx);
+        if (ry == 0) {
+            if (rx == 1) {
+                cx = s - 1 - cx;
+                cy = s - 1 - cy;
+            }
+            uint32_t t = cx;
+            cx = cy;
+            cy = t;
+        }
+        cx += s * rx;
+        cy += s * ry;
+        pos >>= 2;
+    }
+    *x = cx;
+    *y = cy;
+}
+
+/**
+ * Returns a key for a cell that orders cells of the same resolution along
+ * a space filling curve over each icosahedron face. Cells that are near
+ * each other on the same face usually have keys near each other, including
+ * across base cell boundaries, unlike their indexes.
+ *
+ * Keys of different resolutions do not interleave: all keys of a coarser
+ * resolution sort before those of a finer one.
+ *
+ * @param cell The cell
+ * @param out The key
+ * @return 0 on success, or E_CELL_INVALID if cell is not a valid cell.
+ */
+H3Error H3_EXPORT(cellToCurveKey)(H3Index cell, uint64_t *out) {
+    if (!H3_EXPORT(isValidCell)(cell)) {
+        return E_CELL_INVALID;
+    }
+    FaceIJK fijk;
+    H3Error err = _h3ToFaceIjk(cell, &fijk);
+    if (NEVER(err)) {
+        return err;
+    }
+    CoordIJ ij;
+    ijkToIj(&fijk.coord, &ij);
+    uint32_t x = (uint32_t)(ij.i + CURVE_COORD_OFFSET);
+    uint32_t y = (uint32_t)(ij.j + CURVE_COORD_OFFSET);
+    *out = ((uint64_t)H3_GET_RESOLUTION(cell) << CURVE_RES_OFFSET) |
+           ((uint64_t)fijk.face << CURVE_FACE_OFFSET) | _hilbertPos(x, y);
+    return E_SUCCESS;
+}
+
+/**
+ * Returns the cell with the given curve key. The inverse of cellToCurveKey.
+ *
+ * @param key The key
+ * @param out The cell
+ * @return 0 on success, or E_DOMAIN if key is not the key of any cell.
+ */
+H3Error H3_EXPORT(curveKeyToCell)(uint64_t key, H3Index *out) {
+    int res = (int)(key >> CURVE_RES_OFFSET);
+    int face = (int)((key >> CURVE_FACE_OFFSET) & 0x1f);
+    if (res > MAX_H3_RES || face >= NUM_ICOSA_FACES) {
+        return E_DOMAIN;
+    }
+    uint32_t x;
+    uint32_t y;
+    _hilbertCoords(key & CURVE_POS_MASK, &x, &y);
+    CoordIJ ij = {.i = (int)x - CURVE_COORD_OFFSET,
+                  .j = (int)y - CURVE_COORD_OFFSET};
+    FaceIJK fijk = {.face = face};
+    H3Error err = ijToIjk(&ij, &fijk.coord);
+    if (NEVER(err)) {
+        return err;
+    }
+    H3Index cell = _faceIjkToH3(&fijk, res);
+    // The coordinates may be off the face, or on it but not the face the
+    // cell is keyed by
+    uint64_t cellKey;
+    if (cell == H3_NULL || H3_EXPORT(cellToCurveKey)(cell, &cellKey) ||
+        cellKey != key) {
+        return E_DOMAIN;
+    }
+    *out = cell;
+    return E_SUCCESS;
+}
+
+/**
+ * Returns the curve keys of an array of cells. See cellToCurveKey.
+ *
+ * @param cells The cells
+ * @param numCells Number of cells
+ * @param out The keys, one for each cell
+ * @return 0 on success, or E_CELL_INVALID if any cell is invalid.
+ */
+H3Error H3_EXPORT(cellsToCurveKeys)(const H3Index *cells,
+                                    const int64_t numCells, uint64_t *out) {
+    for (int64_t i = 0; i < numCells; i++) {
+        H3Error err = H3_EXPORT(cellToCurveKey)(cells[i], &out[i]);
+        if (err) {
+            return err;
+        }
+    }
+    return E_SUCCESS;
+}
+
+/**
+ * Returns the cells of an array of curve keys. See curveKeyToCell.
+ *
+ * @param keys The keys
+ * @param numKeys Number of keys
+ * @param out The cells, one for each key
+ * @return 0 on success, or E_DOMAIN if any key is not the key of a cell.
+ */
+H3Error H3_EXPORT(curveKeysToCells)(const uint64_t *keys,
+                                    const int64_t numKeys, H3Index *out) {
+    for (int64_t i = 0; i < numKeys; i++) {
+        H3Error err = H3_EXPORT(curveKeyToCell)(keys[i], &out[i]);
+        if (err) {
+            return err;
+        }
+    }
+    return E_SUCCESS;
+}
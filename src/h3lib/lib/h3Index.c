@@ -26,10 +26,14 @@
 
 #include "alloc.h"
 #include "baseCells.h"
+#include "cpuDispatch.h"
 #include "faceijk.h"
 #include "h3Assert.h"
+#include "h3inline.h"
+#include "hotPathCounters.h"
 #include "iterators.h"
 #include "mathExtensions.h"
+#include "resolutionKernels.h"
 
 /**
  * Returns the H3 resolution of an H3 index.
@@ -49,6 +53,71 @@ int H3_EXPORT(getResolution)(H3Index h) { return H3_GET_RESOLUTION(h); }
  */
 int H3_EXPORT(getBaseCellNumber)(H3Index h) { return H3_GET_BASE_CELL(h); }
 
+/**
+ * Value of each hex digit character plus one, or 0 for characters that are
+ * not hex digits.
+ */
+static const uint8_t HEX_DIGIT_VALUES[256] = {
+    ['0'] = 1,  ['1'] = 2,  ['2'] = 3,  ['3'] = 4,  ['4'] = 5,  ['5'] = 6,
+    ['6'] = 7,  ['7'] = 8,  ['8'] = 9,  ['9'] = 10, ['a'] = 11, ['b'] = 12,
+    ['c'] = 13, ['d'] = 14, ['e'] = 15, ['f'] = 16, ['A'] = 11, ['B'] = 12,
+    ['C'] = 13, ['D'] = 14, ['E'] = 15, ['F'] = 16};
+
+/** Hex digit characters by value */
+static const char HEX_DIGITS[16] = {'0', '1', '2', '3', '4', '5', '6', '7',
+                                    '8', '9', 'a', 'b', 'c', 'd', 'e', 'f'};
+
+/** Maximum number of hex digits in an H3Index */
+#define MAX_HEX_DIGITS 16
+
+static inline bool _isHexDigit(char c) {
+    return HEX_DIGIT_VALUES[(unsigned char)c] != 0;
+}
+
+static inline bool _isScanSpace(char c) {
+    return c == ' ' || (c >= '\t' && c <= '\r');
+}
+
+/**
+ * Parses the common forms of a hex index with a table lookup per digit:
+ * optional leading whitespace, an optional 0x prefix, and up to 16 digits.
+ * Anything else, including signs, longer runs of digits, and strings with
+ * no digits, is left for sscanf so that the results are the same.
+ *
+ * @param str The string
+ * @param len Number of characters of str that may be read. Parsing also
+ * stops at a null terminator.
+ * @return true if the string was parsed
+ */
+static bool _stringToH3Fast(const char *str, size_t len, H3Index *out) {
+    size_t i = 0;
+    while (i < len && _isScanSpace(str[i])) {
+        i++;
+    }
+    if (len - i > 2 && str[i] == '0' &&
+        (str[i + 1] == 'x' || str[i + 1] == 'X')) {
+        if (!_isHexDigit(str[i + 2])) {
+            return false;
+        }
+        i += 2;
+    }
+    H3Index h = 0;
+    int numDigits = 0;
+    uint8_t value;
+    while (numDigits < MAX_HEX_DIGITS && i < len &&
+           (value = HEX_DIGIT_VALUES[(unsigned char)str[i]]) != 0) {
+        h = (h << 4) | (value - 1);
+        numDigits++;
+        i++;
+    }
+    if (numDigits == 0 ||
+        (numDigits == MAX_HEX_DIGITS && i < len && _isHexDigit(str[i]))) {
+        return false;
+    }
+    *out = h;
+    return true;
+}
+
 /**
  * Converts a string representation of an H3 index into an H3 index.
  * @param str The string representation of an H3 index.
@@ -56,6 +125,9 @@ int H3_EXPORT(getBaseCellNumber)(H3Index h) { return H3_GET_BASE_CELL(h); }
  * invalid.
  */
 H3Error H3_EXPORT(stringToH3)(const char *str, H3Index *out) {
+    if (_stringToH3Fast(str, SIZE_MAX, out)) {
+        return E_SUCCESS;
+    }
     H3Index h = H3_NULL;
     // If failed, h will be unmodified and we should return H3_NULL anyways.
     int read = sscanf(str, "%" PRIx64, &h);
@@ -66,6 +138,54 @@ H3Error H3_EXPORT(stringToH3)(const char *str, H3Index *out) {
     return E_SUCCESS;
 }
 
+/** Size of the buffer for parsing a packed string that is not terminated */
+#define PACKED_STRING_BUFFER_SIZE 64
+
+/**
+ * Parses a string of a packed buffer without reading past its stride. The
+ * forms the fast path does not handle are copied and null terminated
+ * before being passed to sscanf.
+ */
+static H3Error _packedStringToH3(const char *str, size_t stride,
+                                 H3Index *out) {
+    if (_stringToH3Fast(str, stride, out)) {
+        return E_SUCCESS;
+    }
+    const char *terminator = memchr(str, '\0', stride);
+    size_t len = terminator ? (size_t)(terminator - str) : stride;
+    char buffer[PACKED_STRING_BUFFER_SIZE];
+    char *copy = buffer;
+    if (len >= sizeof(buffer)) {
+        copy = H3_MEMORY(malloc)(len + 1);
+        if (!copy) {
+            return E_MEMORY_ALLOC;
+        }
+    }
+    memcpy(copy, str, len);
+    copy[len] = '\0';
+    H3Error err = H3_EXPORT(stringToH3)(copy, out);
+    if (copy != buffer) {
+        H3_MEMORY(free)(copy);
+    }
+    return err;
+}
+
+/**
+ * Writes the hex digits of an index, without leading zeros, and a null
+ * terminator. str must have room for 17 characters.
+ */
+static void _h3ToStringUnchecked(H3Index h, char *str) {
+    int numDigits = 1;
+    while (numDigits < MAX_HEX_DIGITS && (h >> (4 * numDigits)) != 0) {
+        numDigits++;
+    }
+    for (int i = numDigits - 1; i >= 0; i--) {
+        str[i] = HEX_DIGITS[h & 0xf];
+        h >>= 4;
+    }
+    str[numDigits] = '\0';
+}
+
 /**
  * Converts an H3 index into a string representation.
  * @param h The H3 index to convert.
@@ -75,11 +195,80 @@ H3Error H3_EXPORT(stringToH3)(const char *str, H3Index *out) {
 H3Error H3_EXPORT(h3ToString)(H3Index h, char *str, size_t sz) {
     // An unsigned 64 bit integer will be expressed in at most
     // 16 digits plus 1 for the null terminator.
-    if (sz < 17) {
+    if (sz < MAX_HEX_DIGITS + 1) {
         // Buffer is potentially not large enough.
         return E_MEMORY_BOUNDS;
     }
-    sprintf(str, "%" PRIx64, h);
+    _h3ToStringUnchecked(h, str);
+    return E_SUCCESS;
+}
+
+/**
+ * Converts an array of string representations of H3 indexes into H3
+ * indexes. See stringToH3.
+ *
+ * @param strings The strings
+ * @param numStrings Number of strings
+ * @param out The H3 indexes, one for each string
+ * @return 0 on success, or E_FAILED if any string could not be parsed.
+ */
+H3Error H3_EXPORT(stringsToH3)(const char *const *strings,
+                               const int64_t numStrings, H3Index *out) {
+    for (int64_t i = 0; i < numStrings; i++) {
+        H3Error err = H3_EXPORT(stringToH3)(strings[i], &out[i]);
+        if (err) {
+            return err;
+        }
+    }
+    return E_SUCCESS;
+}
+
+/**
+ * Converts strings stored at a fixed stride in one buffer into H3 indexes.
+ * See stringToH3. Each string ends at a null terminator or at the end of
+ * its stride, and no characters past its stride are read.
+ *
+ * @param strings The buffer of strings. String i starts at
+ * strings + i * stride.
+ * @param stride Distance between the starts of strings, at least 17
+ * @param numStrings Number of strings
+ * @param out The H3 indexes, one for each string
+ * @return 0 on success, E_MEMORY_BOUNDS if stride is too small, or E_FAILED
+ * if any string could not be parsed.
+ */
+H3Error H3_EXPORT(packedStringsToH3)(const char *strings, const size_t stride,
+                                     const int64_t numStrings, H3Index *out) {
+    if (stride < MAX_HEX_DIGITS + 1) {
+        return E_MEMORY_BOUNDS;
+    }
+    for (int64_t i = 0; i < numStrings; i++) {
+        H3Error err = _packedStringToH3(strings + i * stride, stride, &out[i]);
+        if (err) {
+            return err;
+        }
+    }
+    return E_SUCCESS;
+}
+
+/**
+ * Converts H3 indexes into null terminated strings stored at a fixed stride
+ * in one buffer. See h3ToString.
+ *
+ * @param h The H3 indexes
+ * @param numIndexes Number of indexes
+ * @param out The buffer of strings. String i starts at out + i * stride.
+ * @param stride Distance between the starts of strings, at least 17
+ * @return 0 on success, or E_MEMORY_BOUNDS if stride is too small.
+ */
+H3Error H3_EXPORT(h3ToPackedStrings)(const H3Index *h,
+                                     const int64_t numIndexes, char *out,
+                                     const size_t stride) {
+    if (stride < MAX_HEX_DIGITS + 1) {
+        return E_MEMORY_BOUNDS;
+    }
+    for (int64_t i = 0; i < numIndexes; i++) {
+        _h3ToStringUnchecked(h[i], out + i * stride);
+    }
     return E_SUCCESS;
 }
 
@@ -129,6 +318,21 @@ int H3_EXPORT(isValidCell)(H3Index h) {
     return 1;
 }
 
+/**
+ * Returns whether each of an array of indexes is a valid cell, as
+ * isValidCell. Uses the vectorized kernel for the CPU where there is one.
+ *
+ * @param cells The indexes
+ * @param numCells Number of indexes
+ * @param out 1 for each index that is a valid cell, and 0 otherwise
+ * @return 0 (E_SUCCESS) on success
+ */
+H3Error H3_EXPORT(isValidCells)(const H3Index *cells, const int64_t numCells,
+                                int *out) {
+    _kernels()->isValidCells(cells, numCells, out);
+    return E_SUCCESS;
+}
+
 /**
  * Initializes an H3 index.
  * @param hp The H3 index to initialize.
@@ -164,10 +368,11 @@ H3Error H3_EXPORT(cellToParent)(H3Index h, int parentRes, H3Index *out) {
         return E_SUCCESS;
     }
     H3Index parentH = H3_SET_RESOLUTION(h, parentRes);
-    for (int i = parentRes + 1; i <= childRes; i++) {
-        H3_SET_INDEX_DIGIT(parentH, i, H3_DIGIT_MASK);
-    }
-    *out = parentH;
+    // Set the digits from parentRes + 1 to childRes to 7 at once
+    H3Index unusedDigits =
+        ((UINT64_C(1) << (H3_PER_DIGIT_OFFSET * (childRes - parentRes))) - 1)
+        << (H3_PER_DIGIT_OFFSET * (MAX_H3_RES - childRes));
+    *out = parentH | unusedDigits;
     return E_SUCCESS;
 }
 
@@ -321,6 +526,7 @@ H3Error H3_EXPORT(compactCells)(const H3Index *h3Set, H3Index *compactedSet,
     H3Index *compactedSetOffset = compactedSet;
     int numRemainingHexes = numHexes;
     while (numRemainingHexes) {
+        H3_COUNT(compactCellsRounds);
         res = H3_GET_RESOLUTION(remainingHexes[0]);
         int parentRes = res - 1;
 
@@ -390,6 +596,7 @@ H3Error H3_EXPORT(compactCells)(const H3Index *h3Set, H3Index *compactedSet,
                             H3_SET_RESERVED_BITS(parent, count);
                             hashSetArray[loc] = H3_NULL;
                         } else {
+                            H3_COUNT(compactCellsProbes);
                             loc = (loc + 1) % numRemainingHexes;
                         }
                         loopCount++;
@@ -575,10 +782,7 @@ int H3_EXPORT(isResClassIII)(H3Index h) { return H3_GET_RESOLUTION(h) % 2; }
  * @param h The H3Index to check.
  * @return Returns 1 if it is a pentagon, otherwise 0.
  */
-int H3_EXPORT(isPentagon)(H3Index h) {
-    return _isBaseCellPentagon(H3_GET_BASE_CELL(h)) &&
-           !_h3LeadingNonZeroDigit(h);
-}
+int H3_EXPORT(isPentagon)(H3Index h) { return h3IsPentagon(h); }
 
 /**
  * Returns the highest resolution non-zero digit in an H3Index.
@@ -699,30 +903,7 @@ H3Index _faceIjkToH3(const FaceIJK *fijk, int res) {
     FaceIJK fijkBC = *fijk;
 
     // build the H3Index from finest res up
-    // adjust r for the fact that the res 0 base cell offsets the indexing
-    // digits
-    CoordIJK *ijk = &fijkBC.coord;
-    for (int r = res - 1; r >= 0; r--) {
-        CoordIJK lastIJK = *ijk;
-        CoordIJK lastCenter;
-        if (isResolutionClassIII(r + 1)) {
-            // rotate ccw
-            _upAp7(ijk);
-            lastCenter = *ijk;
-            _downAp7(&lastCenter);
-        } else {
-            // rotate cw
-            _upAp7r(ijk);
-            lastCenter = *ijk;
-            _downAp7r(&lastCenter);
-        }
-
-        CoordIJK diff;
-        _ijkSub(&lastIJK, &lastCenter, &diff);
-        _ijkNormalize(&diff);
-
-        H3_SET_INDEX_DIGIT(h, r + 1, _unitIjkToDigit(&diff));
-    }
+    _resolutionKernels(res)->faceIjkToDigits(&fijkBC.coord, &h);
 
     // fijkBC should now hold the IJK of the base cell in the
     // coordinate system of the current face
@@ -790,6 +971,41 @@ H3Error H3_EXPORT(latLngToCell)(const LatLng *g, int res, H3Index *out) {
     }
 }
 
+/**
+ * Encodes an array of coordinates to the H3 indexes of the containing cells
+ * at the specified resolution. Every point is converted, even if some fail:
+ * points that are not finite are given H3_NULL.
+ *
+ * @param points The spherical coordinates to encode.
+ * @param numPoints Number of points.
+ * @param res The desired H3 resolution for the encoding.
+ * @param out The encoded H3Indexes, one for each point.
+ * @returns E_SUCCESS (0) on success, E_RES_DOMAIN if res is invalid, or
+ * E_LATLNG_DOMAIN if any point was not finite.
+ */
+H3Error H3_EXPORT(latLngsToCells)(const LatLng *points,
+                                  const int64_t numPoints, int res,
+                                  H3Index *out) {
+    if (res < 0 || res > MAX_H3_RES) {
+        return E_RES_DOMAIN;
+    }
+    H3Error result = E_SUCCESS;
+    for (int64_t i = 0; i < numPoints; i++) {
+        if (!isfinite(points[i].lat) || !isfinite(points[i].lng)) {
+            out[i] = H3_NULL;
+            result = E_LATLNG_DOMAIN;
+            continue;
+        }
+        FaceIJK fijk;
+        _geoToFaceIjk(&points[i], res, &fijk);
+        out[i] = _faceIjkToH3(&fijk, res);
+        if (NEVER(out[i] == H3_NULL)) {
+            result = E_FAILED;
+        }
+    }
+    return result;
+}
+
 /**
  * Convert an H3Index to the FaceIJK address on a specified icosahedral face.
  * @param h The H3Index.
@@ -808,17 +1024,7 @@ int _h3ToFaceIjkWithInitializedFijk(H3Index h, FaceIJK *fijk) {
          (fijk->coord.i == 0 && fijk->coord.j == 0 && fijk->coord.k == 0)))
         possibleOverage = 0;
 
-    for (int r = 1; r <= res; r++) {
-        if (isResolutionClassIII(r)) {
-            // Class III == rotate ccw
-            _downAp7(ijk);
-        } else {
-            // Class II == rotate cw
-            _downAp7r(ijk);
-        }
-
-        _neighbor(ijk, H3_GET_INDEX_DIGIT(h, r));
-    }
+    _resolutionKernels(res)->digitsToFaceIjk(h, ijk);
 
     return possibleOverage;
 }
@@ -1051,98 +1257,138 @@ H3Error H3_EXPORT(getPentagons)(int res, H3Index *out) {
  */
 int isResolutionClassIII(int res) { return res % 2; }
 
+/** Powers of 7, indexed by exponent, for cell rank arithmetic */
+static const int64_t POW7[MAX_H3_RES + 1] = {1LL,
+                                             7LL,
+                                             49LL,
+                                             343LL,
+                                             2401LL,
+                                             16807LL,
+                                             117649LL,
+                                             823543LL,
+                                             5764801LL,
+                                             40353607LL,
+                                             282475249LL,
+                                             1977326743LL,
+                                             13841287201LL,
+                                             96889010407LL,
+                                             678223072849LL,
+                                             4747561509943LL};
+
 /**
- * Validate a child position in the context of a given parent, returning
- * an error if validation fails.
+ * Number of descendants a pentagon has, counting itself, n resolutions finer.
  */
-static H3Error validateChildPos(int64_t childPos, H3Index parent,
-                                int childRes) {
-    int64_t maxChildCount;
-    H3Error sizeError =
-        H3_EXPORT(cellToChildrenSize)(parent, childRes, &maxChildCount);
-    if (NEVER(sizeError)) {
-        return sizeError;
-    }
-    if (childPos < 0 || childPos >= maxChildCount) {
-        return E_DOMAIN;
-    }
-    return E_SUCCESS;
+static inline int64_t _pentagonDescendants(int n) {
+    return 1 + (5 * (POW7[n] - 1)) / 6;
 }
 
 /**
- * Returns the position of the cell within an ordered list of all children of
- * the cell's parent at the specified resolution
+ * Returns whether all digits of a cell from resolution 1 through res are
+ * zero, that is, whether its ancestor at res is the center of its base cell.
  */
-H3Error H3_EXPORT(cellToChildPos)(H3Index child, int parentRes, int64_t *out) {
-    int childRes = H3_GET_RESOLUTION(child);
-    // Get the parent at res. This will catch any resolution errors
-    H3Index originalParent;
-    H3Error parentError =
-        H3_EXPORT(cellToParent(child, parentRes, &originalParent));
-    if (parentError) {
-        return parentError;
-    }
-
-    // Define the initial parent. Note that these variables are reassigned
-    // within the loop.
-    H3Index parent = originalParent;
-    int parentIsPentagon = H3_EXPORT(isPentagon)(parent);
-
-    // Walk up the resolution digits, incrementing the index
-    *out = 0;
-    if (parentIsPentagon) {
-        // Pentagon logic. Pentagon parents skip the 1 digit, so the offsets are
-        // different from hexagons
-        for (int res = childRes; res > parentRes; res--) {
-            H3Error parentError =
-                H3_EXPORT(cellToParent(child, res - 1, &parent));
-            if (NEVER(parentError)) {
-                return parentError;
-            }
+static inline bool _isBaseCellCenterAtRes(H3Index h, int res) {
+    H3Index digits = h >> ((MAX_H3_RES - res) * H3_PER_DIGIT_OFFSET);
+    return (digits & ((UINT64_C(1) << (res * H3_PER_DIGIT_OFFSET)) - 1)) == 0;
+}
 
-            parentIsPentagon = H3_EXPORT(isPentagon)(parent);
-            int rawDigit = H3_GET_INDEX_DIGIT(child, res);
-            // Validate the digit before proceeding
-            if (rawDigit == INVALID_DIGIT ||
-                (parentIsPentagon && rawDigit == K_AXES_DIGIT)) {
-                return E_CELL_INVALID;
-            }
-            int digit =
-                parentIsPentagon && rawDigit > 0 ? rawDigit - 1 : rawDigit;
-            if (digit != CENTER_DIGIT) {
-                int64_t hexChildCount = _ipow(7, childRes - res);
-                // The offset for the 0-digit slot depends on whether the
-                // current index is the child of a pentagon. If so, the offset
-                // is based on the count of pentagon children, otherwise,
-                // hexagon children.
-                *out += (parentIsPentagon
-                             ?  // pentagon children. See the explanation
-                                // for getNumCells in h3api.h.in
-                             1 + (5 * (hexChildCount - 1)) / 6
-                             :  // one hexagon's children
-                             hexChildCount) +
-                        // the other hexagon children
-                        (digit - 1) * hexChildCount;
-            }
+/**
+ * Number of descendants of a cell, counting itself, n resolutions finer.
+ */
+static inline int64_t _descendants(bool isPentagon, int n) {
+    return isPentagon ? _pentagonDescendants(n) : POW7[n];
+}
+
+/**
+ * Position of a cell among the descendants of its ancestor at parentRes, in
+ * the order cellToChildren produces them.
+ *
+ * @param cell The cell, at childRes
+ * @param parentRes Resolution of the ancestor
+ * @param childRes Resolution of the cell
+ * @param inPent Whether the ancestor is a pentagon
+ * @param out The position
+ * @return 0 on success, or E_CELL_INVALID if a digit is invalid.
+ */
+static H3Error _digitsToChildPos(H3Index cell, int parentRes, int childRes,
+                                 bool inPent, int64_t *out) {
+    int64_t pos = 0;
+    for (int r = parentRes + 1; r <= childRes; r++) {
+        Direction digit = H3_GET_INDEX_DIGIT(cell, r);
+        if (digit == INVALID_DIGIT) {
+            return E_CELL_INVALID;
         }
-    } else {
-        // Hexagon logic. Offsets are simple powers of 7
-        for (int res = childRes; res > parentRes; res--) {
-            int digit = H3_GET_INDEX_DIGIT(child, res);
-            if (digit == INVALID_DIGIT) {
+        int64_t width = POW7[childRes - r];
+        if (inPent) {
+            // Pentagon parents skip the 1 digit, so the offsets are different
+            // from hexagons. Only the leading non-zero digit is affected.
+            if (digit == CENTER_DIGIT) {
+                continue;
+            }
+            if (digit == K_AXES_DIGIT) {
                 return E_CELL_INVALID;
             }
-            *out += digit * _ipow(7, childRes - res);
+            // Skip the pentagon's own descendants and the missing K digit
+            pos += _pentagonDescendants(childRes - r) + (digit - 2) * width;
+            inPent = false;
+        } else {
+            pos += digit * width;
         }
     }
+    *out = pos;
+    return E_SUCCESS;
+}
 
-    if (NEVER(validateChildPos(*out, originalParent, childRes))) {
-        // This is the result of an internal error, so return E_FAILED
-        // instead of the validation error
-        return E_FAILED;
+/**
+ * Sets the digits of a cell from a position among the descendants of its
+ * ancestor at parentRes. This is the inverse of _digitsToChildPos. The
+ * position must be in range.
+ *
+ * @param pos The position
+ * @param parentRes Resolution of the ancestor
+ * @param childRes Resolution of the cell
+ * @param inPent Whether the ancestor is a pentagon
+ * @param cell The cell, whose digits are set
+ */
+static void _childPosToDigits(int64_t pos, int parentRes, int childRes,
+                              bool inPent, H3Index *cell) {
+    int r = parentRes + 1;
+    // While inside a parent pentagon, check whether this cell is a pentagon,
+    // and if not offset its digit to account for the skipped direction
+    for (; inPent && r <= childRes; r++) {
+        int64_t pentWidth = _pentagonDescendants(childRes - r);
+        if (pos < pentWidth) {
+            H3_SET_INDEX_DIGIT(*cell, r, CENTER_DIGIT);
+        } else {
+            int64_t width = POW7[childRes - r];
+            pos -= pentWidth;
+            H3_SET_INDEX_DIGIT(*cell, r, (pos / width) + 2);
+            pos %= width;
+            inPent = false;
+        }
+    }
+    // The remaining digits are simply base 7, finest first
+    for (int digitRes = childRes; digitRes >= r; digitRes--) {
+        H3_SET_INDEX_DIGIT(*cell, digitRes, pos % 7);
+        pos /= 7;
     }
+}
 
-    return E_SUCCESS;
+/**
+ * Returns the position of the cell within an ordered list of all children of
+ * the cell's parent at the specified resolution
+ */
+H3Error H3_EXPORT(cellToChildPos)(H3Index child, int parentRes, int64_t *out) {
+    int childRes = H3_GET_RESOLUTION(child);
+    if (parentRes < 0 || parentRes > MAX_H3_RES) {
+        return E_RES_DOMAIN;
+    } else if (parentRes > childRes) {
+        return E_RES_MISMATCH;
+    }
+    bool parentIsPentagon =
+        _isBaseCellPentagon(H3_GET_BASE_CELL(child)) &&
+        _isBaseCellCenterAtRes(child, parentRes);
+    return _digitsToChildPos(child, parentRes, childRes, parentIsPentagon,
+                             out);
 }
 
 /**
@@ -1160,52 +1406,315 @@ H3Error H3_EXPORT(childPosToCell)(int64_t childPos, H3Index parent,
         return E_RES_MISMATCH;
     }
     // Validate child pos
-    H3Error childPosErr = validateChildPos(childPos, parent, childRes);
-    if (childPosErr) {
-        return childPosErr;
+    bool parentIsPentagon = H3_EXPORT(isPentagon)(parent);
+    if (childPos < 0 ||
+        childPos >= _descendants(parentIsPentagon, childRes - parentRes)) {
+        return E_DOMAIN;
     }
 
-    int resOffset = childRes - parentRes;
-
     *child = parent;
-    int64_t idx = childPos;
-
     H3_SET_RESOLUTION(*child, childRes);
+    _childPosToDigits(childPos, parentRes, childRes, parentIsPentagon, child);
+    return E_SUCCESS;
+}
 
-    if (H3_EXPORT(isPentagon)(parent)) {
-        // Pentagon tile logic. Pentagon tiles skip the 1 digit, so the offsets
-        // are different
-        bool inPent = true;
-        for (int res = 1; res <= resOffset; res++) {
-            int64_t resWidth = _ipow(7, resOffset - res);
-            if (inPent) {
-                // While we are inside a parent pentagon, we need to check if
-                // this cell is a pentagon, and if not, we need to offset its
-                // digit to account for the skipped direction
-                int64_t pentWidth = 1 + (5 * (resWidth - 1)) / 6;
-                if (idx < pentWidth) {
-                    H3_SET_INDEX_DIGIT(*child, parentRes + res, 0);
-                } else {
-                    idx -= pentWidth;
-                    inPent = false;
-                    H3_SET_INDEX_DIGIT(*child, parentRes + res,
-                                       (idx / resWidth) + 2);
-                    idx %= resWidth;
-                }
-            } else {
-                // We're no longer inside a pentagon, continue as for hex
-                H3_SET_INDEX_DIGIT(*child, parentRes + res, idx / resWidth);
-                idx %= resWidth;
-            }
+/**
+ * Returns the position of each of a set of cells within an ordered list of
+ * all children of its parent at the specified resolution. See cellToChildPos.
+ *
+ * @param children The cells
+ * @param numChildren Number of cells
+ * @param parentRes Resolution of the parents
+ * @param out The position of each cell
+ * @return 0 on success, or the error for the first cell that fails.
+ */
+H3Error H3_EXPORT(cellsToChildPos)(const H3Index *children,
+                                   const int64_t numChildren, int parentRes,
+                                   int64_t *out) {
+    for (int64_t i = 0; i < numChildren; i++) {
+        H3Error err =
+            H3_EXPORT(cellToChildPos)(children[i], parentRes, &out[i]);
+        if (err) {
+            return err;
         }
-    } else {
-        // Hexagon tile logic. Offsets are simple powers of 7
-        for (int res = 1; res <= resOffset; res++) {
-            int64_t resWidth = _ipow(7, resOffset - res);
-            H3_SET_INDEX_DIGIT(*child, parentRes + res, idx / resWidth);
-            idx %= resWidth;
+    }
+    return E_SUCCESS;
+}
+
+/**
+ * Returns the child cells at each of a set of positions within an ordered
+ * list of all children of a parent at the specified resolution. See
+ * childPosToCell.
+ *
+ * @param childPos The positions
+ * @param numChildPos Number of positions
+ * @param parent The parent cell
+ * @param childRes Resolution of the children
+ * @param children The child at each position
+ * @return 0 on success, or another value if the resolution is invalid or
+ * any position is out of range.
+ */
+H3Error H3_EXPORT(childPosToCells)(const int64_t *childPos,
+                                   const int64_t numChildPos, H3Index parent,
+                                   int childRes, H3Index *children) {
+    if (childRes < 0 || childRes > MAX_H3_RES) {
+        return E_RES_DOMAIN;
+    }
+    int parentRes = H3_GET_RESOLUTION(parent);
+    if (childRes < parentRes) {
+        return E_RES_MISMATCH;
+    }
+    bool parentIsPentagon = H3_EXPORT(isPentagon)(parent);
+    int64_t numChildren = _descendants(parentIsPentagon, childRes - parentRes);
+    H3Index childBase = parent;
+    H3_SET_RESOLUTION(childBase, childRes);
+    for (int64_t i = 0; i < numChildPos; i++) {
+        if (childPos[i] < 0 || childPos[i] >= numChildren) {
+            return E_DOMAIN;
+        }
+        children[i] = childBase;
+        _childPosToDigits(childPos[i], parentRes, childRes, parentIsPentagon,
+                          &children[i]);
+    }
+    return E_SUCCESS;
+}
+
+/**
+ * Rank of the first cell of a base cell at a resolution. Every hexagon base
+ * cell has 7^res descendants, and pentagon base cells have fewer.
+ */
+static inline int64_t _baseCellRankOffset(int baseCell, int res) {
+    return baseCell * POW7[res] -
+           _baseCellPentagonsBefore(baseCell) *
+               (POW7[res] - _pentagonDescendants(res));
+}
+
+/**
+ * Rank of a cell among all cells at its resolution. See cellToRank.
+ */
+static H3Error _cellToRank(H3Index cell, int64_t *out) {
+    // Bits outside of the digits up to res would otherwise alias the rank
+    // of a valid cell
+    if (!H3_EXPORT(isValidCell)(cell)) {
+        return E_CELL_INVALID;
+    }
+    int res = H3_GET_RESOLUTION(cell);
+    int baseCell = H3_GET_BASE_CELL(cell);
+
+    int64_t rank;
+    H3Error err = _digitsToChildPos(cell, 0, res,
+                                    _isBaseCellPentagon(baseCell), &rank);
+    if (NEVER(err)) {
+        return err;
+    }
+    *out = _baseCellRankOffset(baseCell, res) + rank;
+    return E_SUCCESS;
+}
+
+/**
+ * Cell with a rank among all cells at a resolution. See rankToCell.
+ */
+static H3Error _rankToCell(int64_t rank, int res, int64_t numCells,
+                           H3Index *out) {
+    if (rank < 0 || rank >= numCells) {
+        return E_DOMAIN;
+    }
+
+    // rank / 7^res is a lower bound for the base cell, since pentagon base
+    // cells have fewer descendants. Walk forward past the pentagons.
+    int baseCell = (int)(rank / POW7[res]);
+    while (baseCell + 1 < NUM_BASE_CELLS &&
+           _baseCellRankOffset(baseCell + 1, res) <= rank) {
+        baseCell++;
+    }
+    int64_t idx = rank - _baseCellRankOffset(baseCell, res);
+
+    H3Index cell = H3_INIT;
+    H3_SET_MODE(cell, H3_CELL_MODE);
+    H3_SET_RESOLUTION(cell, res);
+    H3_SET_BASE_CELL(cell, baseCell);
+
+    _childPosToDigits(idx, 0, res, _isBaseCellPentagon(baseCell), &cell);
+    *out = cell;
+    return E_SUCCESS;
+}
+
+/**
+ * Returns the rank of a cell among all cells at its resolution, a number
+ * from 0 to getNumCells(res) - 1. Ranks are ordered by base cell, then by
+ * position within the base cell as in cellToChildPos, so every cell at a
+ * resolution has a distinct rank with no gaps.
+ *
+ * @param cell The cell
+ * @param out The rank of the cell
+ * @return 0 on success, or E_CELL_INVALID if the cell is invalid.
+ */
+H3Error H3_EXPORT(cellToRank)(H3Index cell, int64_t *out) {
+    return _cellToRank(cell, out);
+}
+
+/**
+ * Returns the cell with a given rank among all cells at a resolution. This
+ * is the inverse of cellToRank.
+ *
+ * @param rank Rank of the cell, from 0 to getNumCells(res) - 1
+ * @param res Resolution of the cell
+ * @param out The cell
+ * @return 0 on success, E_RES_DOMAIN if the resolution is invalid, or
+ * E_DOMAIN if the rank is out of range.
+ */
+H3Error H3_EXPORT(rankToCell)(int64_t rank, int res, H3Index *out) {
+    int64_t numCells;
+    H3Error numCellsError = H3_EXPORT(getNumCells)(res, &numCells);
+    if (numCellsError) {
+        return numCellsError;
+    }
+    return _rankToCell(rank, res, numCells, out);
+}
+
+/**
+ * Returns the rank of each of a set of cells. See cellToRank.
+ *
+ * @param cells The cells, which may be at different resolutions
+ * @param numCells Number of cells
+ * @param out The rank of each cell
+ * @return 0 on success, or the error for the first invalid cell.
+ */
+H3Error H3_EXPORT(cellsToRanks)(const H3Index *cells, const int64_t numCells,
+                                int64_t *out) {
+    for (int64_t i = 0; i < numCells; i++) {
+        H3Error err = _cellToRank(cells[i], &out[i]);
+        if (err) {
+            return err;
         }
     }
+    return E_SUCCESS;
+}
 
+/**
+ * Returns the cell with each of a set of ranks at a resolution. See
+ * rankToCell.
+ *
+ * @param ranks The ranks
+ * @param numRanks Number of ranks
+ * @param res Resolution of the cells
+ * @param out The cell with each rank
+ * @return 0 on success, E_RES_DOMAIN if the resolution is invalid, or
+ * E_DOMAIN if any rank is out of range.
+ */
+H3Error H3_EXPORT(ranksToCells)(const int64_t *ranks, const int64_t numRanks,
+                                int res, H3Index *out) {
+    int64_t numCells;
+    H3Error numCellsError = H3_EXPORT(getNumCells)(res, &numCells);
+    if (numCellsError) {
+        return numCellsError;
+    }
+    for (int64_t i = 0; i < numRanks; i++) {
+        H3Error err = _rankToCell(ranks[i], res, numCells, &out[i]);
+        if (err) {
+            return err;
+        }
+    }
+    return E_SUCCESS;
+}
+
+/** Every index digit set to 6 (IJ_AXES_DIGIT) */
+#define ALL_SIX_DIGITS UINT64_C(0666666666666666)
+
+/**
+ * Returns the smallest and largest index of the children of a cell at a
+ * resolution. In a sorted list of cells at childRes, the children of the
+ * cell are exactly the cells from min to max, inclusive, so a sorted store
+ * can fetch all of them with one range scan.
+ *
+ * @param h The parent cell
+ * @param childRes Resolution of the children
+ * @param out The first and last child
+ * @return 0 on success, or E_RES_DOMAIN if childRes is not a valid child
+ * resolution of the cell.
+ */
+H3Error H3_EXPORT(cellToChildrenRange)(H3Index h, int childRes,
+                                       CellRange *out) {
+    if (!_hasChildAtRes(h, childRes)) return E_RES_DOMAIN;
+
+    // The digits from parentRes + 1 through childRes run from all 0 to all
+    // 6, so both bounds are a mask of those digits
+    int parentRes = H3_GET_RESOLUTION(h);
+    H3Index digitsMask =
+        ((UINT64_C(1) << ((childRes - parentRes) * H3_PER_DIGIT_OFFSET)) - 1)
+        << ((MAX_H3_RES - childRes) * H3_PER_DIGIT_OFFSET);
+    H3Index min = h & ~digitsMask;
+    H3_SET_RESOLUTION(min, childRes);
+    H3Index max = min | (ALL_SIX_DIGITS & digitsMask);
+    out->min = min;
+    out->max = max;
+    return E_SUCCESS;
+}
+
+static int _compareCellRanges(const void *a, const void *b) {
+    const CellRange *rangeA = (const CellRange *)a;
+    const CellRange *rangeB = (const CellRange *)b;
+    if (rangeA->min < rangeB->min) return -1;
+    if (rangeA->min > rangeB->min) return 1;
+    return 0;
+}
+
+/**
+ * Converts a compacted set of cells into the minimal sorted list of ranges
+ * of cells at a resolution covering the same area. Ranges of the children of
+ * neighboring cells in index order are merged, as are overlapping ranges.
+ *
+ * @param compactedSet The compacted set of cells. H3_NULL entries are
+ * skipped.
+ * @param numCompacted Number of cells in the compacted set
+ * @param res Resolution of the cells in the ranges
+ * @param out The ranges, sorted. Must have room for numCompacted ranges.
+ * @param numRanges The number of ranges written to out
+ * @return 0 on success, or another value if a cell is invalid or finer than
+ * res.
+ */
+H3Error H3_EXPORT(compactCellsToRanges)(const H3Index *compactedSet,
+                                        const int64_t numCompacted,
+                                        const int res, CellRange *out,
+                                        int64_t *numRanges) {
+    int64_t count = 0;
+    for (int64_t i = 0; i < numCompacted; i++) {
+        if (compactedSet[i] == H3_NULL) {
+            continue;
+        }
+        if (!_hasChildAtRes(compactedSet[i], res)) return E_RES_MISMATCH;
+        H3_EXPORT(cellToChildrenRange)(compactedSet[i], res, &out[count]);
+        count++;
+    }
+    qsort(out, count, sizeof(CellRange), _compareCellRanges);
+
+    // Index order at a resolution is rank order, so two ranges can be
+    // joined if the next range starts on or before the cell after the
+    // current range ends
+    int64_t merged = 0;
+    int64_t lastRank = 0;
+    for (int64_t i = 0; i < count; i++) {
+        int64_t minRank;
+        int64_t maxRank;
+        H3Error minError = _cellToRank(out[i].min, &minRank);
+        if (minError) {
+            return minError;
+        }
+        H3Error maxError = _cellToRank(out[i].max, &maxRank);
+        if (NEVER(maxError)) {
+            return maxError;
+        }
+        if (merged > 0 && minRank <= lastRank + 1) {
+            if (maxRank > lastRank) {
+                out[merged - 1].max = out[i].max;
+                lastRank = maxRank;
+            }
+        } else {
+            out[merged] = out[i];
+            lastRank = maxRank;
+            merged++;
+        }
+    }
+    *numRanges = merged;
     return E_SUCCESS;
 }
@@ -0,0 +1,62 @@
+/*
+ * Copyright 2023 Uber Technologies, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/** @file hotPathCounters.c
+ * @brief   Access to the counters of work done in the core algorithms
+ *
+ * The counters are global and are not synchronized, so they are only exact
+ * while a single thread calls the library.
+ */
+
+#include "hotPathCounters.h"
+
+#include "h3api.h"
+
+#ifdef H3_HOT_PATH_COUNTERS
+HotPathCounters _hotPathCounters;
+#endif
+
+/**
+ * Returns the counters of work done in the core algorithms since the last
+ * call to resetHotPathCounters, or since the program started.
+ *
+ * @param out The counters. Set to zero if counters are not kept.
+ * @return 0 (E_SUCCESS) on success, or E_FAILED if this build of the
+ * library does not keep counters.
+ */
+H3Error H3_EXPORT(getHotPathCounters)(HotPathCounters *out) {
+#ifdef H3_HOT_PATH_COUNTERS
+    *out = _hotPathCounters;
+    return E_SUCCESS;
+#else
+    *out = (HotPathCounters){0};
+    return E_FAILED;
+#endif
+}
+
+/**
+ * Resets the counters of work done in the core algorithms to zero.
+ *
+ * @return 0 (E_SUCCESS) on success, or E_FAILED if this build of the
+ * library does not keep counters.
+ */
+H3Error H3_EXPORT(resetHotPathCounters)(void) {
+#ifdef H3_HOT_PATH_COUNTERS
+    _hotPathCounters = (HotPathCounters){0};
+    return E_SUCCESS;
+#else
+    return E_FAILED;
+#endif
+}
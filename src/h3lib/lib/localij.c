@@ -113,36 +113,62 @@ const bool FAILED_DIRECTIONS[7][7] = {
 };
 
 /**
- * Produces ijk+ coordinates for an index anchored by an origin.
- *
- * The coordinate space used by this function may have deleted
- * regions or warping due to pentagonal distortion.
+ * Offset, in the origin base cell's ijk+ coordinate space at resolution res,
+ * to the center of the neighboring base cell in direction dir.
  *
- * Coordinates are only comparable if they come from the same
- * origin index.
- *
- * Failure may occur if the index is too far away from the origin
- * or if the index is on the other side of a pentagon.
+ * @param dir Direction from the origin base cell to the neighbor
+ * @param res Resolution of the coordinate space
+ * @param directionRotations Rotations 60 cw for pentagon origins
+ * @param out The offset
+ */
+static void _baseCellOffset(Direction dir, int res, int directionRotations,
+                            CoordIJK *out) {
+    CoordIJK offset = {0};
+    _neighbor(&offset, dir);
+    // Scale offset based on resolution
+    for (int r = res - 1; r >= 0; r--) {
+        if (isResolutionClassIII(r + 1)) {
+            // rotate ccw
+            _downAp7(&offset);
+        } else {
+            // rotate cw
+            _downAp7r(&offset);
+        }
+    }
+
+    for (int i = 0; i < directionRotations; i++) {
+        _ijkRotate60cw(&offset);
+    }
+    *out = offset;
+}
+
+/**
+ * Produces ijk+ coordinates for an index anchored by an origin, given the
+ * origin's decoded properties. Shared by cellToLocalIjk and the prepared
+ * origin functions.
  *
- * @param origin An anchoring index for the ijk+ coordinate system.
- * @param index Index to find the coordinates of
+ * @param origin The anchoring index
+ * @param originBaseCell Base cell of the origin, already validated
+ * @param originLeadingDigit Leading non-zero digit of the origin, only used
+ * if the origin is on a pentagon base cell
+ * @param offsets Precomputed _baseCellOffset for each direction, or NULL to
+ * compute the needed offset
+ * @param h3 Index to find the coordinates of
  * @param out ijk+ coordinates of the index will be placed here on success
  * @return 0 on success, or another value on failure.
  */
-H3Error cellToLocalIjk(H3Index origin, H3Index h3, CoordIJK *out) {
+static H3Error _cellToLocalIjk(H3Index origin, int originBaseCell,
+                               Direction originLeadingDigit,
+                               const CoordIJK *offsets, H3Index h3,
+                               CoordIJK *out) {
     int res = H3_GET_RESOLUTION(origin);
 
     if (res != H3_GET_RESOLUTION(h3)) {
         return E_RES_MISMATCH;
     }
 
-    int originBaseCell = H3_GET_BASE_CELL(origin);
     int baseCell = H3_GET_BASE_CELL(h3);
 
-    if (NEVER(originBaseCell < 0) || originBaseCell >= NUM_BASE_CELLS) {
-        // Base cells less than zero can not be represented in an index
-        return E_CELL_INVALID;
-    }
     if (NEVER(baseCell < 0) || baseCell >= NUM_BASE_CELLS) {
         // Base cells less than zero can not be represented in an index
         return E_CELL_INVALID;
@@ -195,8 +221,6 @@ H3Error cellToLocalIjk(H3Index origin, H3Index h3, CoordIJK *out) {
         int directionRotations = 0;
 
         if (originOnPent) {
-            int originLeadingDigit = _h3LeadingNonZeroDigit(origin);
-
             if (originLeadingDigit == INVALID_DIGIT) {
                 return E_CELL_INVALID;
             }
@@ -234,21 +258,11 @@ H3Error cellToLocalIjk(H3Index origin, H3Index h3, CoordIJK *out) {
             _ijkRotate60cw(&indexFijk.coord);
         }
 
-        CoordIJK offset = {0};
-        _neighbor(&offset, dir);
-        // Scale offset based on resolution
-        for (int r = res - 1; r >= 0; r--) {
-            if (isResolutionClassIII(r + 1)) {
-                // rotate ccw
-                _downAp7(&offset);
-            } else {
-                // rotate cw
-                _downAp7r(&offset);
-            }
-        }
-
-        for (int i = 0; i < directionRotations; i++) {
-            _ijkRotate60cw(&offset);
+        CoordIJK offset;
+        if (offsets) {
+            offset = offsets[dir];
+        } else {
+            _baseCellOffset(dir, res, directionRotations, &offset);
         }
 
         // Perform necessary translation
@@ -260,7 +274,6 @@ H3Error cellToLocalIjk(H3Index origin, H3Index h3, CoordIJK *out) {
         // cell.
         assert(baseCell == originBaseCell);
 
-        int originLeadingDigit = _h3LeadingNonZeroDigit(origin);
         int indexLeadingDigit = _h3LeadingNonZeroDigit(h3);
 
         if (originLeadingDigit == INVALID_DIGIT ||
@@ -286,61 +299,206 @@ H3Error cellToLocalIjk(H3Index origin, H3Index h3, CoordIJK *out) {
 }
 
 /**
- * Produces an index for ijk+ coordinates anchored by an origin.
+ * Produces ijk+ coordinates for an index anchored by an origin.
  *
  * The coordinate space used by this function may have deleted
  * regions or warping due to pentagonal distortion.
  *
- * Failure may occur if the coordinates are too far away from the origin
+ * Coordinates are only comparable if they come from the same
+ * origin index.
+ *
+ * Failure may occur if the index is too far away from the origin
  * or if the index is on the other side of a pentagon.
  *
  * @param origin An anchoring index for the ijk+ coordinate system.
- * @param ijk IJK+ Coordinates to find the index of
- * @param out The index will be placed here on success
+ * @param index Index to find the coordinates of
+ * @param out ijk+ coordinates of the index will be placed here on success
  * @return 0 on success, or another value on failure.
  */
-H3Error localIjkToCell(H3Index origin, const CoordIJK *ijk, H3Index *out) {
-    int res = H3_GET_RESOLUTION(origin);
+H3Error cellToLocalIjk(H3Index origin, H3Index h3, CoordIJK *out) {
+    if (H3_GET_RESOLUTION(origin) != H3_GET_RESOLUTION(h3)) {
+        return E_RES_MISMATCH;
+    }
+
     int originBaseCell = H3_GET_BASE_CELL(origin);
+
     if (NEVER(originBaseCell < 0) || originBaseCell >= NUM_BASE_CELLS) {
         // Base cells less than zero can not be represented in an index
         return E_CELL_INVALID;
     }
-    int originOnPent = _isBaseCellPentagon(originBaseCell);
 
-    // This logic is very similar to faceIjkToH3
-    // initialize the index
-    *out = H3_INIT;
-    H3_SET_MODE(*out, H3_CELL_MODE);
-    H3_SET_RESOLUTION(*out, res);
+    Direction originLeadingDigit = CENTER_DIGIT;
+    if (_isBaseCellPentagon(originBaseCell)) {
+        originLeadingDigit = _h3LeadingNonZeroDigit(origin);
+    }
 
-    // check for res 0/base cell
-    if (res == 0) {
-        const Direction dir = _unitIjkToDigit(ijk);
-        if (dir == INVALID_DIGIT) {
-            // out of range input - not a unit vector or zero vector
-            return E_FAILED;
+    return _cellToLocalIjk(origin, originBaseCell, originLeadingDigit, NULL,
+                           h3, out);
+}
+
+/**
+ * Copies prepared ijk+ coordinates out of a LocalIjOrigin field.
+ */
+static inline void _unpackIjk(const int packed[3], CoordIJK *out) {
+    out->i = packed[0];
+    out->j = packed[1];
+    out->k = packed[2];
+}
+
+/**
+ * Copies ijk+ coordinates into a LocalIjOrigin field.
+ */
+static inline void _packIjk(const CoordIJK *ijk, int packed[3]) {
+    packed[0] = ijk->i;
+    packed[1] = ijk->j;
+    packed[2] = ijk->k;
+}
+
+/**
+ * Prepares an origin for repeated cellToLocalIj and gridDistance operations.
+ * The origin's own coordinates and the offsets to each neighboring base cell
+ * are computed once here instead of on every call.
+ *
+ * @param origin An anchoring index for the ij coordinate system.
+ * @param out The prepared origin
+ * @return 0 on success, or another value if the origin is invalid.
+ */
+H3Error H3_EXPORT(prepareLocalIjOrigin)(H3Index origin, LocalIjOrigin *out) {
+    CoordIJK originIjk;
+    H3Error err = cellToLocalIjk(origin, origin, &originIjk);
+    if (err) {
+        return err;
+    }
+
+    int res = H3_GET_RESOLUTION(origin);
+    int originBaseCell = H3_GET_BASE_CELL(origin);
+    Direction originLeadingDigit = CENTER_DIGIT;
+    int originOnPent = _isBaseCellPentagon(originBaseCell);
+    if (originOnPent) {
+        originLeadingDigit = _h3LeadingNonZeroDigit(origin);
+    }
+
+    out->origin = origin;
+    out->baseCell = originBaseCell;
+    out->leadingDigit = originLeadingDigit;
+    _packIjk(&originIjk, out->ijk);
+    memset(out->offsets, 0, sizeof(out->offsets));
+    for (Direction dir = K_AXES_DIGIT; dir < NUM_DIGITS; dir++) {
+        int directionRotations = 0;
+        if (originOnPent && originLeadingDigit != INVALID_DIGIT) {
+            directionRotations = PENTAGON_ROTATIONS[originLeadingDigit][dir];
+            if (directionRotations < 0) {
+                // Not usable, _cellToLocalIjk fails before reading it
+                continue;
+            }
         }
+        CoordIJK offset;
+        _baseCellOffset(dir, res, directionRotations, &offset);
+        _packIjk(&offset, out->offsets[dir]);
+    }
+    return E_SUCCESS;
+}
 
-        const int newBaseCell = _getBaseCellNeighbor(originBaseCell, dir);
-        if (newBaseCell == INVALID_BASE_CELL) {
-            // Moving in an invalid direction off a pentagon.
-            return E_FAILED;
+/**
+ * Produces ij coordinates for each of a set of indexes, anchored by a
+ * prepared origin. Equivalent to calling cellToLocalIj for each index.
+ *
+ * @param origin Origin prepared by prepareLocalIjOrigin
+ * @param cells Indexes to find the coordinates of
+ * @param numCells Number of indexes
+ * @param mode Mode, must be 0
+ * @param out ij coordinates of each index
+ * @param errors Result of the conversion of each index. If NULL, the
+ * function instead stops at and returns the first error.
+ * @return 0 on success, or another value on failure.
+ */
+H3Error H3_EXPORT(cellsToLocalIjFromOrigin)(const LocalIjOrigin *origin,
+                                            const H3Index *cells,
+                                            const int64_t numCells,
+                                            uint32_t mode, CoordIJ *out,
+                                            H3Error *errors) {
+    if (mode != 0) {
+        return E_OPTION_INVALID;
+    }
+    CoordIJK offsets[NUM_DIGITS];
+    for (int dir = 0; dir < NUM_DIGITS; dir++) {
+        _unpackIjk(origin->offsets[dir], &offsets[dir]);
+    }
+    for (int64_t i = 0; i < numCells; i++) {
+        CoordIJK ijk;
+        H3Error err =
+            _cellToLocalIjk(origin->origin, origin->baseCell,
+                            origin->leadingDigit, offsets, cells[i], &ijk);
+        if (errors) {
+            errors[i] = err;
+        } else if (err) {
+            return err;
+        }
+        if (!err) {
+            ijkToIj(&ijk, &out[i]);
         }
-        H3_SET_BASE_CELL(*out, newBaseCell);
-        return E_SUCCESS;
     }
+    return E_SUCCESS;
+}
 
-    // we need to find the correct base cell offset (if any) for this H3 index;
-    // start with the passed in base cell and resolution res ijk coordinates
-    // in that base cell's coordinate system
-    CoordIJK ijkCopy = *ijk;
+/**
+ * Produces the grid distance from a prepared origin to each of a set of
+ * indexes. Equivalent to calling gridDistance for each index.
+ *
+ * @param origin Origin prepared by prepareLocalIjOrigin
+ * @param cells Indexes to find the distance to
+ * @param numCells Number of indexes
+ * @param out Distance to each index, or -1 if the distance could not be
+ * computed for that index
+ * @return 0 on success, or another value on failure.
+ */
+H3Error H3_EXPORT(gridDistancesFromOrigin)(const LocalIjOrigin *origin,
+                                           const H3Index *cells,
+                                           const int64_t numCells,
+                                           int64_t *out) {
+    CoordIJK originIjk;
+    _unpackIjk(origin->ijk, &originIjk);
+    CoordIJK offsets[NUM_DIGITS];
+    for (int dir = 0; dir < NUM_DIGITS; dir++) {
+        _unpackIjk(origin->offsets[dir], &offsets[dir]);
+    }
+    for (int64_t i = 0; i < numCells; i++) {
+        CoordIJK ijk;
+        H3Error err =
+            _cellToLocalIjk(origin->origin, origin->baseCell,
+                            origin->leadingDigit, offsets, cells[i], &ijk);
+        out[i] = err ? -1 : ijkDistance(&originIjk, &ijk);
+    }
+    return E_SUCCESS;
+}
+
+/**
+ * Builds the index digits for ijk+ coordinates, from the finest resolution
+ * up, recording the coordinates at each coarser resolution in levels.
+ *
+ * If cached is set, levels and digits must hold the result of a previous
+ * successful call at the same resolution. Once the coordinates at some
+ * resolution match the previous call, all coarser digits are also the same,
+ * so only the finer digits are rebuilt.
+ *
+ * @param res Resolution of the coordinates
+ * @param ijk IJK+ Coordinates to find the digits of
+ * @param cached Whether levels and digits hold a previous result
+ * @param levels Coordinates at each resolution, levels[0] is the base cell
+ * offset on success
+ * @param digits The index digits are set here, without rotations applied
+ * @return 0 on success, or another value on failure.
+ */
+static H3Error _localIjkToDigits(int res, const CoordIJK *ijk, bool cached,
+                                 CoordIJK levels[MAX_H3_RES + 1],
+                                 H3Index *digits) {
+    levels[res] = *ijk;
 
     // build the H3Index from finest res up
     // adjust r for the fact that the res 0 base cell offsets the indexing
     // digits
     for (int r = res - 1; r >= 0; r--) {
-        CoordIJK lastIJK = ijkCopy;
+        CoordIJK ijkCopy = levels[r + 1];
         CoordIJK lastCenter;
         if (isResolutionClassIII(r + 1)) {
             // rotate ccw
@@ -361,22 +519,46 @@ H3Error localIjkToCell(H3Index origin, const CoordIJK *ijk, H3Index *out) {
         }
 
         CoordIJK diff;
-        _ijkSub(&lastIJK, &lastCenter, &diff);
+        _ijkSub(&levels[r + 1], &lastCenter, &diff);
         _ijkNormalize(&diff);
 
-        H3_SET_INDEX_DIGIT(*out, r + 1, _unitIjkToDigit(&diff));
+        H3_SET_INDEX_DIGIT(*digits, r + 1, _unitIjkToDigit(&diff));
+
+        if (cached && _ijkMatches(&ijkCopy, &levels[r])) {
+            // The coarser digits are unchanged from the previous call
+            break;
+        }
+        levels[r] = ijkCopy;
     }
+    return E_SUCCESS;
+}
+
+/**
+ * Finishes an index whose digits were built by _localIjkToDigits, choosing
+ * the base cell and undoing the rotations between the origin's base cell and
+ * the index's base cell.
+ *
+ * @param origin An anchoring index for the ijk+ coordinate system.
+ * @param originBaseCell Base cell of the origin
+ * @param baseIjk Base cell offset from _localIjkToDigits
+ * @param out Index digits from _localIjkToDigits, the finished index will
+ * be placed here on success
+ * @return 0 on success, or another value on failure.
+ */
+static H3Error _localIjkFinish(H3Index origin, int originBaseCell,
+                               const CoordIJK *baseIjk, H3Index *out) {
+    int originOnPent = _isBaseCellPentagon(originBaseCell);
 
-    // ijkCopy should now hold the IJK of the base cell in the
+    // baseIjk should hold the IJK of the base cell in the
     // coordinate system of the current base cell
 
-    if (ijkCopy.i > 1 || ijkCopy.j > 1 || ijkCopy.k > 1) {
+    if (baseIjk->i > 1 || baseIjk->j > 1 || baseIjk->k > 1) {
         // out of range input
         return E_FAILED;
     }
 
     // lookup the correct base cell
-    Direction dir = _unitIjkToDigit(&ijkCopy);
+    Direction dir = _unitIjkToDigit(baseIjk);
     int baseCell = _getBaseCellNeighbor(originBaseCell, dir);
     // If baseCell is invalid, it must be because the origin base cell is a
     // pentagon, and because pentagon base cells do not border each other,
@@ -504,6 +686,62 @@ H3Error localIjkToCell(H3Index origin, const CoordIJK *ijk, H3Index *out) {
     return E_SUCCESS;
 }
 
+/**
+ * Produces an index for ijk+ coordinates anchored by an origin.
+ *
+ * The coordinate space used by this function may have deleted
+ * regions or warping due to pentagonal distortion.
+ *
+ * Failure may occur if the coordinates are too far away from the origin
+ * or if the index is on the other side of a pentagon.
+ *
+ * @param origin An anchoring index for the ijk+ coordinate system.
+ * @param ijk IJK+ Coordinates to find the index of
+ * @param out The index will be placed here on success
+ * @return 0 on success, or another value on failure.
+ */
+H3Error localIjkToCell(H3Index origin, const CoordIJK *ijk, H3Index *out) {
+    int res = H3_GET_RESOLUTION(origin);
+    int originBaseCell = H3_GET_BASE_CELL(origin);
+    if (NEVER(originBaseCell < 0) || originBaseCell >= NUM_BASE_CELLS) {
+        // Base cells less than zero can not be represented in an index
+        return E_CELL_INVALID;
+    }
+
+    // This logic is very similar to faceIjkToH3
+    // initialize the index
+    *out = H3_INIT;
+    H3_SET_MODE(*out, H3_CELL_MODE);
+    H3_SET_RESOLUTION(*out, res);
+
+    // check for res 0/base cell
+    if (res == 0) {
+        const Direction dir = _unitIjkToDigit(ijk);
+        if (dir == INVALID_DIGIT) {
+            // out of range input - not a unit vector or zero vector
+            return E_FAILED;
+        }
+
+        const int newBaseCell = _getBaseCellNeighbor(originBaseCell, dir);
+        if (newBaseCell == INVALID_BASE_CELL) {
+            // Moving in an invalid direction off a pentagon.
+            return E_FAILED;
+        }
+        H3_SET_BASE_CELL(*out, newBaseCell);
+        return E_SUCCESS;
+    }
+
+    // we need to find the correct base cell offset (if any) for this H3 index;
+    // start with the passed in base cell and resolution res ijk coordinates
+    // in that base cell's coordinate system
+    CoordIJK levels[MAX_H3_RES + 1];
+    H3Error digitsError = _localIjkToDigits(res, ijk, false, levels, out);
+    if (digitsError) {
+        return digitsError;
+    }
+    return _localIjkFinish(origin, originBaseCell, &levels[0], out);
+}
+
 /**
  * Produces ij coordinates for an index anchored by an origin.
  *
@@ -573,6 +811,162 @@ H3Error H3_EXPORT(localIjToCell)(H3Index origin, const CoordIJ *ij,
     return localIjkToCell(origin, &ijk, out);
 }
 
+/**
+ * Produces indexes for consecutive ijk+ coordinates anchored by an origin,
+ * reusing the coarse digits shared with the previous coordinates.
+ *
+ * @param origin An anchoring index for the ijk+ coordinate system.
+ * @param res Resolution of the origin
+ * @param originBaseCell Base cell of the origin
+ * @param ijk IJK+ Coordinates to find the index of
+ * @param cached Whether levels and digits hold a previous result, updated
+ * on return
+ * @param levels Coordinates at each resolution from the previous call
+ * @param digits Index digits from the previous call
+ * @return The index, or H3_NULL if there is no index at the coordinates.
+ */
+static H3Index _localIjkToCellCached(H3Index origin, int res,
+                                     int originBaseCell, const CoordIJK *ijk,
+                                     bool *cached,
+                                     CoordIJK levels[MAX_H3_RES + 1],
+                                     H3Index *digits) {
+    H3Index out;
+    if (res == 0) {
+        if (localIjkToCell(origin, ijk, &out)) {
+            return H3_NULL;
+        }
+        return out;
+    }
+    if (_localIjkToDigits(res, ijk, *cached, levels, digits)) {
+        *cached = false;
+        return H3_NULL;
+    }
+    *cached = true;
+    out = *digits;
+    if (_localIjkFinish(origin, originBaseCell, &levels[0], &out)) {
+        return H3_NULL;
+    }
+    return out;
+}
+
+/**
+ * Produces indexes for a list of ij coordinates anchored by an origin.
+ * Equivalent to calling localIjToCell for each coordinate, but faster when
+ * consecutive coordinates are near each other.
+ *
+ * @param origin An anchoring index for the ij coordinate system.
+ * @param ij ij coordinates to index
+ * @param numCoords Number of coordinates
+ * @param mode Mode, must be 0
+ * @param out The index of each coordinate, or H3_NULL if there is no index
+ * at that coordinate.
+ * @return 0 on success, or another value if the origin or mode is invalid.
+ */
+H3Error H3_EXPORT(localIjToCells)(H3Index origin, const CoordIJ *ij,
+                                  const int64_t numCoords, uint32_t mode,
+                                  H3Index *out) {
+    if (mode != 0) {
+        return E_OPTION_INVALID;
+    }
+    int res = H3_GET_RESOLUTION(origin);
+    int originBaseCell = H3_GET_BASE_CELL(origin);
+    if (NEVER(originBaseCell < 0) || originBaseCell >= NUM_BASE_CELLS) {
+        return E_CELL_INVALID;
+    }
+
+    bool cached = false;
+    CoordIJK levels[MAX_H3_RES + 1];
+    H3Index digits = H3_INIT;
+    H3_SET_MODE(digits, H3_CELL_MODE);
+    H3_SET_RESOLUTION(digits, res);
+    for (int64_t n = 0; n < numCoords; n++) {
+        CoordIJK ijk;
+        if (ijToIjk(&ij[n], &ijk)) {
+            out[n] = H3_NULL;
+            continue;
+        }
+        out[n] = _localIjkToCellCached(origin, res, originBaseCell, &ijk,
+                                       &cached, levels, &digits);
+    }
+    return E_SUCCESS;
+}
+
+/**
+ * Number of coordinates in an ij rectangle, for sizing the output of
+ * localIjRectToCells.
+ *
+ * @param min Minimum i and j of the rectangle, inclusive
+ * @param max Maximum i and j of the rectangle, inclusive
+ * @param out Number of coordinates in the rectangle
+ * @return 0 on success, or E_DOMAIN if the rectangle is empty or too large.
+ */
+H3Error H3_EXPORT(localIjRectSize)(const CoordIJ *min, const CoordIJ *max,
+                                   int64_t *out) {
+    if (max->i < min->i || max->j < min->j) {
+        return E_DOMAIN;
+    }
+    int64_t width = (int64_t)max->i - min->i + 1;
+    int64_t height = (int64_t)max->j - min->j + 1;
+    if (height > INT64_MAX / width) {
+        return E_DOMAIN;
+    }
+    *out = width * height;
+    return E_SUCCESS;
+}
+
+/**
+ * Produces indexes for every ij coordinate in a rectangle anchored by an
+ * origin. Output is ordered by j, then i, so out[(j - min->j) * width +
+ * (i - min->i)] holds the index at (i, j), where width is
+ * max->i - min->i + 1.
+ *
+ * @param origin An anchoring index for the ij coordinate system.
+ * @param min Minimum i and j of the rectangle, inclusive
+ * @param max Maximum i and j of the rectangle, inclusive
+ * @param mode Mode, must be 0
+ * @param out The index of each coordinate, or H3_NULL if there is no index
+ * at that coordinate. Must have room for localIjRectSize elements.
+ * @return 0 on success, or another value if the origin, mode, or rectangle
+ * is invalid.
+ */
+H3Error H3_EXPORT(localIjRectToCells)(H3Index origin, const CoordIJ *min,
+                                      const CoordIJ *max, uint32_t mode,
+                                      H3Index *out) {
+    if (mode != 0) {
+        return E_OPTION_INVALID;
+    }
+    int64_t size;
+    H3Error sizeError = H3_EXPORT(localIjRectSize)(min, max, &size);
+    if (sizeError) {
+        return sizeError;
+    }
+    int res = H3_GET_RESOLUTION(origin);
+    int originBaseCell = H3_GET_BASE_CELL(origin);
+    if (NEVER(originBaseCell < 0) || originBaseCell >= NUM_BASE_CELLS) {
+        return E_CELL_INVALID;
+    }
+
+    bool cached = false;
+    CoordIJK levels[MAX_H3_RES + 1];
+    H3Index digits = H3_INIT;
+    H3_SET_MODE(digits, H3_CELL_MODE);
+    H3_SET_RESOLUTION(digits, res);
+    int64_t n = 0;
+    for (int64_t j = min->j; j <= max->j; j++) {
+        for (int64_t i = min->i; i <= max->i; i++) {
+            CoordIJ ij = {.i = (int)i, .j = (int)j};
+            CoordIJK ijk;
+            if (ijToIjk(&ij, &ijk)) {
+                out[n++] = H3_NULL;
+                continue;
+            }
+            out[n++] = _localIjkToCellCached(origin, res, originBaseCell, &ijk,
+                                             &cached, levels, &digits);
+        }
+    }
+    return E_SUCCESS;
+}
+
 /**
  * Produces the grid distance between the two indexes.
  *
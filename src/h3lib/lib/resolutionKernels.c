@@ -0,0 +1,226 @@
+/*
+ * Copyright 2023 Uber Technologies, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/** @file resolutionKernels.c
+ * @brief   Encoding and decoding kernels for each resolution
+ */
+
+#include "resolutionKernels.h"
+
+#include <stdint.h>
+
+#include "coordijk.h"
+#include "h3Index.h"
+
+/*
+ * The steps below compute the same coordinates as _upAp7, _downAp7,
+ * _ijkNormalize, _unitIjkToDigit, and _neighbor in coordijk.c, written so
+ * that each step compiles without calls once unrolled.
+ */
+
+/**
+ * Rounds n / 7 to the nearest integer. The quotient is never halfway between
+ * integers, so this is the same as lroundl(n / 7.0L).
+ */
+static inline int _roundDiv7(int64_t n) {
+    return (int)(n >= 0 ? (2 * n + 7) / 14 : -((7 - 2 * n) / 14));
+}
+
+/**
+ * Normalizes ijk coordinates, as _ijkNormalize. The normalized coordinates
+ * are the only ones with no negative component and at least one zero, so
+ * they are found without branches from the IJ coordinates (k set to zero)
+ * less their minimum with zero.
+ */
+static inline void _normalize(CoordIJK *c) {
+    int i = c->i - c->k;
+    int j = c->j - c->k;
+    int min = i < j ? i : j;
+    min = min < 0 ? min : 0;
+    c->i = i - min;
+    c->j = j - min;
+    c->k = -min;
+}
+
+/**
+ * Moves ijk coordinates to those of the center child at the next finer
+ * resolution, as _downAp7 for Class III resolutions and _downAp7r for
+ * Class II.
+ */
+static inline void _downAp7ForClass(CoordIJK *ijk, int isClassIII) {
+    CoordIJK c = *ijk;
+    if (isClassIII) {
+        ijk->i = 3 * c.i + c.j;
+        ijk->j = 3 * c.j + c.k;
+        ijk->k = c.i + 3 * c.k;
+    } else {
+        ijk->i = 3 * c.i + c.k;
+        ijk->j = c.i + 3 * c.j;
+        ijk->k = c.j + 3 * c.k;
+    }
+    _normalize(ijk);
+}
+
+/**
+ * Finds the digit of resolution r from the IJK+ coordinates of a cell at
+ * that resolution, and replaces them with those of its parent.
+ * @param ijk The IJK+ coordinates at resolution r
+ * @param r   The resolution of the digit, from 1 to MAX_H3_RES
+ * @param h   The index whose digit is set
+ */
+static inline void _encodeDigit(CoordIJK *ijk, int r, H3Index *h) {
+    CoordIJK lastIJK = *ijk;
+    int64_t i = (int64_t)ijk->i - ijk->k;
+    int64_t j = (int64_t)ijk->j - ijk->k;
+    if (r % 2) {
+        // Class III == rotate ccw
+        ijk->i = _roundDiv7(3 * i - j);
+        ijk->j = _roundDiv7(i + 2 * j);
+    } else {
+        // Class II == rotate cw
+        ijk->i = _roundDiv7(2 * i + j);
+        ijk->j = _roundDiv7(3 * j - i);
+    }
+    ijk->k = 0;
+    _normalize(ijk);
+
+    CoordIJK diff = *ijk;
+    _downAp7ForClass(&diff, r % 2);
+    diff.i = lastIJK.i - diff.i;
+    diff.j = lastIJK.j - diff.j;
+    diff.k = lastIJK.k - diff.k;
+    _normalize(&diff);
+
+    // The unit vector of each digit has the bits of the digit as i, j, k
+    Direction digit = (diff.i | diff.j | diff.k) > 1
+                          ? INVALID_DIGIT
+                          : (Direction)(4 * diff.i + 2 * diff.j + diff.k);
+    H3_SET_INDEX_DIGIT(*h, r, digit);
+}
+
+/**
+ * Replaces the IJK+ coordinates of the parent of a cell with those of the
+ * cell, following its digit of resolution r.
+ * @param h   The index
+ * @param r   The resolution of the digit, from 1 to MAX_H3_RES
+ * @param ijk The IJK+ coordinates at resolution r - 1
+ */
+static inline void _decodeDigit(H3Index h, int r, CoordIJK *ijk) {
+    _downAp7ForClass(ijk, r % 2);
+
+    Direction digit = H3_GET_INDEX_DIGIT(h, r);
+    if (digit > CENTER_DIGIT && digit < NUM_DIGITS) {
+        ijk->i += (digit >> 2) & 1;
+        ijk->j += (digit >> 1) & 1;
+        ijk->k += digit & 1;
+        _normalize(ijk);
+    }
+}
+
+/**
+ * faceIjkToDigits for any resolution, as a loop over the digits.
+ * @param ijk The IJK+ coordinates of the cell, replaced with those of the
+ *            base cell
+ * @param res The resolution of the cell
+ * @param h   The index whose digits are set
+ */
+void _faceIjkToDigitsGeneric(CoordIJK *ijk, int res, H3Index *h) {
+    for (int r = res; r >= 1; r--) {
+        _encodeDigit(ijk, r, h);
+    }
+}
+
+/**
+ * digitsToFaceIjk for any resolution, as a loop over the digits.
+ * @param h   The index whose digits are applied
+ * @param res The resolution of the cell
+ * @param ijk The IJK+ coordinates of the base cell, replaced with those of
+ *            the cell
+ */
+void _digitsToFaceIjkGeneric(H3Index h, int res, CoordIJK *ijk) {
+    for (int r = 1; r <= res; r++) {
+        _decodeDigit(h, r, ijk);
+    }
+}
+
+// Kernels for each resolution
+#define RES 0
+#include "resolutionAlgos.h"
+#undef RES
+#define RES 1
+#include "resolutionAlgos.h"
+#undef RES
+#define RES 2
+#include "resolutionAlgos.h"
+#undef RES
+#define RES 3
+#include "resolutionAlgos.h"
+#undef RES
+#define RES 4
+#include "resolutionAlgos.h"
+#undef RES
+#define RES 5
+#include "resolutionAlgos.h"
+#undef RES
+#define RES 6
+#include "resolutionAlgos.h"
+#undef RES
+#define RES 7
+#include "resolutionAlgos.h"
+#undef RES
+#define RES 8
+#include "resolutionAlgos.h"
+#undef RES
+#define RES 9
+#include "resolutionAlgos.h"
+#undef RES
+#define RES 10
+#include "resolutionAlgos.h"
+#undef RES
+#define RES 11
+#include "resolutionAlgos.h"
+#undef RES
+#define RES 12
+#include "resolutionAlgos.h"
+#undef RES
+#define RES 13
+#include "resolutionAlgos.h"
+#undef RES
+#define RES 14
+#include "resolutionAlgos.h"
+#undef RES
+#define RES 15
+#include "resolutionAlgos.h"
+#undef RES
+
+#define KERNELS_FOR_RES(res) \
+    { _faceIjkToDigitsRes##res, _digitsToFaceIjkRes##res }
+
+/** Kernels for each resolution, by resolution */
+static const ResolutionKernels RESOLUTION_KERNELS[MAX_H3_RES + 1] = {
+    KERNELS_FOR_RES(0),  KERNELS_FOR_RES(1),  KERNELS_FOR_RES(2),
+    KERNELS_FOR_RES(3),  KERNELS_FOR_RES(4),  KERNELS_FOR_RES(5),
+    KERNELS_FOR_RES(6),  KERNELS_FOR_RES(7),  KERNELS_FOR_RES(8),
+    KERNELS_FOR_RES(9),  KERNELS_FOR_RES(10), KERNELS_FOR_RES(11),
+    KERNELS_FOR_RES(12), KERNELS_FOR_RES(13), KERNELS_FOR_RES(14),
+    KERNELS_FOR_RES(15)};
+
+/**
+ * Returns the kernels for a resolution.
+ * @param res The resolution, from 0 to MAX_H3_RES
+ */
+const ResolutionKernels *_resolutionKernels(int res) {
+    return &RESOLUTION_KERNELS[res];
+}
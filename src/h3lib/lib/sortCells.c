@@ -0,0 +1,150 @@
+/*
+ * Copyright 2023 Uber Technologies, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/** @file sortCells.c
+ * @brief   Sorting and deduplication of arrays of H3 indexes
+ *
+ * Indexes are sorted with a least significant digit radix sort on bytes.
+ * The high bytes of a set of indexes (mode, resolution, base cell) and the
+ * low bytes (unused digits) are usually the same for every index, so any
+ * byte that is constant across the array is skipped, and a typical sort
+ * takes four or five passes instead of eight.
+ */
+
+#include <stdbool.h>
+#include <string.h>
+
+#include "alloc.h"
+#include "h3api.h"
+
+/** Number of bytes in an index */
+#define NUM_BYTES 8
+
+/** Number of values of a byte */
+#define NUM_BUCKETS 256
+
+/** Arrays shorter than this are insertion sorted */
+#define MIN_RADIX_SORT_SIZE 64
+
+static void _insertionSort(H3Index *cells, int64_t numCells) {
+    for (int64_t i = 1; i < numCells; i++) {
+        H3Index cell = cells[i];
+        int64_t j = i;
+        while (j > 0 && cells[j - 1] > cell) {
+            cells[j] = cells[j - 1];
+            j--;
+        }
+        cells[j] = cell;
+    }
+}
+
+/**
+ * Sorts an array of indexes in ascending order. H3_NULL entries sort
+ * first. The sort is not limited to valid cells; any H3Index values may be
+ * sorted.
+ *
+ * @param cells The indexes to sort, in place
+ * @param numCells Number of indexes
+ * @return 0 on success, or E_MEMORY_ALLOC if scratch memory could not be
+ * allocated.
+ */
+H3Error H3_EXPORT(sortCells)(H3Index *cells, const int64_t numCells) {
+    if (numCells < MIN_RADIX_SORT_SIZE) {
+        _insertionSort(cells, numCells);
+        return E_SUCCESS;
+    }
+
+    // Count every byte in a single pass
+    int64_t counts[NUM_BYTES][NUM_BUCKETS] = {{0}};
+    for (int64_t i = 0; i < numCells; i++) {
+        H3Index cell = cells[i];
+        for (int b = 0; b < NUM_BYTES; b++) {
+            counts[b][(cell >> (8 * b)) & 0xff]++;
+        }
+    }
+
+    // A byte is constant if all of the indexes fall into one bucket
+    bool needsPass[NUM_BYTES];
+    int numPasses = 0;
+    H3Index first = cells[0];
+    for (int b = 0; b < NUM_BYTES; b++) {
+        needsPass[b] = counts[b][(first >> (8 * b)) & 0xff] != numCells;
+        numPasses += needsPass[b];
+    }
+    if (numPasses == 0) {
+        return E_SUCCESS;
+    }
+
+    H3Index *scratch = H3_MEMORY(malloc)(numCells * sizeof(H3Index));
+    if (!scratch) {
+        return E_MEMORY_ALLOC;
+    }
+
+    H3Index *from = cells;
+    H3Index *to = scratch;
+    for (int b = 0; b < NUM_BYTES; b++) {
+        if (!needsPass[b]) {
+            continue;
+        }
+        int64_t offsets[NUM_BUCKETS];
+        int64_t offset = 0;
+        for (int v = 0; v < NUM_BUCKETS; v++) {
+            offsets[v] = offset;
+            offset += counts[b][v];
+        }
+        int shift = 8 * b;
+        for (int64_t i = 0; i < numCells; i++) {
+            H3Index cell = from[i];
+            to[offsets[(cell >> shift) & 0xff]++] = cell;
+        }
+        H3Index *swap = from;
+        from = to;
+        to = swap;
+    }
+
+    if (from != cells) {
+        memcpy(cells, from, numCells * sizeof(H3Index));
+    }
+    H3_MEMORY(free)(scratch);
+    return E_SUCCESS;
+}
+
+/**
+ * Removes repeated indexes and H3_NULL entries from a sorted array, in
+ * place. The unique indexes are moved to the start of the array, in order.
+ *
+ * @param cells The sorted indexes
+ * @param numCells Number of indexes
+ * @param out The number of unique indexes
+ * @return 0 on success, or E_DOMAIN if the indexes are not sorted, in
+ * which case the array is not modified.
+ */
+H3Error H3_EXPORT(dedupSortedCells)(H3Index *cells, const int64_t numCells,
+                                    int64_t *out) {
+    for (int64_t i = 1; i < numCells; i++) {
+        if (cells[i] < cells[i - 1]) {
+            return E_DOMAIN;
+        }
+    }
+    int64_t numUnique = 0;
+    for (int64_t i = 0; i < numCells; i++) {
+        if (cells[i] != H3_NULL &&
+            (numUnique == 0 || cells[i] != cells[numUnique - 1])) {
+            cells[numUnique++] = cells[i];
+        }
+    }
+    *out = numUnique;
+    return E_SUCCESS;
+}
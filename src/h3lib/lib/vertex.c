@@ -23,6 +23,7 @@
 #include <stdbool.h>
 
 #include "algos.h"
+#include "alloc.h"
 #include "baseCells.h"
 #include "faceijk.h"
 #include "h3Assert.h"
@@ -118,6 +119,27 @@ static const int directionToVertexNumHex[NUM_DIGITS] = {
 static const int directionToVertexNumPent[NUM_DIGITS] = {
     INVALID_DIGIT, INVALID_DIGIT, 1, 2, 4, 3, 0};
 
+/**
+ * Get the first vertex number for a given, valid direction, given the vertex
+ * rotations of the cell.
+ * @param isPent    Whether the cell is a pentagon
+ * @param direction Direction of the neighbor, must be valid for the cell
+ * @param rotations Vertex rotations of the cell, from vertexRotations
+ */
+static int _rotatedVertexNumForDirection(int isPent, Direction direction,
+                                         int rotations) {
+    // Find the appropriate vertex, rotating CCW if necessary
+    if (isPent) {
+        return (directionToVertexNumPent[direction] + NUM_PENT_VERTS -
+                rotations) %
+               NUM_PENT_VERTS;
+    } else {
+        return (directionToVertexNumHex[direction] + NUM_HEX_VERTS -
+                rotations) %
+               NUM_HEX_VERTS;
+    }
+}
+
 /**
  * Get the first vertex number for a given direction. The neighbor in this
  * direction is located between this vertex number and the next number in
@@ -139,16 +161,7 @@ int vertexNumForDirection(const H3Index origin, const Direction direction) {
         return INVALID_VERTEX_NUM;
     }
 
-    // Find the appropriate vertex, rotating CCW if necessary
-    if (isPent) {
-        return (directionToVertexNumPent[direction] + NUM_PENT_VERTS -
-                rotations) %
-               NUM_PENT_VERTS;
-    } else {
-        return (directionToVertexNumHex[direction] + NUM_HEX_VERTS -
-                rotations) %
-               NUM_HEX_VERTS;
-    }
+    return _rotatedVertexNumForDirection(isPent, direction, rotations);
 }
 
 /** @brief Vertex number to hexagon direction relationships (same face).
@@ -162,6 +175,22 @@ static const Direction vertexNumToDirectionHex[NUM_HEX_VERTS] = {
 static const Direction vertexNumToDirectionPent[NUM_PENT_VERTS] = {
     IJ_AXES_DIGIT, J_AXES_DIGIT, JK_AXES_DIGIT, IK_AXES_DIGIT, I_AXES_DIGIT};
 
+/**
+ * Get the direction for a given, valid vertex number, given the vertex
+ * rotations of the cell.
+ * @param isPent    Whether the cell is a pentagon
+ * @param vertexNum Vertex number, must be valid for the cell
+ * @param rotations Vertex rotations of the cell, from vertexRotations
+ */
+static Direction _rotatedDirectionForVertexNum(int isPent, int vertexNum,
+                                               int rotations) {
+    // Find the appropriate direction, rotating CW if necessary
+    return isPent ? vertexNumToDirectionPent[(vertexNum + rotations) %
+                                             NUM_PENT_VERTS]
+                  : vertexNumToDirectionHex[(vertexNum + rotations) %
+                                            NUM_HEX_VERTS];
+}
+
 /**
  * Get the direction for a given vertex number. This returns the direction for
  * the neighbor between the given vertex number and the next number in sequence.
@@ -182,11 +211,7 @@ Direction directionForVertexNum(const H3Index origin, const int vertexNum) {
         return INVALID_DIGIT;
     }
 
-    // Find the appropriate direction, rotating CW if necessary
-    return isPent ? vertexNumToDirectionPent[(vertexNum + rotations) %
-                                             NUM_PENT_VERTS]
-                  : vertexNumToDirectionHex[(vertexNum + rotations) %
-                                            NUM_HEX_VERTS];
+    return _rotatedDirectionForVertexNum(isPent, vertexNum, rotations);
 }
 
 /** @brief Directions in CCW order */
@@ -311,6 +336,397 @@ H3Error H3_EXPORT(cellToVertexes)(H3Index cell, H3Index *vertexes) {
     return E_SUCCESS;
 }
 
+/** Marker for an empty slot in the cellsToVertexes hash tables */
+#define EMPTY_SLOT -1
+
+/**
+ * Hash an H3 index into a power of two sized table. The low bits of cell
+ * indexes are mostly unused digits, so they have to be mixed with the high
+ * bits before masking.
+ */
+static inline int64_t _hashIndex(H3Index h, int64_t mask) {
+    uint64_t x = h ^ (h >> 29);
+    x *= 0xbf58476d1ce4e5b9ULL;
+    x ^= x >> 32;
+    return (int64_t)(x & (uint64_t)mask);
+}
+
+/**
+ * @brief Memoized vertexRotations results, keyed by cell.
+ *
+ * The three cells around a vertex all need the owner's rotations, so the
+ * rotations of a cell in the set are usually needed again by its neighbors.
+ */
+typedef struct {
+    H3Index *cells;   ///< keys, H3_NULL for empty slots
+    int *rotations;   ///< vertexRotations for each key
+    int64_t mask;     ///< table size - 1
+    int64_t count;    ///< number of occupied slots
+} RotationCache;
+
+/**
+ * Get the vertex rotations of a cell, using the cache when possible. Results
+ * are only added while the table is at most half full; past that point they
+ * are simply recomputed.
+ */
+static H3Error _cachedVertexRotations(RotationCache *cache, H3Index cell,
+                                      int *out) {
+    int64_t slot = _hashIndex(cell, cache->mask);
+    while (cache->cells[slot] != H3_NULL) {
+        if (cache->cells[slot] == cell) {
+            *out = cache->rotations[slot];
+            return E_SUCCESS;
+        }
+        slot = (slot + 1) & cache->mask;
+    }
+    H3Error err = vertexRotations(cell, out);
+    if (err) {
+        return err;
+    }
+    if (cache->count * 2 < cache->mask + 1) {
+        cache->cells[slot] = cell;
+        cache->rotations[slot] = *out;
+        cache->count++;
+    }
+    return E_SUCCESS;
+}
+
+/**
+ * Equivalent to vertexNumForDirection, using the rotation cache.
+ */
+static int _cachedVertexNumForDirection(RotationCache *cache,
+                                        const H3Index origin,
+                                        const Direction direction) {
+    int isPent = H3_EXPORT(isPentagon)(origin);
+    if (direction == CENTER_DIGIT || direction >= INVALID_DIGIT ||
+        (isPent && direction == K_AXES_DIGIT))
+        return INVALID_VERTEX_NUM;
+    int rotations;
+    if (_cachedVertexRotations(cache, origin, &rotations)) {
+        return INVALID_VERTEX_NUM;
+    }
+    return _rotatedVertexNumForDirection(isPent, direction, rotations);
+}
+
+/**
+ * Compute all vertexes of a cell with the same results as cellToVertexes,
+ * determining the cell's rotations and each neighbor only once rather than
+ * once or twice per vertex.
+ *
+ * @param cache    Rotation cache shared between the cells of the set
+ * @param cell     Cell to get the vertexes for
+ * @param vertexes Output, length NUM_HEX_VERTS. The last slot is H3_NULL
+ *                 for pentagons.
+ */
+static H3Error _cellToVertexesCached(RotationCache *cache, H3Index cell,
+                                     H3Index *vertexes) {
+    int cellIsPentagon = H3_EXPORT(isPentagon)(cell);
+    int cellNumVerts = cellIsPentagon ? NUM_PENT_VERTS : NUM_HEX_VERTS;
+    int res = H3_GET_RESOLUTION(cell);
+    if (cellIsPentagon) {
+        vertexes[NUM_HEX_VERTS - 1] = H3_NULL;
+    }
+
+    // If the cell is the center child of its parent, it owns all its vertexes
+    if (res != 0 && H3_GET_INDEX_DIGIT(cell, res) == CENTER_DIGIT) {
+        for (int v = 0; v < cellNumVerts; v++) {
+            H3Index vertex = cell;
+            H3_SET_MODE(vertex, H3_VERTEX_MODE);
+            H3_SET_RESERVED_BITS(vertex, v);
+            vertexes[v] = vertex;
+        }
+        return E_SUCCESS;
+    }
+
+    int rotations;
+    if (_cachedVertexRotations(cache, cell, &rotations)) {
+        return E_FAILED;
+    }
+
+    // Neighbors in each direction, computed on first use
+    H3Index neighbors[NUM_DIGITS] = {0};
+    int neighborRotations[NUM_DIGITS] = {0};
+
+    for (int vertexNum = 0; vertexNum < cellNumVerts; vertexNum++) {
+        H3Index owner = cell;
+        int ownerVertexNum = vertexNum;
+
+        Direction left =
+            _rotatedDirectionForVertexNum(cellIsPentagon, vertexNum, rotations);
+        if (neighbors[left] == H3_NULL) {
+            H3Error err = h3NeighborRotations(
+                cell, left, &neighborRotations[left], &neighbors[left]);
+            if (err) return err;
+        }
+        H3Index leftNeighbor = neighbors[left];
+        int lRotations = neighborRotations[left];
+        if (leftNeighbor < owner) owner = leftNeighbor;
+
+        if (res == 0 || H3_GET_INDEX_DIGIT(leftNeighbor, res) != CENTER_DIGIT) {
+            Direction right = _rotatedDirectionForVertexNum(
+                cellIsPentagon, (vertexNum - 1 + cellNumVerts) % cellNumVerts,
+                rotations);
+            if (neighbors[right] == H3_NULL) {
+                H3Error err = h3NeighborRotations(
+                    cell, right, &neighborRotations[right], &neighbors[right]);
+                if (err) return err;
+            }
+            H3Index rightNeighbor = neighbors[right];
+            int rRotations = neighborRotations[right];
+            if (rightNeighbor < owner) {
+                owner = rightNeighbor;
+                Direction dir =
+                    H3_EXPORT(isPentagon)(owner)
+                        ? directionForNeighbor(owner, cell)
+                        : DIRECTIONS[(revNeighborDirectionsHex[right] +
+                                      rRotations) %
+                                     NUM_HEX_VERTS];
+                ownerVertexNum = _cachedVertexNumForDirection(cache, owner, dir);
+            }
+        }
+
+        if (owner == leftNeighbor) {
+            int ownerIsPentagon = H3_EXPORT(isPentagon)(owner);
+            Direction dir =
+                ownerIsPentagon
+                    ? directionForNeighbor(owner, cell)
+                    : DIRECTIONS[(revNeighborDirectionsHex[left] + lRotations) %
+                                 NUM_HEX_VERTS];
+            ownerVertexNum = _cachedVertexNumForDirection(cache, owner, dir) + 1;
+            if (ownerVertexNum == NUM_HEX_VERTS ||
+                (ownerIsPentagon && ownerVertexNum == NUM_PENT_VERTS)) {
+                ownerVertexNum = 0;
+            }
+        }
+
+        H3Index vertex = owner;
+        H3_SET_MODE(vertex, H3_VERTEX_MODE);
+        H3_SET_RESERVED_BITS(vertex, ownerVertexNum);
+        vertexes[vertexNum] = vertex;
+    }
+    return E_SUCCESS;
+}
+
+/**
+ * Return the smallest power of two table size of at least 2 * n slots.
+ */
+static int64_t _tableSizeFor(int64_t n) {
+    int64_t size = 16;
+    while (size < n * 2) {
+        size *= 2;
+    }
+    return size;
+}
+
+/**
+ * Maximum number of unique vertexes produced by cellsToVertexes, which is the
+ * size of the `vertexes` output buffer to allocate.
+ *
+ * @param numCells Number of cells in the set
+ * @param out      Maximum number of vertexes
+ */
+H3Error H3_EXPORT(maxCellsToVertexesSize)(const int64_t numCells,
+                                          int64_t *out) {
+    if (numCells < 0 || numCells > INT64_MAX / NUM_HEX_VERTS) {
+        return E_DOMAIN;
+    }
+    *out = numCells * NUM_HEX_VERTS;
+    return E_SUCCESS;
+}
+
+/**
+ * Get the unique vertexes of a set of cells, plus a table of the position of
+ * each cell's vertexes in the unique vertex list.
+ *
+ * Vertexes are listed in the order they are first encountered. Each vertex
+ * is computed as by cellToVertex, but the work of determining a vertex's
+ * owner is shared between the cells of the set.
+ *
+ * @param cells         Set of cells. H3_NULL entries are skipped.
+ * @param numCells      Number of entries in `cells`
+ * @param vertexes      Output unique vertexes, at least
+ *                      maxCellsToVertexesSize entries
+ * @param numVertexes   Output number of unique vertexes written
+ * @param cellVertexes  Output table of `numCells * 6` positions into
+ *                      `vertexes`; entry `6 * i + v` is vertex `v` of cell
+ *                      `i`. Unused slots (the sixth vertex of a pentagon,
+ *                      or H3_NULL cells) are -1.
+ */
+H3Error H3_EXPORT(cellsToVertexes)(const H3Index *cells, const int64_t numCells,
+                                   H3Index *vertexes, int64_t *numVertexes,
+                                   int64_t *cellVertexes) {
+    int64_t maxVertexes;
+    H3Error sizeErr =
+        H3_EXPORT(maxCellsToVertexesSize)(numCells, &maxVertexes);
+    if (sizeErr) {
+        return sizeErr;
+    }
+
+    RotationCache cache = {0};
+    int64_t cacheSize = _tableSizeFor(numCells);
+    cache.mask = cacheSize - 1;
+    cache.cells = H3_MEMORY(calloc)(cacheSize, sizeof(H3Index));
+    if (!cache.cells) {
+        return E_MEMORY_ALLOC;
+    }
+    cache.rotations = H3_MEMORY(malloc)(cacheSize * sizeof(int));
+    if (!cache.rotations) {
+        H3_MEMORY(free)(cache.cells);
+        return E_MEMORY_ALLOC;
+    }
+
+    // Deduplication table, storing positions in the `vertexes` output.
+    // Interior vertexes are shared by three cells, so start at the expected
+    // number of unique vertexes and grow as needed.
+    int64_t seenSize = _tableSizeFor(numCells * 2);
+    int64_t seenMask = seenSize - 1;
+    int64_t *seen = H3_MEMORY(malloc)(seenSize * sizeof(int64_t));
+    if (!seen) {
+        H3_MEMORY(free)(cache.cells);
+        H3_MEMORY(free)(cache.rotations);
+        return E_MEMORY_ALLOC;
+    }
+    for (int64_t i = 0; i < seenSize; i++) seen[i] = EMPTY_SLOT;
+
+    H3Error err = E_SUCCESS;
+    int64_t count = 0;
+    for (int64_t i = 0; i < numCells; i++) {
+        int64_t *cellOut = &cellVertexes[i * NUM_HEX_VERTS];
+        for (int v = 0; v < NUM_HEX_VERTS; v++) cellOut[v] = EMPTY_SLOT;
+        if (cells[i] == H3_NULL) {
+            continue;
+        }
+
+        H3Index cellVerts[NUM_HEX_VERTS];
+        err = _cellToVertexesCached(&cache, cells[i], cellVerts);
+        if (err) {
+            break;
+        }
+
+        for (int v = 0; v < NUM_HEX_VERTS; v++) {
+            H3Index vertex = cellVerts[v];
+            if (vertex == H3_NULL) {
+                continue;
+            }
+            int64_t slot = _hashIndex(vertex, seenMask);
+            while (seen[slot] != EMPTY_SLOT &&
+                   vertexes[seen[slot]] != vertex) {
+                slot = (slot + 1) & seenMask;
+            }
+            if (seen[slot] == EMPTY_SLOT) {
+                // Keep the table at most half full
+                if ((count + 1) * 2 > seenSize) {
+                    int64_t newSize = seenSize * 2;
+                    int64_t *newSeen =
+                        H3_MEMORY(malloc)(newSize * sizeof(int64_t));
+                    if (!newSeen) {
+                        err = E_MEMORY_ALLOC;
+                        break;
+                    }
+                    H3_MEMORY(free)(seen);
+                    seen = newSeen;
+                    seenSize = newSize;
+                    seenMask = newSize - 1;
+                    for (int64_t j = 0; j < seenSize; j++) seen[j] = EMPTY_SLOT;
+                    for (int64_t j = 0; j < count; j++) {
+                        int64_t s = _hashIndex(vertexes[j], seenMask);
+                        while (seen[s] != EMPTY_SLOT) s = (s + 1) & seenMask;
+                        seen[s] = j;
+                    }
+                    slot = _hashIndex(vertex, seenMask);
+                    while (seen[slot] != EMPTY_SLOT) {
+                        slot = (slot + 1) & seenMask;
+                    }
+                }
+                vertexes[count] = vertex;
+                seen[slot] = count;
+                count++;
+            }
+            cellOut[v] = seen[slot];
+        }
+        if (err) {
+            break;
+        }
+    }
+
+    H3_MEMORY(free)(seen);
+    H3_MEMORY(free)(cache.cells);
+    H3_MEMORY(free)(cache.rotations);
+    if (err) {
+        return err;
+    }
+    *numVertexes = count;
+    return E_SUCCESS;
+}
+
+/** Number of owner cells whose FaceIJK cellsToVertexMesh keeps around */
+#define MESH_OWNER_CACHE_SIZE 64
+
+/**
+ * Convert a set of cells to an indexed mesh: the coordinates of each unique
+ * vertex of the set, plus a per-cell table of positions into the vertex
+ * list, suitable for use as vertex and index buffers.
+ *
+ * Each shared vertex is computed once, so the coordinates of a vertex are
+ * identical for every cell using it. Only the topological vertexes of the
+ * cells are included; the additional distortion vertexes that
+ * cellToBoundary emits for Class III cells crossing an icosahedron edge are
+ * not.
+ *
+ * @param cells         Set of cells. H3_NULL entries are skipped.
+ * @param numCells      Number of entries in `cells`
+ * @param vertexes      Output unique vertexes, at least
+ *                      maxCellsToVertexesSize entries
+ * @param coords        Output coordinates of each entry in `vertexes`, at
+ *                      least maxCellsToVertexesSize entries
+ * @param numVertexes   Output number of unique vertexes written
+ * @param cellVertexes  Output table of `numCells * 6` positions, as in
+ *                      cellsToVertexes. Vertexes of each cell are in
+ *                      counter-clockwise order.
+ */
+H3Error H3_EXPORT(cellsToVertexMesh)(const H3Index *cells,
+                                     const int64_t numCells, H3Index *vertexes,
+                                     LatLng *coords, int64_t *numVertexes,
+                                     int64_t *cellVertexes) {
+    int64_t count;
+    H3Error err = H3_EXPORT(cellsToVertexes)(cells, numCells, vertexes, &count,
+                                             cellVertexes);
+    if (err) {
+        return err;
+    }
+    // Each owner cell owns about two of the set's vertexes, so keep the most
+    // recent owners' FaceIJK addresses rather than decoding them per vertex.
+    H3Index ownerCache[MESH_OWNER_CACHE_SIZE] = {0};
+    FaceIJK fijkCache[MESH_OWNER_CACHE_SIZE];
+    for (int64_t i = 0; i < count; i++) {
+        int vertexNum = H3_GET_RESERVED_BITS(vertexes[i]);
+        H3Index owner = vertexes[i];
+        H3_SET_MODE(owner, H3_CELL_MODE);
+        H3_SET_RESERVED_BITS(owner, 0);
+
+        int slot = (int)_hashIndex(owner, MESH_OWNER_CACHE_SIZE - 1);
+        if (ownerCache[slot] != owner) {
+            err = _h3ToFaceIjk(owner, &fijkCache[slot]);
+            if (NEVER(err)) {
+                return err;
+            }
+            ownerCache[slot] = owner;
+        }
+
+        CellBoundary gb;
+        int res = H3_GET_RESOLUTION(owner);
+        if (H3_EXPORT(isPentagon)(owner)) {
+            _faceIjkPentToCellBoundary(&fijkCache[slot], res, vertexNum, 1,
+                                       &gb);
+        } else {
+            _faceIjkToCellBoundary(&fijkCache[slot], res, vertexNum, 1, &gb);
+        }
+        coords[i] = gb.verts[0];
+    }
+    *numVertexes = count;
+    return E_SUCCESS;
+}
+
 /**
  * Get the geocoordinates of an H3 vertex
  * @param vertex H3 index describing a vertex